@@ -343,6 +343,7 @@ public:
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static StringName get_property_setter(StringName p_class, const StringName &p_property);
+	static MethodBind *get_property_setter_bind(const StringName &p_class, const StringName &p_property, int *r_index = nullptr);
 	static StringName get_property_getter(StringName p_class, const StringName &p_property);
 
 	static bool has_method(StringName p_class, StringName p_method, bool p_no_inheritance = false);
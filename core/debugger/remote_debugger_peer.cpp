@@ -108,10 +108,10 @@ void RemoteDebuggerPeerTCP::_write_out() {
 			out_queue.pop_front();
 			mutex.unlock();
 			int size = 0;
-			Error err = encode_variant(var, nullptr, size);
+			Error err = encode_variant(var, encode_buf, size);
 			ERR_CONTINUE(err != OK || size > out_buf.size() - 4); // 4 bytes separator.
 			encode_uint32(size, buf);
-			encode_variant(var, buf + 4, size);
+			copymem(buf + 4, encode_buf.ptr(), size);
 			out_left = size + 4;
 			out_pos = 0;
 		}
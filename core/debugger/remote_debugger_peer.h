@@ -64,6 +64,7 @@ private:
 	int out_left = 0;
 	int out_pos = 0;
 	Vector<uint8_t> out_buf;
+	Vector<uint8_t> encode_buf;
 	int in_left = 0;
 	int in_pos = 0;
 	Vector<uint8_t> in_buf;
@@ -43,7 +43,80 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	}
 
 	cmode = p_mode;
-	block_size = p_block_size;
+	block_size = p_block_size > 0 ? p_block_size : default_block_size;
+}
+
+ThreadWorkPool FileAccessCompressed::work_pool;
+BinaryMutex FileAccessCompressed::work_pool_mutex;
+bool FileAccessCompressed::work_pool_initialized = false;
+int FileAccessCompressed::default_block_size = 65536;
+
+void FileAccessCompressed::_compress_block(uint32_t p_index, BlockWork *p_work) const {
+	BlockWork &w = p_work[p_index];
+	w.result = Compression::compress(w.dst, w.src, w.src_size, cmode);
+}
+
+void FileAccessCompressed::_decompress_block(uint32_t p_index, BlockWork *p_work) const {
+	BlockWork &w = p_work[p_index];
+	w.result = Compression::decompress(w.dst, w.dst_size, w.src, w.src_size, cmode);
+}
+
+void FileAccessCompressed::_process_blocks(BlockWork *p_work, int p_count, bool p_compress) const {
+	//blocks are independent, so they are spread over the pool unless another file is using it
+	if (p_count > 1 && work_pool_mutex.try_lock() == OK) {
+		if (!work_pool_initialized) {
+			work_pool.init();
+			work_pool_initialized = true;
+		}
+		work_pool.do_work(p_count, this, p_compress ? &FileAccessCompressed::_compress_block : &FileAccessCompressed::_decompress_block, p_work);
+		work_pool_mutex.unlock();
+		return;
+	}
+
+	for (int i = 0; i < p_count; i++) {
+		if (p_compress) {
+			_compress_block(i, p_work);
+		} else {
+			_decompress_block(i, p_work);
+		}
+	}
+}
+
+void FileAccessCompressed::_load_block(int p_block, bool p_read_ahead) const {
+	if (p_block < cache_block || p_block >= cache_block + cache_count) {
+		int count = p_read_ahead ? MIN(read_ahead, read_block_count - p_block) : 1;
+
+		int csize = 0;
+		for (int i = 0; i < count; i++) {
+			csize += read_blocks[p_block + i].csize;
+		}
+		if (comp_buffer.size() < csize) {
+			comp_buffer.resize(csize);
+		}
+
+		//blocks are stored one after the other, so the whole range is a single read
+		f->seek(read_blocks[p_block].offset);
+		f->get_buffer(comp_buffer.ptrw(), csize);
+
+		BlockWork work[READ_AHEAD_BLOCKS];
+		int ofs = 0;
+		for (int i = 0; i < count; i++) {
+			work[i].src = comp_buffer.ptr() + ofs;
+			work[i].src_size = read_blocks[p_block + i].csize;
+			work[i].dst = buffer.ptrw() + i * block_size;
+			work[i].dst_size = block_size;
+			ofs += work[i].src_size;
+		}
+
+		_process_blocks(work, count, false);
+
+		cache_block = p_block;
+		cache_count = count;
+	}
+
+	read_ptr = buffer.ptrw() + (p_block - cache_block) * block_size;
+	read_block = p_block;
+	read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
 }
 
 #define WRITE_FIT(m_bytes)                                  \
@@ -80,16 +153,15 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	}
 
 	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
+	read_ahead = MIN(int(READ_AHEAD_BLOCKS), bc);
+	buffer.resize(block_size * read_ahead);
+	cache_block = 0;
+	cache_count = 0;
 
-	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+	_load_block(0, true);
 	read_pos = 0;
 
 	return OK;
@@ -155,16 +227,28 @@ void FileAccessCompressed::close() {
 		}
 
 		Vector<int> block_sizes;
-		for (int i = 0; i < bc; i++) {
-			int bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
+		int max_csize = Compression::get_max_compressed_buffer_size(block_size, cmode);
+		Vector<uint8_t> cblocks;
+		cblocks.resize(max_csize * MIN(bc, int(WRITE_BATCH_BLOCKS)));
+		BlockWork work[WRITE_BATCH_BLOCKS];
+
+		for (int from = 0; from < bc; from += WRITE_BATCH_BLOCKS) {
+			int count = MIN(bc - from, int(WRITE_BATCH_BLOCKS));
+
+			for (int i = 0; i < count; i++) {
+				int b = from + i;
+				work[i].src = &write_ptr[b * block_size];
+				work[i].src_size = b == (bc - 1) ? write_max % block_size : block_size;
+				work[i].dst = cblocks.ptrw() + i * max_csize;
+				work[i].dst_size = max_csize;
+			}
 
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
+			_process_blocks(work, count, true);
 
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
+			for (int i = 0; i < count; i++) {
+				f->store_buffer(work[i].dst, work[i].result);
+				block_sizes.push_back(work[i].result);
+			}
 		}
 
 		f->seek(16); //ok write block sizes
@@ -180,6 +264,7 @@ void FileAccessCompressed::close() {
 		comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
+		cache_count = 0;
 	}
 
 	memdelete(f);
@@ -206,11 +291,7 @@ void FileAccessCompressed::seek(size_t p_position) {
 			read_eof = false;
 			int block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				_load_block(block_idx, false); //random access, don't read ahead
 			}
 
 			read_pos = p_position % block_size;
@@ -271,9 +352,7 @@ uint8_t FileAccessCompressed::get_8() const {
 
 		if (read_block < read_block_count) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			_load_block(read_block, true);
 			read_pos = 0;
 
 		} else {
@@ -294,26 +373,28 @@ int FileAccessCompressed::get_buffer(uint8_t *p_dst, int p_length) const {
 		return 0;
 	}
 
-	for (int i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
+	int copied = 0;
+	while (copied < p_length) {
+		int n = MIN(p_length - copied, read_block_size - read_pos);
+		copymem(&p_dst[copied], &read_ptr[read_pos], n);
+		copied += n;
+		read_pos += n;
+
 		if (read_pos >= read_block_size) {
 			read_block++;
 
 			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				//read more blocks of compressed data
+				_load_block(read_block, true);
 				read_pos = 0;
 
 			} else {
 				read_block--;
 				at_end = true;
-				if (i < p_length - 1) {
+				if (copied < p_length) {
 					read_eof = true;
 				}
-				return i;
+				return copied;
 			}
 		}
 	}
@@ -371,6 +452,14 @@ Error FileAccessCompressed::_set_unix_permissions(const String &p_file, uint32_t
 	return FAILED;
 }
 
+void FileAccessCompressed::finalize() {
+	MutexLock lock(work_pool_mutex);
+	if (work_pool_initialized) {
+		work_pool.finish();
+		work_pool_initialized = false;
+	}
+}
+
 FileAccessCompressed::~FileAccessCompressed() {
 	if (f) {
 		close();
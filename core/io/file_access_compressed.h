@@ -33,8 +33,15 @@
 
 #include "core/io/compression.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/thread_work_pool.h"
 
 class FileAccessCompressed : public FileAccess {
+	enum {
+		READ_AHEAD_BLOCKS = 8, //decompressed at once when reading sequentially
+		WRITE_BATCH_BLOCKS = 64, //compressed at once when saving
+	};
+
 	Compression::Mode cmode = Compression::MODE_ZSTD;
 	bool writing = false;
 	uint32_t write_pos = 0;
@@ -51,20 +58,42 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable uint8_t *read_ptr = nullptr;
 	mutable int read_block = 0;
 	int read_block_count = 0;
 	mutable int read_block_size = 0;
 	mutable int read_pos = 0;
 	Vector<ReadBlock> read_blocks;
 	uint32_t read_total = 0;
+	int read_ahead = 1;
+	mutable int cache_block = 0; //first block decompressed in buffer
+	mutable int cache_count = 0;
 
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	FileAccess *f = nullptr;
 
+	struct BlockWork {
+		const uint8_t *src;
+		int src_size;
+		uint8_t *dst;
+		int dst_size;
+		int result;
+	};
+
+	void _compress_block(uint32_t p_index, BlockWork *p_work) const;
+	void _decompress_block(uint32_t p_index, BlockWork *p_work) const;
+	void _process_blocks(BlockWork *p_work, int p_count, bool p_compress) const;
+	void _load_block(int p_block, bool p_read_ahead) const;
+
+	static ThreadWorkPool work_pool;
+	static BinaryMutex work_pool_mutex;
+	static bool work_pool_initialized;
+
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
+	static int default_block_size;
+
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 0); ///< zero block size uses default_block_size
 
 	Error open_after_magic(FileAccess *p_base);
 
@@ -93,6 +122,8 @@ public:
 	virtual uint32_t _get_unix_permissions(const String &p_file);
 	virtual Error _set_unix_permissions(const String &p_file, uint32_t p_permissions);
 
+	static void finalize();
+
 	FileAccessCompressed() {}
 	virtual ~FileAccessCompressed();
 };
@@ -194,15 +194,39 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files)
 		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this, p_replace_files);
 	};
 
+	if (!mapped_packs.has(p_path)) {
+		MappedPack mp;
+		mp.data = f->map_read_only(mp.size);
+		if (mp.data) {
+			// Keep it open, the mapping lives as long as the file.
+			mp.f = f;
+			mapped_packs[p_path] = mp;
+			return true;
+		}
+	}
+
 	f->close();
 	memdelete(f);
 	return true;
 };
 
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	Map<String, MappedPack>::Element *E = mapped_packs.find(p_file->pack);
+	if (E && p_file->offset + p_file->size <= E->get().size) {
+		E->get().f->advise_will_need(p_file->offset, p_file->size);
+		return memnew(FileAccessPack(p_path, *p_file, E->get().data));
+	}
+
 	return memnew(FileAccessPack(p_path, *p_file));
 };
 
+PackedSourcePCK::~PackedSourcePCK() {
+	for (Map<String, MappedPack>::Element *E = mapped_packs.front(); E; E = E->next()) {
+		E->get().f->close();
+		memdelete(E->get().f);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
@@ -211,11 +235,17 @@ Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 }
 
 void FileAccessPack::close() {
-	f->close();
+	if (f) {
+		f->close();
+	}
+	data = nullptr;
 }
 
 bool FileAccessPack::is_open() const {
-	return f->is_open();
+	if (f) {
+		return f->is_open();
+	}
+	return data != nullptr;
 }
 
 void FileAccessPack::seek(size_t p_position) {
@@ -225,7 +255,9 @@ void FileAccessPack::seek(size_t p_position) {
 		eof = false;
 	}
 
-	f->seek(pf.offset + p_position);
+	if (f) {
+		f->seek(pf.offset + p_position);
+	}
 	pos = p_position;
 }
 
@@ -251,6 +283,10 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
@@ -266,19 +302,27 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 		to_read = int64_t(pf.size) - int64_t(pos);
 	}
 
+	size_t read_pos = pos;
 	pos += p_length;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (data) {
+		memcpy(p_dst, data + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f) {
+		f->set_endian_swap(p_swap);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -304,14 +348,20 @@ bool FileAccessPack::file_exists(const String &p_name) {
 	return false;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_pack_data) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	if (p_pack_data) {
+		data = p_pack_data + pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(!f, "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	pos = 0;
-	eof = false;
 }
 
 FileAccessPack::~FileAccessPack() {
@@ -31,6 +31,7 @@
 #ifndef FILE_ACCESS_PACK_H
 #define FILE_ACCESS_PACK_H
 
+#include "core/hash_map.h"
 #include "core/list.h"
 #include "core/map.h"
 #include "core/os/dir_access.h"
@@ -87,9 +88,13 @@ private:
 			a = *((uint64_t *)&p_buf[0]);
 			b = *((uint64_t *)&p_buf[8]);
 		}
+
+		static _FORCE_INLINE_ uint32_t hash(const PathMD5 &p_md5) {
+			return uint32_t(p_md5.a); // Already a good hash.
+		}
 	};
 
-	Map<PathMD5, PackedFile> files;
+	HashMap<PathMD5, PackedFile, PathMD5> files;
 
 	Vector<PackSource *> sources;
 
@@ -125,9 +130,21 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Packs stay open and mapped in memory when the platform supports it,
+	// so opening a packed file needs no syscall and reads are plain copies.
+	struct MappedPack {
+		FileAccess *f = nullptr;
+		const uint8_t *data = nullptr;
+		size_t size = 0;
+	};
+
+	Map<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files);
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
+
+	~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -136,7 +153,8 @@ class FileAccessPack : public FileAccess {
 	mutable size_t pos;
 	mutable bool eof;
 
-	FileAccess *f;
+	FileAccess *f = nullptr;
+	const uint8_t *data = nullptr; // Start of the file in the mapped pack, reads don't go through f then.
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) { return 0; }
@@ -168,21 +186,21 @@ public:
 
 	virtual bool file_exists(const String &p_name);
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_pack_data = nullptr);
 	~FileAccessPack();
 };
 
 FileAccess *PackedData::try_open_path(const String &p_path) {
 	PathMD5 pmd5(p_path.md5_buffer());
-	Map<PathMD5, PackedFile>::Element *E = files.find(pmd5);
-	if (!E) {
+	PackedFile *pf = files.getptr(pmd5);
+	if (!pf) {
 		return nullptr; //not found
 	}
-	if (E->get().offset == 0) {
+	if (pf->offset == 0) {
 		return nullptr; //was erased
 	}
 
-	return E->get().src->get_file(p_path, &E->get());
+	return pf->src->get_file(p_path, pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
@@ -45,56 +45,147 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-static String _make_indent(const String &p_indent, int p_size) {
-	String indent_text = "";
-	if (!p_indent.empty()) {
-		for (int i = 0; i < p_size; i++) {
-			indent_text += p_indent;
-		}
+static _FORCE_INLINE_ void _write_ascii(LocalVector<uint8_t> &r_buffer, const char *p_str) {
+	while (*p_str) {
+		r_buffer.push_back(uint8_t(*p_str));
+		p_str++;
+	}
+}
+
+static _FORCE_INLINE_ void _write_ascii(LocalVector<uint8_t> &r_buffer, const String &p_str) {
+	const CharType *src = p_str.ptr();
+	for (int i = 0; i < p_str.length(); i++) {
+		r_buffer.push_back(uint8_t(src[i]));
+	}
+}
+
+static _FORCE_INLINE_ void _write_indent(LocalVector<uint8_t> &r_buffer, const CharString &p_indent, int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		_write_ascii(r_buffer, p_indent.get_data());
 	}
-	return indent_text;
 }
 
-String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys) {
-	String colon = ":";
-	String end_statement = "";
+static void _write_char(LocalVector<uint8_t> &r_buffer, uint32_t c) {
+	if (c <= 0x7f) {
+		r_buffer.push_back(c);
+	} else if (c <= 0x7ff) {
+		r_buffer.push_back(uint8_t(0xc0 | ((c >> 6) & 0x1f)));
+		r_buffer.push_back(uint8_t(0x80 | (c & 0x3f)));
+	} else if (c <= 0xffff) {
+		r_buffer.push_back(uint8_t(0xe0 | ((c >> 12) & 0x0f)));
+		r_buffer.push_back(uint8_t(0x80 | ((c >> 6) & 0x3f)));
+		r_buffer.push_back(uint8_t(0x80 | (c & 0x3f)));
+	} else {
+		r_buffer.push_back(uint8_t(0xf0 | ((c >> 18) & 0x07)));
+		r_buffer.push_back(uint8_t(0x80 | ((c >> 12) & 0x3f)));
+		r_buffer.push_back(uint8_t(0x80 | ((c >> 6) & 0x3f)));
+		r_buffer.push_back(uint8_t(0x80 | (c & 0x3f)));
+	}
+}
+
+// Same escaping as String::json_escape(), without the intermediate strings.
+static void _write_string(LocalVector<uint8_t> &r_buffer, const String &p_str) {
+	r_buffer.push_back('"');
+	const CharType *src = p_str.ptr();
+	for (int i = 0; i < p_str.length(); i++) {
+		CharType c = src[i];
+		switch (c) {
+			case '\\':
+				_write_ascii(r_buffer, "\\\\");
+				break;
+			case '\b':
+				_write_ascii(r_buffer, "\\b");
+				break;
+			case '\f':
+				_write_ascii(r_buffer, "\\f");
+				break;
+			case '\n':
+				_write_ascii(r_buffer, "\\n");
+				break;
+			case '\r':
+				_write_ascii(r_buffer, "\\r");
+				break;
+			case '\t':
+				_write_ascii(r_buffer, "\\t");
+				break;
+			case '\v':
+				_write_ascii(r_buffer, "\\v");
+				break;
+			case '"':
+				_write_ascii(r_buffer, "\\\"");
+				break;
+			default:
+				_write_char(r_buffer, c);
+		}
+	}
+	r_buffer.push_back('"');
+}
 
-	if (!p_indent.empty()) {
-		colon += " ";
-		end_statement += "\n";
+static void _write_int(LocalVector<uint8_t> &r_buffer, int64_t p_value) {
+	char digits[24];
+	int count = 0;
+	uint64_t v = p_value < 0 ? uint64_t(0) - uint64_t(p_value) : uint64_t(p_value);
+	do {
+		digits[count++] = '0' + (v % 10);
+		v /= 10;
+	} while (v);
+
+	if (p_value < 0) {
+		r_buffer.push_back('-');
+	}
+	while (count) {
+		r_buffer.push_back(digits[--count]);
 	}
+}
+
+void JSON::_write_var(LocalVector<uint8_t> &r_buffer, const Variant &p_var, const CharString &p_indent, int p_cur_indent, bool p_sort_keys) {
+	bool pretty = p_indent.length() > 0;
 
 	switch (p_var.get_type()) {
-		case Variant::NIL:
-			return "null";
-		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
-		case Variant::INT:
-			return itos(p_var);
-		case Variant::FLOAT:
-			return rtos(p_var);
+		case Variant::NIL: {
+			_write_ascii(r_buffer, "null");
+		} break;
+		case Variant::BOOL: {
+			_write_ascii(r_buffer, p_var.operator bool() ? "true" : "false");
+		} break;
+		case Variant::INT: {
+			_write_int(r_buffer, p_var);
+		} break;
+		case Variant::FLOAT: {
+			_write_ascii(r_buffer, rtos(p_var));
+		} break;
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
 		case Variant::PACKED_FLOAT32_ARRAY:
 		case Variant::PACKED_FLOAT64_ARRAY:
 		case Variant::PACKED_STRING_ARRAY:
 		case Variant::ARRAY: {
-			String s = "[";
-			s += end_statement;
+			r_buffer.push_back('[');
+			if (pretty) {
+				r_buffer.push_back('\n');
+			}
 			Array a = p_var;
 			for (int i = 0; i < a.size(); i++) {
 				if (i > 0) {
-					s += ",";
-					s += end_statement;
+					r_buffer.push_back(',');
+					if (pretty) {
+						r_buffer.push_back('\n');
+					}
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(a[i], p_indent, p_cur_indent + 1, p_sort_keys);
+				_write_indent(r_buffer, p_indent, p_cur_indent + 1);
+				_write_var(r_buffer, a[i], p_indent, p_cur_indent + 1, p_sort_keys);
+			}
+			if (pretty) {
+				r_buffer.push_back('\n');
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
-			return s;
-		};
+			_write_indent(r_buffer, p_indent, p_cur_indent);
+			r_buffer.push_back(']');
+		} break;
 		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
+			r_buffer.push_back('{');
+			if (pretty) {
+				r_buffer.push_back('\n');
+			}
 			Dictionary d = p_var;
 			List<Variant> keys;
 			d.get_key_list(&keys);
@@ -105,31 +196,50 @@ String JSON::_print_var(const Variant &p_var, const String &p_indent, int p_cur_
 
 			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
 				if (E != keys.front()) {
-					s += ",";
-					s += end_statement;
+					r_buffer.push_back(',');
+					if (pretty) {
+						r_buffer.push_back('\n');
+					}
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _print_var(String(E->get()), p_indent, p_cur_indent + 1, p_sort_keys);
-				s += colon;
-				s += _print_var(d[E->get()], p_indent, p_cur_indent + 1, p_sort_keys);
+				_write_indent(r_buffer, p_indent, p_cur_indent + 1);
+				_write_string(r_buffer, E->get());
+				r_buffer.push_back(':');
+				if (pretty) {
+					r_buffer.push_back(' ');
+				}
+				_write_var(r_buffer, d[E->get()], p_indent, p_cur_indent + 1, p_sort_keys);
 			}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
-			return s;
-		};
-		default:
-			return "\"" + String(p_var).json_escape() + "\"";
+			if (pretty) {
+				r_buffer.push_back('\n');
+			}
+			_write_indent(r_buffer, p_indent, p_cur_indent);
+			r_buffer.push_back('}');
+		} break;
+		default: {
+			_write_string(r_buffer, p_var);
+		}
 	}
 }
 
+void JSON::print_to_buffer(const Variant &p_var, LocalVector<uint8_t> &r_buffer, const String &p_indent, bool p_sort_keys) {
+	_write_var(r_buffer, p_var, p_indent.utf8(), 0, p_sort_keys);
+}
+
 String JSON::print(const Variant &p_var, const String &p_indent, bool p_sort_keys) {
-	return _print_var(p_var, p_indent, 0, p_sort_keys);
+	LocalVector<uint8_t> buffer;
+	print_to_buffer(p_var, buffer, p_indent, p_sort_keys);
+	return String::utf8((const char *)buffer.ptr(), buffer.size());
 }
 
-Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
-	while (p_len > 0) {
+Error JSON::_get_token(ParseState &p_state, Token &r_token) {
+	const CharType *p_str = p_state.str;
+	int &index = p_state.index;
+
+	while (index < p_state.len) {
 		switch (p_str[index]) {
 			case '\n': {
-				line++;
+				p_state.line++;
 				index++;
 				break;
 			};
@@ -169,20 +279,29 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 			};
 			case '"': {
 				index++;
-				String str;
+				// Strings without escapes are returned as a view into the source text,
+				// the rest are unescaped into the scratch buffer.
+				int from = index;
+				bool escaped = false;
 				while (true) {
 					if (p_str[index] == 0) {
-						r_err_str = "Unterminated String";
+						p_state.err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
 					} else if (p_str[index] == '"') {
-						index++;
 						break;
 					} else if (p_str[index] == '\\') {
+						if (!escaped) {
+							escaped = true;
+							p_state.scratch.resize(index - from);
+							if (index > from) {
+								memcpy(p_state.scratch.ptr(), &p_str[from], (index - from) * sizeof(CharType));
+							}
+						}
 						//escaped characters...
 						index++;
 						CharType next = p_str[index];
 						if (next == 0) {
-							r_err_str = "Unterminated String";
+							p_state.err_str = "Unterminated String";
 							return ERR_PARSE_ERROR;
 						}
 						CharType res = 0;
@@ -208,11 +327,11 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 								for (int j = 0; j < 4; j++) {
 									CharType c = p_str[index + j + 1];
 									if (c == 0) {
-										r_err_str = "Unterminated String";
+										p_state.err_str = "Unterminated String";
 										return ERR_PARSE_ERROR;
 									}
 									if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))) {
-										r_err_str = "Malformed hex constant in string";
+										p_state.err_str = "Malformed hex constant in string";
 										return ERR_PARSE_ERROR;
 									}
 									CharType v;
@@ -240,19 +359,29 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 							} break;
 						}
 
-						str += res;
+						p_state.scratch.push_back(res);
 
 					} else {
 						if (p_str[index] == '\n') {
-							line++;
+							p_state.line++;
+						}
+						if (escaped) {
+							p_state.scratch.push_back(p_str[index]);
 						}
-						str += p_str[index];
 					}
 					index++;
 				}
 
+				if (escaped) {
+					r_token.str = p_state.scratch.ptr();
+					r_token.str_len = p_state.scratch.size();
+				} else {
+					r_token.str = &p_str[from];
+					r_token.str_len = index - from;
+				}
+				index++;
+
 				r_token.type = TK_STRING;
-				r_token.value = str;
 				return OK;
 
 			} break;
@@ -268,92 +397,96 @@ Error JSON::_get_token(const CharType *p_str, int &index, int p_len, Token &r_to
 					double number = String::to_double(&p_str[index], &rptr);
 					index += (rptr - &p_str[index]);
 					r_token.type = TK_NUMBER;
-					r_token.value = number;
+					r_token.number = number;
 					return OK;
 
 				} else if ((p_str[index] >= 'A' && p_str[index] <= 'Z') || (p_str[index] >= 'a' && p_str[index] <= 'z')) {
-					String id;
+					int from = index;
 
 					while ((p_str[index] >= 'A' && p_str[index] <= 'Z') || (p_str[index] >= 'a' && p_str[index] <= 'z')) {
-						id += p_str[index];
 						index++;
 					}
 
 					r_token.type = TK_IDENTIFIER;
-					r_token.value = id;
+					r_token.str = &p_str[from];
+					r_token.str_len = index - from;
 					return OK;
 				} else {
-					r_err_str = "Unexpected character.";
+					p_state.err_str = "Unexpected character.";
 					return ERR_PARSE_ERROR;
 				}
 			}
 		}
 	}
 
-	return ERR_PARSE_ERROR;
+	r_token.type = TK_EOF;
+	return OK;
 }
 
-Error JSON::_parse_value(Variant &value, Token &token, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str) {
-	if (token.type == TK_CURLY_BRACKET_OPEN) {
-		Dictionary d;
-		Error err = _parse_object(d, p_str, index, p_len, line, r_err_str);
+static bool _token_equals(const CharType *p_str, int p_len, const char *p_id) {
+	for (int i = 0; i < p_len; i++) {
+		if (p_id[i] == 0 || CharType(p_id[i]) != p_str[i]) {
+			return false;
+		}
+	}
+	return p_id[p_len] == 0;
+}
+
+Error JSON::_parse_value(ParseState &p_state, Token &p_token) {
+	Handler *handler = p_state.handler;
+
+	if (p_token.type == TK_CURLY_BRACKET_OPEN) {
+		Error err = handler->begin_object();
 		if (err) {
 			return err;
 		}
-		value = d;
-		return OK;
-	} else if (token.type == TK_BRACKET_OPEN) {
-		Array a;
-		Error err = _parse_array(a, p_str, index, p_len, line, r_err_str);
+		return _parse_object(p_state);
+	} else if (p_token.type == TK_BRACKET_OPEN) {
+		Error err = handler->begin_array();
 		if (err) {
 			return err;
 		}
-		value = a;
-		return OK;
-
-	} else if (token.type == TK_IDENTIFIER) {
-		String id = token.value;
-		if (id == "true") {
-			value = true;
-		} else if (id == "false") {
-			value = false;
-		} else if (id == "null") {
-			value = Variant();
+		return _parse_array(p_state);
+
+	} else if (p_token.type == TK_IDENTIFIER) {
+		if (_token_equals(p_token.str, p_token.str_len, "true")) {
+			return handler->bool_value(true);
+		} else if (_token_equals(p_token.str, p_token.str_len, "false")) {
+			return handler->bool_value(false);
+		} else if (_token_equals(p_token.str, p_token.str_len, "null")) {
+			return handler->null_value();
 		} else {
-			r_err_str = "Expected 'true','false' or 'null', got '" + id + "'.";
+			p_state.err_str = "Expected 'true','false' or 'null', got '" + String(p_token.str, p_token.str_len) + "'.";
 			return ERR_PARSE_ERROR;
 		}
-		return OK;
 
-	} else if (token.type == TK_NUMBER) {
-		value = token.value;
-		return OK;
-	} else if (token.type == TK_STRING) {
-		value = token.value;
-		return OK;
+	} else if (p_token.type == TK_NUMBER) {
+		return handler->number_value(p_token.number);
+	} else if (p_token.type == TK_STRING) {
+		return handler->string_value(p_token.str, p_token.str_len);
 	} else {
-		r_err_str = "Expected value, got " + String(tk_name[token.type]) + ".";
+		p_state.err_str = "Expected value, got " + String(tk_name[p_token.type]) + ".";
 		return ERR_PARSE_ERROR;
 	}
 }
 
-Error JSON::_parse_array(Array &array, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str) {
+Error JSON::_parse_array(ParseState &p_state) {
 	Token token;
 	bool need_comma = false;
 
-	while (index < p_len) {
-		Error err = _get_token(p_str, index, p_len, token, line, r_err_str);
+	while (p_state.index < p_state.len) {
+		Error err = _get_token(p_state, token);
 		if (err != OK) {
 			return err;
 		}
 
 		if (token.type == TK_BRACKET_CLOSE) {
-			return OK;
+			return p_state.handler->end_array();
 		}
 
 		if (need_comma) {
 			if (token.type != TK_COMMA) {
-				r_err_str = "Expected ','";
+				p_state.err_str = "Expected ','";
 				return ERR_PARSE_ERROR;
 			} else {
 				need_comma = false;
@@ -361,39 +494,36 @@ Error JSON::_parse_array(Array &array, const CharType *p_str, int &index, int p_
 			}
 		}
 
-		Variant v;
-		err = _parse_value(v, token, p_str, index, p_len, line, r_err_str);
+		err = _parse_value(p_state, token);
 		if (err) {
 			return err;
 		}
 
-		array.push_back(v);
 		need_comma = true;
 	}
 
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_object(Dictionary &object, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str) {
+Error JSON::_parse_object(ParseState &p_state) {
 	bool at_key = true;
-	String key;
 	Token token;
 	bool need_comma = false;
 
-	while (index < p_len) {
+	while (p_state.index < p_state.len) {
 		if (at_key) {
-			Error err = _get_token(p_str, index, p_len, token, line, r_err_str);
+			Error err = _get_token(p_state, token);
 			if (err != OK) {
 				return err;
 			}
 
 			if (token.type == TK_CURLY_BRACKET_CLOSE) {
-				return OK;
+				return p_state.handler->end_object();
 			}
 
 			if (need_comma) {
 				if (token.type != TK_COMMA) {
-					r_err_str = "Expected '}' or ','";
+					p_state.err_str = "Expected '}' or ','";
 					return ERR_PARSE_ERROR;
 				} else {
 					need_comma = false;
@@ -402,32 +532,35 @@ Error JSON::_parse_object(Dictionary &object, const CharType *p_str, int &index,
 			}
 
 			if (token.type != TK_STRING) {
-				r_err_str = "Expected key";
+				p_state.err_str = "Expected key";
 				return ERR_PARSE_ERROR;
 			}
 
-			key = token.value;
-			err = _get_token(p_str, index, p_len, token, line, r_err_str);
+			// The colon token never touches the scratch buffer, so the key view stays valid.
+			Token key = token;
+			err = _get_token(p_state, token);
 			if (err != OK) {
 				return err;
 			}
 			if (token.type != TK_COLON) {
-				r_err_str = "Expected ':'";
+				p_state.err_str = "Expected ':'";
 				return ERR_PARSE_ERROR;
 			}
+			err = p_state.handler->key(key.str, key.str_len);
+			if (err) {
+				return err;
+			}
 			at_key = false;
 		} else {
-			Error err = _get_token(p_str, index, p_len, token, line, r_err_str);
+			Error err = _get_token(p_state, token);
 			if (err != OK) {
 				return err;
 			}
 
-			Variant v;
-			err = _parse_value(v, token, p_str, index, p_len, line, r_err_str);
+			err = _parse_value(p_state, token);
 			if (err) {
 				return err;
 			}
-			object[key] = v;
 			need_comma = true;
 			at_key = true;
 		}
@@ -436,20 +569,151 @@ Error JSON::_parse_object(Dictionary &object, const CharType *p_str, int &index,
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
-	const CharType *str = p_json.ptr();
-	int idx = 0;
-	int len = p_json.length();
+Error JSON::parse_events(const CharType *p_str, int p_len, Handler *p_handler, String &r_err_str, int &r_err_line) {
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+
+	ParseState state;
+	state.str = p_str;
+	state.len = p_len;
+	state.handler = p_handler;
+
 	Token token;
-	r_err_line = 0;
-	String aux_key;
+	Error err = _get_token(state, token);
+	if (err == OK) {
+		err = _parse_value(state, token);
+	}
+
+	r_err_str = state.err_str;
+	r_err_line = state.line;
+	return err;
+}
+
+// Builds the Variant tree for JSON::parse() from the parser events.
+class JSONVariantBuilder : public JSON::Handler {
+	struct Frame {
+		bool is_object = false;
+		bool packing = false;
+		uint32_t number_from = 0;
+		Array array;
+		Dictionary object;
+		String key;
+	};
+
+	bool pack_number_arrays = false;
+	LocalVector<Frame> frames;
+	// Numbers of the arrays that may still become PackedFloat32Array, kept as
+	// doubles so nothing is lost if a non-number shows up later.
+	LocalVector<double> numbers;
+
+	void _unpack(Frame &p_frame) {
+		for (uint32_t i = p_frame.number_from; i < numbers.size(); i++) {
+			p_frame.array.push_back(numbers[i]);
+		}
+		numbers.resize(p_frame.number_from);
+		p_frame.packing = false;
+	}
 
-	Error err = _get_token(str, idx, len, token, r_err_line, r_err_str);
-	if (err) {
-		return err;
+	Error _add_value(const Variant &p_value) {
+		if (frames.empty()) {
+			result = p_value;
+			return OK;
+		}
+
+		Frame &frame = frames[frames.size() - 1];
+		if (frame.is_object) {
+			frame.object[frame.key] = p_value;
+		} else {
+			if (frame.packing) {
+				_unpack(frame);
+			}
+			frame.array.push_back(p_value);
+		}
+		return OK;
 	}
 
-	err = _parse_value(r_ret, token, str, idx, len, r_err_line, r_err_str);
+	void _push_frame(bool p_object) {
+		Frame frame;
+		frame.is_object = p_object;
+		frame.packing = !p_object && pack_number_arrays;
+		frame.number_from = numbers.size();
+		frames.push_back(frame);
+	}
+
+public:
+	Variant result;
+
+	virtual Error begin_object() {
+		_push_frame(true);
+		return OK;
+	}
+
+	virtual Error end_object() {
+		Dictionary object = frames[frames.size() - 1].object;
+		frames.resize(frames.size() - 1);
+		return _add_value(object);
+	}
+
+	virtual Error begin_array() {
+		_push_frame(false);
+		return OK;
+	}
+
+	virtual Error end_array() {
+		Frame &frame = frames[frames.size() - 1];
+		Variant value;
+		if (frame.packing && numbers.size() > frame.number_from) {
+			PackedFloat32Array packed;
+			packed.resize(numbers.size() - frame.number_from);
+			float *w = packed.ptrw();
+			for (uint32_t i = frame.number_from; i < numbers.size(); i++) {
+				w[i - frame.number_from] = numbers[i];
+			}
+			numbers.resize(frame.number_from);
+			value = packed;
+		} else {
+			value = frame.array;
+		}
+		frames.resize(frames.size() - 1);
+		return _add_value(value);
+	}
+
+	virtual Error key(const CharType *p_str, int p_len) {
+		frames[frames.size() - 1].key = String(p_str, p_len);
+		return OK;
+	}
+
+	virtual Error string_value(const CharType *p_str, int p_len) {
+		return _add_value(String(p_str, p_len));
+	}
+
+	virtual Error number_value(double p_value) {
+		if (!frames.empty() && frames[frames.size() - 1].packing) {
+			numbers.push_back(p_value);
+			return OK;
+		}
+		return _add_value(p_value);
+	}
+
+	virtual Error bool_value(bool p_value) {
+		return _add_value(p_value);
+	}
+
+	virtual Error null_value() {
+		return _add_value(Variant());
+	}
+
+	JSONVariantBuilder(bool p_pack_number_arrays) {
+		pack_number_arrays = p_pack_number_arrays;
+	}
+};
+
+Error JSON::parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line, bool p_pack_number_arrays) {
+	JSONVariantBuilder builder(p_pack_number_arrays);
+
+	Error err = parse_events(p_json.ptr(), p_json.length(), &builder, r_err_str, r_err_line);
+	if (err == OK) {
+		r_ret = builder.result;
+	}
 
 	return err;
 }
@@ -31,9 +31,30 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/local_vector.h"
 #include "core/variant.h"
 
 class JSON {
+public:
+	// Receives the events of parse_events(). String views point either into the
+	// parsed text or into a scratch buffer, and are only valid during the call.
+	// Returning anything other than OK stops parsing with that error.
+	class Handler {
+	public:
+		virtual Error begin_object() = 0;
+		virtual Error end_object() = 0;
+		virtual Error begin_array() = 0;
+		virtual Error end_array() = 0;
+		virtual Error key(const CharType *p_str, int p_len) = 0;
+		virtual Error string_value(const CharType *p_str, int p_len) = 0;
+		virtual Error number_value(double p_value) = 0;
+		virtual Error bool_value(bool p_value) = 0;
+		virtual Error null_value() = 0;
+
+		virtual ~Handler() {}
+	};
+
+private:
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
@@ -48,31 +69,41 @@ class JSON {
 		TK_MAX
 	};
 
-	enum Expecting {
-
-		EXPECT_OBJECT,
-		EXPECT_OBJECT_KEY,
-		EXPECT_COLON,
-		EXPECT_OBJECT_VALUE,
+	struct Token {
+		TokenType type = TK_EOF;
+		const CharType *str = nullptr;
+		int str_len = 0;
+		double number = 0;
 	};
 
-	struct Token {
-		TokenType type;
-		Variant value;
+	struct ParseState {
+		const CharType *str = nullptr;
+		int index = 0;
+		int len = 0;
+		int line = 0;
+		String err_str;
+		LocalVector<CharType> scratch;
+		Handler *handler = nullptr;
 	};
 
 	static const char *tk_name[TK_MAX];
 
-	static String _print_var(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys);
+	static void _write_var(LocalVector<uint8_t> &r_buffer, const Variant &p_var, const CharString &p_indent, int p_cur_indent, bool p_sort_keys);
 
-	static Error _get_token(const CharType *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
-	static Error _parse_value(Variant &value, Token &token, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_array(Array &array, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
-	static Error _parse_object(Dictionary &object, const CharType *p_str, int &index, int p_len, int &line, String &r_err_str);
+	static Error _get_token(ParseState &p_state, Token &r_token);
+	static Error _parse_value(ParseState &p_state, Token &p_token);
+	static Error _parse_array(ParseState &p_state);
+	static Error _parse_object(ParseState &p_state);
 
 public:
 	static String print(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true);
-	static Error parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
+	// Appends the UTF-8 encoded JSON to r_buffer, which can be cleared and reused between calls.
+	static void print_to_buffer(const Variant &p_var, LocalVector<uint8_t> &r_buffer, const String &p_indent = "", bool p_sort_keys = true);
+
+	// With p_pack_number_arrays, non-empty arrays holding only numbers are returned as PackedFloat32Array.
+	static Error parse(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line, bool p_pack_number_arrays = false);
+	// p_str must be null-terminated at p_len, as String::ptr() is.
+	static Error parse_events(const CharType *p_str, int p_len, Handler *p_handler, String &r_err_str, int &r_err_line);
 };
 
 #endif // JSON_H
@@ -593,10 +593,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				copymem(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -623,9 +620,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int32_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				copymem(w, buf, count * 4);
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -635,7 +636,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
-			int64_t count = decode_uint64(buf);
+			int32_t count = decode_uint32(buf);
 			buf += 4;
 			len -= 4;
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
@@ -647,9 +648,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
+#ifdef BIG_ENDIAN_ENABLED
+				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				copymem(w, buf, count * 8);
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -671,9 +676,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const float*rbuf=(const float*)buf;
 				data.resize(count);
 				float *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				copymem(w, buf, count * 4);
+#endif
 			}
 			r_variant = data;
 
@@ -684,7 +693,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
-			int64_t count = decode_uint64(buf);
+			int32_t count = decode_uint32(buf);
 			buf += 4;
 			len -= 4;
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
@@ -696,9 +705,13 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const double*rbuf=(const double*)buf;
 				data.resize(count);
 				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
+#ifdef BIG_ENDIAN_ENABLED
+				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				copymem(w, buf, count * 8);
+#endif
 			}
 			r_variant = data;
 
@@ -751,10 +764,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				varray.resize(count);
 				Vector2 *w = varray.ptrw();
 
+#if defined(BIG_ENDIAN_ENABLED) || defined(REAL_T_IS_DOUBLE)
 				for (int32_t i = 0; i < count; i++) {
 					w[i].x = decode_float(buf + i * 4 * 2 + 4 * 0);
 					w[i].y = decode_float(buf + i * 4 * 2 + 4 * 1);
 				}
+#else
+				copymem(w, buf, count * 4 * 2);
+#endif
 
 				int adv = 4 * 2 * count;
 
@@ -785,11 +802,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				varray.resize(count);
 				Vector3 *w = varray.ptrw();
 
+#if defined(BIG_ENDIAN_ENABLED) || defined(REAL_T_IS_DOUBLE)
 				for (int32_t i = 0; i < count; i++) {
 					w[i].x = decode_float(buf + i * 4 * 3 + 4 * 0);
 					w[i].y = decode_float(buf + i * 4 * 3 + 4 * 1);
 					w[i].z = decode_float(buf + i * 4 * 3 + 4 * 2);
 				}
+#else
+				copymem(w, buf, count * 4 * 3);
+#endif
 
 				int adv = 4 * 3 * count;
 
@@ -820,12 +841,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
 					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#else
+				copymem(w, buf, count * 4 * 4);
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -1339,9 +1364,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const int32_t *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < datalen; i++) {
 					encode_uint32(r[i], &buf[i * datasize]);
 				}
+#else
+				copymem(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1353,12 +1382,16 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			int datasize = sizeof(int64_t);
 
 			if (buf) {
-				encode_uint64(datalen, buf);
+				encode_uint32(datalen, buf);
 				buf += 4;
 				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
+#ifdef BIG_ENDIAN_ENABLED
+				for (int32_t i = 0; i < datalen; i++) {
 					encode_uint64(r[i], &buf[i * datasize]);
 				}
+#else
+				copymem(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1373,9 +1406,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const float *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < datalen; i++) {
 					encode_float(r[i], &buf[i * datasize]);
 				}
+#else
+				copymem(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1390,9 +1427,13 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				encode_uint32(datalen, buf);
 				buf += 4;
 				const double *r = data.ptr();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int i = 0; i < datalen; i++) {
 					encode_double(r[i], &buf[i * datasize]);
 				}
+#else
+				copymem(buf, r, datalen * datasize);
+#endif
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1490,6 +1531,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
+#ifndef BIG_ENDIAN_ENABLED
+				copymem(buf, data.ptr(), len * 4 * 4);
+				buf += len * 4 * 4;
+#else
 				for (int i = 0; i < len; i++) {
 					Color c = data.get(i);
 
@@ -1499,6 +1544,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					encode_float(c.a, &buf[12]);
 					buf += 4 * 4;
 				}
+#endif
 			}
 
 			r_len += 4 * 4 * len;
@@ -1511,3 +1557,90 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 	return OK;
 }
+
+static _FORCE_INLINE_ uint8_t *_encode_reserve(Vector<uint8_t> &r_buffer, int p_pos, int p_size) {
+	if (unlikely(r_buffer.size() < p_pos + p_size)) {
+		r_buffer.resize(next_power_of_2(p_pos + p_size));
+	}
+	return r_buffer.ptrw() + p_pos;
+}
+
+static Error _encode_variant_append(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_pos, bool p_full_objects) {
+	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			CharString utf8 = String(p_variant).utf8();
+			int size = 8 + utf8.length();
+			int pad = size % 4 ? 4 - size % 4 : 0;
+
+			uint8_t *w = _encode_reserve(r_buffer, r_pos, size + pad);
+			encode_uint32(p_variant.get_type(), w);
+			encode_uint32(utf8.length(), w + 4);
+			copymem(w + 8, utf8.get_data(), utf8.length());
+			zeromem(w + size, pad);
+			r_pos += size + pad;
+
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+
+			uint8_t *w = _encode_reserve(r_buffer, r_pos, 8);
+			encode_uint32(Variant::DICTIONARY, w);
+			encode_uint32(uint32_t(d.size()), w + 4);
+			r_pos += 8;
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				Error err = _encode_variant_append(E->get(), r_buffer, r_pos, p_full_objects);
+				if (err) {
+					return err;
+				}
+				Variant *v = d.getptr(E->get());
+				ERR_FAIL_COND_V(!v, ERR_BUG);
+				err = _encode_variant_append(*v, r_buffer, r_pos, p_full_objects);
+				if (err) {
+					return err;
+				}
+			}
+
+		} break;
+		case Variant::ARRAY: {
+			Array a = p_variant;
+
+			uint8_t *w = _encode_reserve(r_buffer, r_pos, 8);
+			encode_uint32(Variant::ARRAY, w);
+			encode_uint32(uint32_t(a.size()), w + 4);
+			r_pos += 8;
+
+			for (int i = 0; i < a.size(); i++) {
+				Error err = _encode_variant_append(a.get(i), r_buffer, r_pos, p_full_objects);
+				if (err) {
+					return err;
+				}
+			}
+
+		} break;
+		default: {
+			// Measuring everything else is constant time, except for PackedStringArray and full objects.
+			int len;
+			Error err = encode_variant(p_variant, nullptr, len, p_full_objects);
+			if (err) {
+				return err;
+			}
+			err = encode_variant(p_variant, _encode_reserve(r_buffer, r_pos, len), len, p_full_objects);
+			if (err) {
+				return err;
+			}
+			r_pos += len;
+		}
+	}
+
+	return OK;
+}
+
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects) {
+	r_len = 0;
+	return _encode_variant_append(p_variant, r_buffer, r_len, p_full_objects);
+}
@@ -182,5 +182,7 @@ public:
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false);
+// Encodes in a single pass to the start of r_buffer, which grows as needed and is never shrunk, so it can be reused.
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_len, bool p_full_objects = false);
 
 #endif // MARSHALLS_H
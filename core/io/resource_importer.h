@@ -45,6 +45,7 @@ class ResourceFormatImporter : public ResourceFormatLoader {
 	};
 
 	Error _get_path_and_type(const String &p_path, PathAndType &r_path_and_type, bool *r_valid = nullptr) const;
+	Ref<ResourceImporter> _get_importer_for_path(const String &p_path) const;
 
 	static ResourceFormatImporter *singleton;
 
@@ -72,6 +73,7 @@ public:
 
 	virtual bool can_be_imported(const String &p_path) const;
 	virtual int get_import_order(const String &p_path) const;
+	bool can_import_threaded(const String &p_path) const;
 
 	String get_internal_resource_path(const String &p_path) const;
 	void get_internal_resource_path_list(const String &p_path, List<String> *r_paths);
@@ -102,6 +104,13 @@ public:
 	virtual String get_resource_type() const = 0;
 	virtual float get_priority() const { return 1.0; }
 	virtual int get_import_order() const { return 0; }
+	// Whether import() can run for several files at once on different threads.
+	virtual bool can_import_threaded() const { return false; }
+	// Whether the output only depends on the source file, the options and the import
+	// settings, so it can be reused from the shared import cache.
+	virtual bool can_cache_import(const Map<StringName, Variant> &p_options) const { return false; }
+	// Bump when the output for the same source and options changes, so cached imports are not reused.
+	virtual int get_format_version() const { return 0; }
 
 	struct ImportOption {
 		PropertyInfo option;
@@ -106,7 +106,6 @@ private:
 	static Ref<ResourceFormatLoader> _find_custom_resource_format_loader(String path);
 
 	struct ThreadLoadTask {
-		Thread *thread = nullptr;
 		Thread::ID loader_id = 0;
 		Semaphore *semaphore = nullptr;
 		String local_path;
@@ -118,22 +117,26 @@ private:
 		RES resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
-		bool start_next = true;
+		bool started = false; //picked by a worker, or by a thread that needed it first
 		int requests = 0;
 		int poll_requests = 0;
 		Set<String> sub_tasks;
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static void _thread_load_worker(void *p_userdata);
+	static bool _thread_load_would_deadlock(const String &p_path);
 	static Mutex *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
+	static List<String> thread_load_queue;
+	static HashMap<Thread::ID, String> thread_load_waiting; //task each thread is blocked on, to detect cyclic waits
+	static Vector<Thread *> thread_load_workers;
 	static Semaphore *thread_load_semaphore;
-	static int thread_waiting_count;
-	static int thread_loading_count;
-	static int thread_suspended_count;
+	static bool thread_load_exit;
 	static int thread_load_max;
+	static bool load_dependencies_in_threads;
 
-	static float _dependency_get_progress(const String &p_path);
+	static void _dependency_get_progress(const String &p_path, Set<String> &r_visited, float &r_progress);
 
 public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, const String &p_source_resource = String());
@@ -177,6 +180,9 @@ public:
 		dep_err_notify_ud = p_ud;
 	}
 
+	static void set_load_dependencies_in_threads(bool p_enable) { load_dependencies_in_threads = p_enable; }
+	static bool get_load_dependencies_in_threads() { return load_dependencies_in_threads; }
+
 	static void set_abort_on_missing_resources(bool p_abort) { abort_on_missing_resource = p_abort; }
 	static bool get_abort_on_missing_resources() { return abort_on_missing_resource; }
 
@@ -107,6 +107,8 @@ public:
 	}
 
 	_FORCE_INLINE_ U size() const { return count; }
+	_FORCE_INLINE_ T *ptr() { return data; }
+	_FORCE_INLINE_ const T *ptr() const { return data; }
 	void resize(U p_size) {
 		if (p_size < count) {
 			if (!__has_trivial_destructor(T) && !force_trivial) {
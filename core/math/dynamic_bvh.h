@@ -0,0 +1,863 @@
+/*************************************************************************/
+/*  dynamic_bvh.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef DYNAMIC_BVH_H
+#define DYNAMIC_BVH_H
+
+#include "core/local_vector.h"
+#include "core/math/aabb.h"
+#include "core/math/geometry.h"
+#include "core/oa_hash_map.h"
+
+/**
+ * Dynamic bounding volume hierarchy, meant as a faster replacement of Octree
+ * when there are many elements and many of them move.
+ *
+ * Nodes live in flat arrays and are kept balanced with tree rotations. Leaves
+ * store a slightly enlarged AABB, so small moves only refit pairs and don't
+ * touch the tree. Pairable and non-pairable elements go to separate trees, so
+ * a moving non-pairable element only has to check the (usually small)
+ * pairable tree for new pairs.
+ *
+ * Culling doesn't write to the tree, so it can run from several threads at
+ * once as long as nothing is modified meanwhile.
+ */
+
+typedef uint32_t DynamicBVHElementID;
+
+#define DYNAMIC_BVH_ELEMENT_INVALID_ID 0
+
+template <class T>
+class DynamicBVH {
+public:
+	typedef void *(*PairCallback)(void *, DynamicBVHElementID, T *, int, DynamicBVHElementID, T *, int);
+	typedef void (*UnpairCallback)(void *, DynamicBVHElementID, T *, int, DynamicBVHElementID, T *, int, void *);
+
+private:
+	enum {
+		TREE_NON_PAIRABLE,
+		TREE_PAIRABLE,
+		TREE_MAX,
+	};
+
+	enum {
+		STACK_MAX = 128 // trees are kept balanced, so this is way more than the height of any realistic tree
+	};
+
+	struct Node {
+		AABB aabb; // enlarged for leaves
+		uint32_t type_mask = 0; // pairable types of all the elements below
+		int32_t parent = -1; // next free node when not in use
+		int32_t children[2] = { -1, -1 };
+		int32_t height = 0;
+		uint32_t element = 0;
+
+		_FORCE_INLINE_ bool is_leaf() const { return children[0] == -1; }
+	};
+
+	struct Tree {
+		LocalVector<Node> nodes;
+		int32_t root = -1;
+		int32_t free_node = -1;
+	};
+
+	struct Element {
+		T *userdata = nullptr;
+		AABB aabb;
+		int subindex = 0;
+		bool pairable = false;
+		bool in_use = false;
+		uint32_t pairable_type = 0;
+		uint32_t pairable_mask = 0;
+		int32_t node = -1; // leaf in trees[pairable], -1 if not in the tree
+		LocalVector<uint32_t> pairs;
+	};
+
+	struct Pair {
+		uint32_t element[2];
+		uint32_t index[2]; // position in each element's pair list
+		void *ud = nullptr;
+	};
+
+	Tree trees[TREE_MAX];
+
+	LocalVector<Element> elements;
+	LocalVector<uint32_t> free_elements;
+
+	LocalVector<Pair> pairs;
+	LocalVector<uint32_t> free_pairs;
+	OAHashMap<uint64_t, uint32_t> pair_map;
+
+	PairCallback pair_callback = nullptr;
+	UnpairCallback unpair_callback = nullptr;
+	void *pair_callback_userdata = nullptr;
+	void *unpair_callback_userdata = nullptr;
+
+	int pair_count = 0;
+
+	static _FORCE_INLINE_ real_t _cost(const AABB &p_aabb) {
+		// half surface area
+		return p_aabb.size.x * p_aabb.size.y + p_aabb.size.y * p_aabb.size.z + p_aabb.size.z * p_aabb.size.x;
+	}
+
+	static _FORCE_INLINE_ AABB _enlarge(const AABB &p_aabb) {
+		return p_aabb.grow(p_aabb.get_longest_axis_size() * 0.1 + CMP_EPSILON);
+	}
+
+	static _FORCE_INLINE_ uint64_t _pair_key(uint32_t p_a, uint32_t p_b) {
+		return p_a < p_b ? ((uint64_t(p_a) << 32) | p_b) : ((uint64_t(p_b) << 32) | p_a);
+	}
+
+	_FORCE_INLINE_ bool _can_pair(const Element &p_a, const Element &p_b) const {
+		if (p_a.userdata == p_b.userdata) {
+			return false;
+		}
+		return (p_a.pairable_type & p_b.pairable_mask) || (p_b.pairable_type & p_a.pairable_mask);
+	}
+
+	int32_t _alloc_node(Tree &p_tree);
+	void _free_node(Tree &p_tree, int32_t p_node);
+	void _update_node(Tree &p_tree, int32_t p_node);
+	int32_t _balance(Tree &p_tree, int32_t p_node);
+	void _refit_from(Tree &p_tree, int32_t p_node);
+	void _insert_leaf(Tree &p_tree, int32_t p_leaf);
+	void _remove_leaf(Tree &p_tree, int32_t p_leaf);
+
+	void _tree_insert(uint32_t p_element);
+	void _tree_remove(uint32_t p_element);
+
+	void _pair(uint32_t p_a, uint32_t p_b);
+	void _unpair(uint32_t p_pair);
+	void _unpair_all(uint32_t p_element);
+	void _update_pairs(uint32_t p_element);
+
+	struct _CullConvexData {
+		const Plane *planes;
+		int plane_count;
+		const Vector3 *points;
+		int point_count;
+		T **result_array;
+		int result_count;
+		int result_max;
+		uint32_t mask;
+	};
+
+	void _cull_convex(const Tree &p_tree, _CullConvexData &p_cull) const;
+	template <class Q>
+	int _cull(const Q &p_query, T **p_result_array, int p_result_count, int p_result_max, uint32_t p_mask) const;
+
+	struct _AABBQuery {
+		AABB aabb;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return aabb.intersects(p_aabb); }
+	};
+
+	struct _SegmentQuery {
+		Vector3 from;
+		Vector3 to;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return p_aabb.intersects_segment(from, to); }
+	};
+
+	struct _PointQuery {
+		Vector3 point;
+		_FORCE_INLINE_ bool test(const AABB &p_aabb) const { return p_aabb.has_point(point); }
+	};
+
+public:
+	DynamicBVHElementID create(T *p_userdata, const AABB &p_aabb = AABB(), int p_subindex = 0, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void move(DynamicBVHElementID p_id, const AABB &p_aabb);
+	void set_pairable(DynamicBVHElementID p_id, bool p_pairable = false, uint32_t p_pairable_type = 0, uint32_t pairable_mask = 1);
+	void erase(DynamicBVHElementID p_id);
+
+	bool is_pairable(DynamicBVHElementID p_id) const;
+	T *get(DynamicBVHElementID p_id) const;
+	int get_subindex(DynamicBVHElementID p_id) const;
+
+	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) const;
+	int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) const;
+	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) const;
+	int cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) const;
+
+	void set_pair_callback(PairCallback p_callback, void *p_userdata);
+	void set_unpair_callback(UnpairCallback p_callback, void *p_userdata);
+
+	int get_pair_count() const { return pair_count; }
+	int get_elem_count() const { return elements.size() - free_elements.size(); }
+};
+
+/* TREE */
+
+template <class T>
+int32_t DynamicBVH<T>::_alloc_node(Tree &p_tree) {
+	int32_t node;
+	if (p_tree.free_node != -1) {
+		node = p_tree.free_node;
+		p_tree.free_node = p_tree.nodes[node].parent;
+	} else {
+		node = p_tree.nodes.size();
+		p_tree.nodes.push_back(Node());
+	}
+
+	Node &n = p_tree.nodes[node];
+	n.parent = -1;
+	n.children[0] = -1;
+	n.children[1] = -1;
+	n.height = 0;
+	n.type_mask = 0;
+	return node;
+}
+
+template <class T>
+void DynamicBVH<T>::_free_node(Tree &p_tree, int32_t p_node) {
+	p_tree.nodes[p_node].parent = p_tree.free_node;
+	p_tree.nodes[p_node].height = -1;
+	p_tree.free_node = p_node;
+}
+
+template <class T>
+void DynamicBVH<T>::_update_node(Tree &p_tree, int32_t p_node) {
+	Node &n = p_tree.nodes[p_node];
+	const Node &a = p_tree.nodes[n.children[0]];
+	const Node &b = p_tree.nodes[n.children[1]];
+	n.aabb = a.aabb.merge(b.aabb);
+	n.height = 1 + MAX(a.height, b.height);
+	n.type_mask = a.type_mask | b.type_mask;
+}
+
+// Rotates the taller grandchild up when the children heights differ by more than one.
+// Returns the node that ends up at the position of p_node.
+template <class T>
+int32_t DynamicBVH<T>::_balance(Tree &p_tree, int32_t p_node) {
+	Node *nodes = p_tree.nodes.ptr();
+	Node &a = nodes[p_node];
+
+	if (a.is_leaf() || a.height < 2) {
+		return p_node;
+	}
+
+	int32_t b_idx = a.children[0];
+	int32_t c_idx = a.children[1];
+	int32_t balance = nodes[c_idx].height - nodes[b_idx].height;
+
+	if (balance > 1 || balance < -1) {
+		// rotate the taller child (up) into a's place, a becomes its child
+		int32_t side = balance > 1 ? 1 : 0; // which child of a goes up
+		int32_t up_idx = a.children[side];
+		Node &up = nodes[up_idx];
+		int32_t f_idx = up.children[0];
+		int32_t g_idx = up.children[1];
+
+		up.children[0] = p_node;
+		up.parent = a.parent;
+		a.parent = up_idx;
+
+		if (up.parent != -1) {
+			Node &parent = nodes[up.parent];
+			parent.children[parent.children[0] == p_node ? 0 : 1] = up_idx;
+		} else {
+			p_tree.root = up_idx;
+		}
+
+		// the taller grandchild stays with up, the other replaces up under a
+		if (nodes[f_idx].height > nodes[g_idx].height) {
+			up.children[1] = f_idx;
+			a.children[side] = g_idx;
+			nodes[g_idx].parent = p_node;
+		} else {
+			up.children[1] = g_idx;
+			a.children[side] = f_idx;
+			nodes[f_idx].parent = p_node;
+		}
+
+		_update_node(p_tree, p_node);
+		_update_node(p_tree, up_idx);
+		return up_idx;
+	}
+
+	return p_node;
+}
+
+template <class T>
+void DynamicBVH<T>::_refit_from(Tree &p_tree, int32_t p_node) {
+	while (p_node != -1) {
+		p_node = _balance(p_tree, p_node);
+		_update_node(p_tree, p_node);
+		p_node = p_tree.nodes[p_node].parent;
+	}
+}
+
+template <class T>
+void DynamicBVH<T>::_insert_leaf(Tree &p_tree, int32_t p_leaf) {
+	if (p_tree.root == -1) {
+		p_tree.root = p_leaf;
+		p_tree.nodes[p_leaf].parent = -1;
+		return;
+	}
+
+	// find the best sibling, descending while it's cheaper than pairing with the current node
+	AABB leaf_aabb = p_tree.nodes[p_leaf].aabb;
+	int32_t index = p_tree.root;
+	while (!p_tree.nodes[index].is_leaf()) {
+		const Node &n = p_tree.nodes[index];
+
+		real_t combined_cost = _cost(n.aabb.merge(leaf_aabb));
+		real_t cost = 2.0 * combined_cost;
+		real_t inheritance_cost = 2.0 * (combined_cost - _cost(n.aabb));
+
+		real_t child_cost[2];
+		for (int i = 0; i < 2; i++) {
+			const Node &child = p_tree.nodes[n.children[i]];
+			child_cost[i] = _cost(child.aabb.merge(leaf_aabb)) + inheritance_cost;
+			if (!child.is_leaf()) {
+				child_cost[i] -= _cost(child.aabb);
+			}
+		}
+
+		if (cost < child_cost[0] && cost < child_cost[1]) {
+			break;
+		}
+
+		index = n.children[child_cost[0] < child_cost[1] ? 0 : 1];
+	}
+
+	int32_t sibling = index;
+	int32_t old_parent = p_tree.nodes[sibling].parent;
+	int32_t new_parent = _alloc_node(p_tree);
+
+	Node &np = p_tree.nodes[new_parent];
+	np.parent = old_parent;
+	np.children[0] = sibling;
+	np.children[1] = p_leaf;
+
+	if (old_parent != -1) {
+		Node &op = p_tree.nodes[old_parent];
+		op.children[op.children[0] == sibling ? 0 : 1] = new_parent;
+	} else {
+		p_tree.root = new_parent;
+	}
+
+	p_tree.nodes[sibling].parent = new_parent;
+	p_tree.nodes[p_leaf].parent = new_parent;
+
+	_refit_from(p_tree, new_parent);
+}
+
+template <class T>
+void DynamicBVH<T>::_remove_leaf(Tree &p_tree, int32_t p_leaf) {
+	if (p_leaf == p_tree.root) {
+		p_tree.root = -1;
+		return;
+	}
+
+	int32_t parent = p_tree.nodes[p_leaf].parent;
+	int32_t grand_parent = p_tree.nodes[parent].parent;
+	const Node &pn = p_tree.nodes[parent];
+	int32_t sibling = pn.children[pn.children[0] == p_leaf ? 1 : 0];
+
+	if (grand_parent != -1) {
+		Node &gp = p_tree.nodes[grand_parent];
+		gp.children[gp.children[0] == parent ? 0 : 1] = sibling;
+		p_tree.nodes[sibling].parent = grand_parent;
+		_free_node(p_tree, parent);
+		_refit_from(p_tree, grand_parent);
+	} else {
+		p_tree.root = sibling;
+		p_tree.nodes[sibling].parent = -1;
+		_free_node(p_tree, parent);
+	}
+}
+
+template <class T>
+void DynamicBVH<T>::_tree_insert(uint32_t p_element) {
+	Element &e = elements[p_element];
+	if (e.aabb.has_no_surface()) {
+		return; // same as octree, empty elements are not culled nor paired
+	}
+
+	Tree &tree = trees[e.pairable ? TREE_PAIRABLE : TREE_NON_PAIRABLE];
+	int32_t leaf = _alloc_node(tree);
+	Node &n = tree.nodes[leaf];
+	n.aabb = _enlarge(e.aabb);
+	n.element = p_element;
+	n.type_mask = e.pairable_type;
+	e.node = leaf;
+
+	_insert_leaf(tree, leaf);
+}
+
+template <class T>
+void DynamicBVH<T>::_tree_remove(uint32_t p_element) {
+	Element &e = elements[p_element];
+	if (e.node == -1) {
+		return;
+	}
+
+	Tree &tree = trees[e.pairable ? TREE_PAIRABLE : TREE_NON_PAIRABLE];
+	_remove_leaf(tree, e.node);
+	_free_node(tree, e.node);
+	e.node = -1;
+}
+
+/* PAIRS */
+
+template <class T>
+void DynamicBVH<T>::_pair(uint32_t p_a, uint32_t p_b) {
+	uint32_t pair_idx;
+	if (free_pairs.size()) {
+		pair_idx = free_pairs[free_pairs.size() - 1];
+		free_pairs.resize(free_pairs.size() - 1);
+	} else {
+		pair_idx = pairs.size();
+		pairs.push_back(Pair());
+	}
+
+	Element &a = elements[p_a];
+	Element &b = elements[p_b];
+
+	Pair &pair = pairs[pair_idx];
+	pair.element[0] = p_a;
+	pair.element[1] = p_b;
+	pair.index[0] = a.pairs.size();
+	pair.index[1] = b.pairs.size();
+	a.pairs.push_back(pair_idx);
+	b.pairs.push_back(pair_idx);
+
+	pair_map.insert(_pair_key(p_a, p_b), pair_idx);
+
+	pair.ud = pair_callback ? pair_callback(pair_callback_userdata, p_a + 1, a.userdata, a.subindex, p_b + 1, b.userdata, b.subindex) : nullptr;
+	pair_count++;
+}
+
+template <class T>
+void DynamicBVH<T>::_unpair(uint32_t p_pair) {
+	Pair pair = pairs[p_pair];
+	Element &a = elements[pair.element[0]];
+	Element &b = elements[pair.element[1]];
+
+	if (unpair_callback) {
+		unpair_callback(unpair_callback_userdata, pair.element[0] + 1, a.userdata, a.subindex, pair.element[1] + 1, b.userdata, b.subindex, pair.ud);
+	}
+	pair_count--;
+
+	// swap-remove from both pair lists, fixing the index of the pair moved into place
+	for (int i = 0; i < 2; i++) {
+		LocalVector<uint32_t> &list = elements[pair.element[i]].pairs;
+		uint32_t last = list[list.size() - 1];
+		list[pair.index[i]] = last;
+		list.resize(list.size() - 1);
+		if (last != p_pair) {
+			Pair &moved = pairs[last];
+			moved.index[moved.element[0] == pair.element[i] ? 0 : 1] = pair.index[i];
+		}
+	}
+
+	pair_map.remove(_pair_key(pair.element[0], pair.element[1]));
+	free_pairs.push_back(p_pair);
+}
+
+template <class T>
+void DynamicBVH<T>::_unpair_all(uint32_t p_element) {
+	while (elements[p_element].pairs.size()) {
+		const LocalVector<uint32_t> &list = elements[p_element].pairs;
+		_unpair(list[list.size() - 1]);
+	}
+}
+
+template <class T>
+void DynamicBVH<T>::_update_pairs(uint32_t p_element) {
+	if (elements[p_element].node == -1) {
+		_unpair_all(p_element); // out of the tree, like in Octree it can't be paired
+		return;
+	}
+
+	// drop the pairs that stopped overlapping
+	for (int i = int(elements[p_element].pairs.size()) - 1; i >= 0; i--) {
+		const Pair &pair = pairs[elements[p_element].pairs[i]];
+		uint32_t other = pair.element[pair.element[0] == p_element ? 1 : 0];
+		if (!elements[p_element].aabb.intersects_inclusive(elements[other].aabb)) {
+			_unpair(elements[p_element].pairs[i]);
+		}
+	}
+
+	// non-pairable elements only pair with pairable ones, so they don't need to look at their own tree
+	int first_tree = elements[p_element].pairable ? TREE_NON_PAIRABLE : TREE_PAIRABLE;
+
+	for (int t = first_tree; t < TREE_MAX; t++) {
+		const Tree &tree = trees[t];
+		if (tree.root == -1) {
+			continue;
+		}
+
+		int32_t stack[STACK_MAX];
+		int sp = 0;
+		stack[sp++] = tree.root;
+
+		while (sp) {
+			const Node &n = tree.nodes[stack[--sp]];
+			const Element &e = elements[p_element];
+
+			if (!n.aabb.intersects_inclusive(e.aabb)) {
+				continue;
+			}
+
+			if (!n.is_leaf()) {
+				ERR_FAIL_COND(sp + 2 > STACK_MAX);
+				stack[sp++] = n.children[1];
+				stack[sp++] = n.children[0];
+				continue;
+			}
+
+			if (n.element == p_element) {
+				continue;
+			}
+
+			const Element &other = elements[n.element];
+			if (!_can_pair(e, other) || !e.aabb.intersects_inclusive(other.aabb)) {
+				continue;
+			}
+
+			if (!pair_map.lookup_ptr(_pair_key(p_element, n.element))) {
+				_pair(p_element, n.element);
+			}
+		}
+	}
+}
+
+/* CULLING */
+
+template <class T>
+void DynamicBVH<T>::_cull_convex(const Tree &p_tree, _CullConvexData &p_cull) const {
+	if (p_tree.root == -1) {
+		return;
+	}
+
+	// each stack entry keeps the planes its node still has to be tested against,
+	// once a node is fully inside a plane its children skip that plane
+	int32_t stack[STACK_MAX];
+	uint32_t stack_planes[STACK_MAX];
+	int sp = 0;
+
+	uint32_t all_planes = p_cull.plane_count >= 32 ? 0xFFFFFFFF : ((1u << p_cull.plane_count) - 1);
+	stack[sp] = p_tree.root;
+	stack_planes[sp] = all_planes;
+	sp++;
+
+	while (sp) {
+		sp--;
+		const Node &n = p_tree.nodes[stack[sp]];
+		uint32_t planes = stack_planes[sp];
+
+		if (!(n.type_mask & p_cull.mask)) {
+			continue;
+		}
+
+		const AABB &aabb = n.is_leaf() ? elements[n.element].aabb : n.aabb;
+		Vector3 half_extents = aabb.size * 0.5;
+		Vector3 center = aabb.position + half_extents;
+
+		bool outside = false;
+		for (int i = 0; i < p_cull.plane_count; i++) {
+			if (i < 32 && !(planes & (1u << i))) {
+				continue;
+			}
+
+			const Plane &p = p_cull.planes[i];
+			real_t d = p.normal.dot(center) - p.d;
+			real_t r = Math::abs(p.normal.x) * half_extents.x + Math::abs(p.normal.y) * half_extents.y + Math::abs(p.normal.z) * half_extents.z;
+
+			if (d - r > 0) {
+				outside = true;
+				break;
+			}
+			if (d + r <= 0 && i < 32) {
+				planes &= ~(1u << i);
+			}
+		}
+
+		if (outside) {
+			continue;
+		}
+
+		if (!n.is_leaf()) {
+			ERR_FAIL_COND(sp + 2 > STACK_MAX);
+			stack[sp] = n.children[1];
+			stack_planes[sp] = planes;
+			sp++;
+			stack[sp] = n.children[0];
+			stack_planes[sp] = planes;
+			sp++;
+			continue;
+		}
+
+		const Element &e = elements[n.element];
+
+		// inside all planes means fully inside the convex, otherwise do the exact test
+		if ((planes != 0 || p_cull.plane_count > 32) && !e.aabb.intersects_convex_shape(p_cull.planes, p_cull.plane_count, p_cull.points, p_cull.point_count)) {
+			continue;
+		}
+
+		if (p_cull.result_count == p_cull.result_max) {
+			return;
+		}
+		p_cull.result_array[p_cull.result_count++] = e.userdata;
+	}
+}
+
+template <class T>
+template <class Q>
+int DynamicBVH<T>::_cull(const Q &p_query, T **p_result_array, int p_result_count, int p_result_max, uint32_t p_mask) const {
+	for (int t = 0; t < TREE_MAX; t++) {
+		const Tree &tree = trees[t];
+		if (tree.root == -1) {
+			continue;
+		}
+
+		int32_t stack[STACK_MAX];
+		int sp = 0;
+		stack[sp++] = tree.root;
+
+		while (sp) {
+			const Node &n = tree.nodes[stack[--sp]];
+
+			if (!(n.type_mask & p_mask) || !p_query.test(n.is_leaf() ? elements[n.element].aabb : n.aabb)) {
+				continue;
+			}
+
+			if (!n.is_leaf()) {
+				ERR_FAIL_COND_V(sp + 2 > STACK_MAX, p_result_count);
+				stack[sp++] = n.children[1];
+				stack[sp++] = n.children[0];
+				continue;
+			}
+
+			if (p_result_count == p_result_max) {
+				return p_result_count;
+			}
+			p_result_array[p_result_count++] = elements[n.element].userdata;
+		}
+	}
+
+	return p_result_count;
+}
+
+template <class T>
+int DynamicBVH<T>::cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask) const {
+	if (p_convex.size() == 0) {
+		return 0;
+	}
+
+	Vector<Vector3> convex_points = Geometry::compute_convex_mesh_points(&p_convex[0], p_convex.size());
+	if (convex_points.size() == 0) {
+		return 0;
+	}
+
+	_CullConvexData cdata;
+	cdata.planes = &p_convex[0];
+	cdata.plane_count = p_convex.size();
+	cdata.points = &convex_points[0];
+	cdata.point_count = convex_points.size();
+	cdata.result_array = p_result_array;
+	cdata.result_count = 0;
+	cdata.result_max = p_result_max;
+	cdata.mask = p_mask;
+
+	for (int t = 0; t < TREE_MAX; t++) {
+		_cull_convex(trees[t], cdata);
+	}
+
+	return cdata.result_count;
+}
+
+template <class T>
+int DynamicBVH<T>::cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, uint32_t p_mask) const {
+	_AABBQuery query;
+	query.aabb = p_aabb;
+	return _cull(query, p_result_array, 0, p_result_max, p_mask);
+}
+
+template <class T>
+int DynamicBVH<T>::cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, uint32_t p_mask) const {
+	_SegmentQuery query;
+	query.from = p_from;
+	query.to = p_to;
+	return _cull(query, p_result_array, 0, p_result_max, p_mask);
+}
+
+template <class T>
+int DynamicBVH<T>::cull_point(const Vector3 &p_point, T **p_result_array, int p_result_max, uint32_t p_mask) const {
+	_PointQuery query;
+	query.point = p_point;
+	return _cull(query, p_result_array, 0, p_result_max, p_mask);
+}
+
+/* ELEMENTS */
+
+template <class T>
+DynamicBVHElementID DynamicBVH<T>::create(T *p_userdata, const AABB &p_aabb, int p_subindex, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+// check for AABB validity
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_V(p_aabb.position.x > 1e15 || p_aabb.position.x < -1e15, DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.position.y > 1e15 || p_aabb.position.y < -1e15, DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.position.z > 1e15 || p_aabb.position.z < -1e15, DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.size.x > 1e15 || p_aabb.size.x < 0.0, DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.size.y > 1e15 || p_aabb.size.y < 0.0, DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(p_aabb.size.z > 1e15 || p_aabb.size.z < 0.0, DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(Math::is_nan(p_aabb.size.x), DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(Math::is_nan(p_aabb.size.y), DYNAMIC_BVH_ELEMENT_INVALID_ID);
+	ERR_FAIL_COND_V(Math::is_nan(p_aabb.size.z), DYNAMIC_BVH_ELEMENT_INVALID_ID);
+#endif
+
+	uint32_t idx;
+	if (free_elements.size()) {
+		idx = free_elements[free_elements.size() - 1];
+		free_elements.resize(free_elements.size() - 1);
+	} else {
+		idx = elements.size();
+		elements.resize(idx + 1);
+	}
+
+	Element &e = elements[idx];
+	e.userdata = p_userdata;
+	e.aabb = p_aabb;
+	e.subindex = p_subindex;
+	e.pairable = p_pairable;
+	e.pairable_type = p_pairable_type;
+	e.pairable_mask = p_pairable_mask;
+	e.node = -1;
+	e.in_use = true;
+
+	_tree_insert(idx);
+	_update_pairs(idx);
+
+	return idx + 1;
+}
+
+template <class T>
+void DynamicBVH<T>::move(DynamicBVHElementID p_id, const AABB &p_aabb) {
+	ERR_FAIL_COND(p_id == DYNAMIC_BVH_ELEMENT_INVALID_ID || p_id > elements.size() || !elements[p_id - 1].in_use);
+	uint32_t idx = p_id - 1;
+
+#ifdef DEBUG_ENABLED
+	// check for AABB validity
+	ERR_FAIL_COND(p_aabb.position.x > 1e15 || p_aabb.position.x < -1e15);
+	ERR_FAIL_COND(p_aabb.position.y > 1e15 || p_aabb.position.y < -1e15);
+	ERR_FAIL_COND(p_aabb.position.z > 1e15 || p_aabb.position.z < -1e15);
+	ERR_FAIL_COND(p_aabb.size.x > 1e15 || p_aabb.size.x < 0.0);
+	ERR_FAIL_COND(p_aabb.size.y > 1e15 || p_aabb.size.y < 0.0);
+	ERR_FAIL_COND(p_aabb.size.z > 1e15 || p_aabb.size.z < 0.0);
+	ERR_FAIL_COND(Math::is_nan(p_aabb.size.x));
+	ERR_FAIL_COND(Math::is_nan(p_aabb.size.y));
+	ERR_FAIL_COND(Math::is_nan(p_aabb.size.z));
+#endif
+
+	Element &e = elements[idx];
+	e.aabb = p_aabb;
+
+	if (e.node != -1 && !p_aabb.has_no_surface()) {
+		Tree &tree = trees[e.pairable ? TREE_PAIRABLE : TREE_NON_PAIRABLE];
+		if (!tree.nodes[e.node].aabb.encloses(p_aabb)) {
+			// left its enlarged box, reinsert
+			_remove_leaf(tree, e.node);
+			tree.nodes[e.node].aabb = _enlarge(p_aabb);
+			_insert_leaf(tree, e.node);
+		}
+	} else {
+		_tree_remove(idx);
+		_tree_insert(idx);
+	}
+
+	_update_pairs(idx);
+}
+
+template <class T>
+void DynamicBVH<T>::set_pairable(DynamicBVHElementID p_id, bool p_pairable, uint32_t p_pairable_type, uint32_t p_pairable_mask) {
+	ERR_FAIL_COND(p_id == DYNAMIC_BVH_ELEMENT_INVALID_ID || p_id > elements.size() || !elements[p_id - 1].in_use);
+	uint32_t idx = p_id - 1;
+
+	Element &e = elements[idx];
+	if (p_pairable == e.pairable && e.pairable_type == p_pairable_type && e.pairable_mask == p_pairable_mask) {
+		return; // no changes, return
+	}
+
+	_unpair_all(idx);
+	_tree_remove(idx);
+
+	e.pairable = p_pairable;
+	e.pairable_type = p_pairable_type;
+	e.pairable_mask = p_pairable_mask;
+
+	_tree_insert(idx);
+	_update_pairs(idx);
+}
+
+template <class T>
+void DynamicBVH<T>::erase(DynamicBVHElementID p_id) {
+	ERR_FAIL_COND(p_id == DYNAMIC_BVH_ELEMENT_INVALID_ID || p_id > elements.size() || !elements[p_id - 1].in_use);
+	uint32_t idx = p_id - 1;
+
+	_unpair_all(idx);
+	_tree_remove(idx);
+
+	Element &e = elements[idx];
+	e.userdata = nullptr;
+	e.in_use = false;
+	free_elements.push_back(idx);
+}
+
+template <class T>
+bool DynamicBVH<T>::is_pairable(DynamicBVHElementID p_id) const {
+	ERR_FAIL_COND_V(p_id == DYNAMIC_BVH_ELEMENT_INVALID_ID || p_id > elements.size() || !elements[p_id - 1].in_use, false);
+	return elements[p_id - 1].pairable;
+}
+
+template <class T>
+T *DynamicBVH<T>::get(DynamicBVHElementID p_id) const {
+	ERR_FAIL_COND_V(p_id == DYNAMIC_BVH_ELEMENT_INVALID_ID || p_id > elements.size() || !elements[p_id - 1].in_use, nullptr);
+	return elements[p_id - 1].userdata;
+}
+
+template <class T>
+int DynamicBVH<T>::get_subindex(DynamicBVHElementID p_id) const {
+	ERR_FAIL_COND_V(p_id == DYNAMIC_BVH_ELEMENT_INVALID_ID || p_id > elements.size() || !elements[p_id - 1].in_use, -1);
+	return elements[p_id - 1].subindex;
+}
+
+template <class T>
+void DynamicBVH<T>::set_pair_callback(PairCallback p_callback, void *p_userdata) {
+	pair_callback = p_callback;
+	pair_callback_userdata = p_userdata;
+}
+
+template <class T>
+void DynamicBVH<T>::set_unpair_callback(UnpairCallback p_callback, void *p_userdata) {
+	unpair_callback = p_callback;
+	unpair_callback_userdata = p_userdata;
+}
+
+#endif // DYNAMIC_BVH_H
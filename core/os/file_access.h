@@ -111,6 +111,9 @@ public:
 	virtual real_t get_real() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const; ///< get an array of bytes
+
+	virtual const uint8_t *map_read_only(size_t &r_size) { return nullptr; } ///< map the whole file in memory for reading, valid until the file is closed. null if unsupported
+	virtual void advise_will_need(size_t p_offset, size_t p_size) {} ///< hint that a range of the mapped file will be read soon
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -32,6 +32,7 @@
 
 #include "core/bind/core_bind.h"
 #include "core/core_string_names.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_network.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
@@ -1168,6 +1169,9 @@ ProjectSettings::ProjectSettings() {
 
 	Compression::gzip_level = GLOBAL_DEF("compression/formats/gzip/compression_level", Z_DEFAULT_COMPRESSION);
 	custom_prop_info["compression/formats/gzip/compression_level"] = PropertyInfo(Variant::INT, "compression/formats/gzip/compression_level", PROPERTY_HINT_RANGE, "-1,9,1");
+
+	FileAccessCompressed::default_block_size = GLOBAL_DEF("compression/formats/block_size", 65536);
+	custom_prop_info["compression/formats/block_size"] = PropertyInfo(Variant::INT, "compression/formats/block_size", PROPERTY_HINT_RANGE, "4096,4194304,1");
 }
 
 ProjectSettings::~ProjectSettings() {
@@ -0,0 +1,101 @@
+/*************************************************************************/
+/*  radix_sort.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "core/os/copymem.h"
+#include "core/typedefs.h"
+
+/**
+ * Stable LSD radix sort over 64-bit keys, one byte per pass.
+ * T must provide a `uint64_t key` member. Passes where every key shares
+ * the same digit are skipped, so narrow keys only pay for the bytes they use.
+ */
+
+template <class T>
+class RadixSort {
+public:
+	// Sorts p_array, using p_temp (same size) as scratch. Returns the buffer holding the result, either p_array or p_temp.
+	T *sort(T *p_array, T *p_temp, uint32_t p_size) const {
+		if (p_size < 2) {
+			return p_array;
+		}
+
+		uint32_t histograms[8][256];
+		zeromem(histograms, sizeof(histograms));
+
+		for (uint32_t i = 0; i < p_size; i++) {
+			uint64_t key = p_array[i].key;
+			for (uint32_t j = 0; j < 8; j++) {
+				histograms[j][(key >> (j * 8)) & 0xFF]++;
+			}
+		}
+
+		T *src = p_array;
+		T *dst = p_temp;
+
+		for (uint32_t j = 0; j < 8; j++) {
+			uint32_t shift = j * 8;
+			uint32_t *histogram = histograms[j];
+
+			if (histogram[(src[0].key >> shift) & 0xFF] == p_size) {
+				continue; // all keys share this digit
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t k = 0; k < 256; k++) {
+				uint32_t count = histogram[k];
+				histogram[k] = offset;
+				offset += count;
+			}
+
+			for (uint32_t i = 0; i < p_size; i++) {
+				dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+			}
+
+			SWAP(src, dst);
+		}
+
+		return src;
+	}
+
+	// Maps a float to an unsigned key with the same ordering.
+	static _FORCE_INLINE_ uint32_t float_to_key(float p_value) {
+		union {
+			float f;
+			uint32_t u;
+		} v;
+		v.f = p_value;
+		return (v.u & 0x80000000) ? ~v.u : (v.u | 0x80000000);
+	}
+};
+
+#endif // RADIX_SORT_H
@@ -42,6 +42,7 @@
 #include "core/input/input_map.h"
 #include "core/io/config_file.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/marshalls.h"
@@ -302,6 +303,7 @@ void unregister_core_types() {
 	}
 
 	ResourceLoader::finalize();
+	FileAccessCompressed::finalize();
 
 	ClassDB::cleanup_defaults();
 	ObjectDB::cleanup();
@@ -41,6 +41,7 @@
 #include <errno.h>
 
 #if defined(UNIX_ENABLED)
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -71,6 +72,13 @@ void FileAccessUnix::check_errors() const {
 }
 
 Error FileAccessUnix::_open(const String &p_path, int p_mode_flags) {
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+#endif
 	if (f) {
 		fclose(f);
 	}
@@ -153,6 +161,14 @@ void FileAccessUnix::close() {
 		return;
 	}
 
+#if defined(UNIX_ENABLED)
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+#endif
+
 	fclose(f);
 	f = nullptr;
 
@@ -246,6 +262,44 @@ int FileAccessUnix::get_buffer(uint8_t *p_dst, int p_length) const {
 	return read;
 };
 
+const uint8_t *FileAccessUnix::map_read_only(size_t &r_size) {
+	ERR_FAIL_COND_V_MSG(!f, nullptr, "File must be opened before use.");
+
+#if defined(UNIX_ENABLED)
+	if (!mapped) {
+		size_t len = get_len();
+		if (len == 0) {
+			return nullptr;
+		}
+
+		void *ptr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+		if (ptr == MAP_FAILED) {
+			return nullptr; // Not fatal, callers fall back to regular reads.
+		}
+
+		mapped = (uint8_t *)ptr;
+		mapped_size = len;
+	}
+
+	r_size = mapped_size;
+	return mapped;
+#else
+	return nullptr;
+#endif
+}
+
+void FileAccessUnix::advise_will_need(size_t p_offset, size_t p_size) {
+#if defined(UNIX_ENABLED)
+	ERR_FAIL_COND(!mapped);
+	ERR_FAIL_COND(p_offset + p_size > mapped_size);
+
+	// Range must start at a page boundary.
+	size_t page_size = sysconf(_SC_PAGESIZE);
+	size_t begin = p_offset - (p_offset % page_size);
+	madvise(mapped + begin, p_size + (p_offset - begin), MADV_WILLNEED);
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
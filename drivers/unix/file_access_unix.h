@@ -49,6 +49,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	uint8_t *mapped = nullptr;
+	size_t mapped_size = 0;
+
 	static FileAccess *create_libc();
 
 public:
@@ -71,6 +74,9 @@ public:
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
 
+	virtual const uint8_t *map_read_only(size_t &r_size);
+	virtual void advise_will_need(size_t p_offset, size_t p_size);
+
 	virtual Error get_error() const; ///< get last error
 
 	virtual void flush();
@@ -31,6 +31,7 @@
 #include "rendering_device_vulkan.h"
 
 #include "core/hashfuncs.h"
+#include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
@@ -5228,7 +5229,7 @@ RID RenderingDeviceVulkan::render_pipeline_create(RID p_shader, FramebufferForma
 	graphics_pipeline_create_info.basePipelineIndex = 0;
 
 	RenderPipeline pipeline;
-	VkResult err = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &graphics_pipeline_create_info, nullptr, &pipeline.pipeline);
+	VkResult err = vkCreateGraphicsPipelines(device, pipeline_cache, 1, &graphics_pipeline_create_info, nullptr, &pipeline.pipeline);
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateGraphicsPipelines failed with error " + itos(err) + ".");
 
 	pipeline.set_formats = shader->set_formats;
@@ -5301,7 +5302,7 @@ RID RenderingDeviceVulkan::compute_pipeline_create(RID p_shader) {
 	compute_pipeline_create_info.basePipelineIndex = 0;
 
 	ComputePipeline pipeline;
-	VkResult err = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &compute_pipeline_create_info, nullptr, &pipeline.pipeline);
+	VkResult err = vkCreateComputePipelines(device, pipeline_cache, 1, &compute_pipeline_create_info, nullptr, &pipeline.pipeline);
 	ERR_FAIL_COND_V_MSG(err, RID(), "vkCreateComputePipelines failed with error " + itos(err) + ".");
 
 	pipeline.set_formats = shader->set_formats;
@@ -5668,6 +5669,9 @@ RenderingDevice::DrawListID RenderingDeviceVulkan::draw_list_begin(RID p_framebu
 Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p_splits, DrawListID *r_split_ids, InitialAction p_initial_color_action, FinalAction p_final_color_action, InitialAction p_initial_depth_action, FinalAction p_final_depth_action, const Vector<Color> &p_clear_color_values, float p_clear_depth, uint32_t p_clear_stencil, const Rect2 &p_region) {
 	_THREAD_SAFE_METHOD_
 
+	ERR_FAIL_COND_V_MSG(draw_list != nullptr, ERR_BUSY, "Only one draw list can be active at the same time.");
+	ERR_FAIL_COND_V_MSG(compute_list != nullptr, ERR_BUSY, "Only one draw/compute list can be active at the same time.");
+
 	ERR_FAIL_COND_V(p_splits < 1, ERR_INVALID_DECLARATION);
 
 	Framebuffer *framebuffer = framebuffer_owner.getornull(p_framebuffer);
@@ -5721,23 +5725,32 @@ Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p
 			VkResult res = vkCreateCommandPool(device, &cmd_pool_info, nullptr, &split_draw_list_allocators.write[i].command_pool);
 			ERR_FAIL_COND_V_MSG(res, ERR_CANT_CREATE, "vkCreateCommandPool failed with error " + itos(res) + ".");
 
-			for (int j = 0; j < frame_count; j++) {
-				VkCommandBuffer command_buffer;
+			split_draw_list_allocators.write[i].frames.resize(frame_count);
+		}
+	}
 
-				VkCommandBufferAllocateInfo cmdbuf;
-				//no command buffer exists, create it.
-				cmdbuf.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-				cmdbuf.pNext = nullptr;
-				cmdbuf.commandPool = split_draw_list_allocators[i].command_pool;
-				cmdbuf.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
-				cmdbuf.commandBufferCount = 1;
+	// Secondary command buffers can't be reset until the frame that executed them is done,
+	// so each split draw list begun in a frame takes a buffer of its own.
+	VkCommandBuffer *split_command_buffers = (VkCommandBuffer *)alloca(sizeof(VkCommandBuffer) * p_splits);
+	for (uint32_t i = 0; i < p_splits; i++) {
+		SplitDrawListAllocator::FrameCommandBuffers &fcb = split_draw_list_allocators.write[i].frames.write[frame];
+		if (fcb.used == (uint32_t)fcb.command_buffers.size()) {
+			VkCommandBuffer command_buffer;
 
-				VkResult err = vkAllocateCommandBuffers(device, &cmdbuf, &command_buffer);
-				ERR_FAIL_COND_V_MSG(err, ERR_CANT_CREATE, "vkAllocateCommandBuffers failed with error " + itos(err) + ".");
+			VkCommandBufferAllocateInfo cmdbuf;
+			//no command buffer exists, create it.
+			cmdbuf.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+			cmdbuf.pNext = nullptr;
+			cmdbuf.commandPool = split_draw_list_allocators[i].command_pool;
+			cmdbuf.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			cmdbuf.commandBufferCount = 1;
 
-				split_draw_list_allocators.write[i].command_buffers.push_back(command_buffer);
-			}
+			VkResult err = vkAllocateCommandBuffers(device, &cmdbuf, &command_buffer);
+			ERR_FAIL_COND_V_MSG(err, ERR_CANT_CREATE, "vkAllocateCommandBuffers failed with error " + itos(err) + ".");
+
+			fcb.command_buffers.push_back(command_buffer);
 		}
+		split_command_buffers[i] = fcb.command_buffers[fcb.used++];
 	}
 
 	VkFramebuffer vkframebuffer;
@@ -5759,7 +5772,7 @@ Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p
 
 	for (uint32_t i = 0; i < p_splits; i++) {
 		//take a command buffer and initialize it
-		VkCommandBuffer command_buffer = split_draw_list_allocators[p_splits].command_buffers[frame];
+		VkCommandBuffer command_buffer = split_command_buffers[i];
 
 		VkCommandBufferInheritanceInfo inheritance_info;
 		inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
@@ -5817,7 +5830,7 @@ Error RenderingDeviceVulkan::draw_list_begin_split(RID p_framebuffer, uint32_t p
 		scissor.extent.height = viewport_size.height;
 
 		vkCmdSetScissor(command_buffer, 0, 1, &scissor);
-		r_split_ids[i] = (DrawListID(1) << DrawListID(ID_TYPE_SPLIT_DRAW_LIST)) + i;
+		r_split_ids[i] = (DrawListID(ID_TYPE_SPLIT_DRAW_LIST) << DrawListID(ID_BASE_SHIFT)) + i;
 
 		draw_list[i].viewport = Rect2i(viewport_offset, viewport_size);
 	}
@@ -6199,8 +6212,8 @@ void RenderingDeviceVulkan::draw_list_end() {
 		//send all command buffers
 		VkCommandBuffer *command_buffers = (VkCommandBuffer *)alloca(sizeof(VkCommandBuffer) * draw_list_count);
 		for (uint32_t i = 0; i < draw_list_count; i++) {
-			vkEndCommandBuffer(draw_list->command_buffer);
-			command_buffers[i] = draw_list->command_buffer;
+			vkEndCommandBuffer(draw_list[i].command_buffer);
+			command_buffers[i] = draw_list[i].command_buffer;
 		}
 
 		vkCmdExecuteCommands(frames[frame].draw_command_buffer, draw_list_count, command_buffers);
@@ -6686,6 +6699,11 @@ void RenderingDeviceVulkan::_begin_frame() {
 	//erase pending resources
 	_free_pending_resources(frame);
 
+	//split draw list command buffers of this frame are no longer in use
+	for (int i = 0; i < split_draw_list_allocators.size(); i++) {
+		split_draw_list_allocators.write[i].frames.write[frame].used = 0;
+	}
+
 	//create setup command buffer and set as the setup buffer
 
 	{
@@ -6882,6 +6900,11 @@ uint64_t RenderingDeviceVulkan::get_memory_usage() const {
 	return stats.total.usedBytes;
 }
 
+String RenderingDeviceVulkan::get_device_identifier() const {
+	const VkPhysicalDeviceProperties &props = context->get_device_properties();
+	return String::num_uint64(props.vendorID, 16) + ":" + String::num_uint64(props.deviceID, 16) + ":" + String::num_uint64(props.driverVersion, 16) + ":" + String::hex_encode_buffer(props.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
 void RenderingDeviceVulkan::_flush(bool p_current_frame) {
 	if (local_device.is_valid() && !p_current_frame) {
 		return; //flushign previous frames has no effect with local device
@@ -7071,6 +7094,93 @@ void RenderingDeviceVulkan::initialize(VulkanContext *p_context, bool p_local_de
 	draw_list_split = false;
 
 	compute_list = nullptr;
+
+	pipeline_cache = VK_NULL_HANDLE;
+	if (!p_local_device && GLOBAL_DEF("rendering/vulkan/shader_cache/enabled", true)) {
+		pipeline_cache_path = OS::get_singleton()->get_user_data_dir().plus_file("shader_cache").plus_file("vulkan_pipelines.cache");
+		_load_pipeline_cache();
+	}
+}
+
+#define PIPELINE_CACHE_MAGIC 0x43505047 //GPPC
+
+void RenderingDeviceVulkan::_load_pipeline_cache() {
+	const VkPhysicalDeviceProperties &props = context->get_device_properties();
+
+	Vector<uint8_t> data;
+	FileAccess *f = FileAccess::open(pipeline_cache_path, FileAccess::READ);
+	if (f) {
+		PipelineCacheHeader header;
+		if (f->get_buffer((uint8_t *)&header, sizeof(PipelineCacheHeader)) == sizeof(PipelineCacheHeader) &&
+				header.magic == PIPELINE_CACHE_MAGIC &&
+				header.vendor_id == props.vendorID &&
+				header.device_id == props.deviceID &&
+				header.driver_version == props.driverVersion &&
+				memcmp(header.uuid, props.pipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+				f->get_len() == sizeof(PipelineCacheHeader) + header.data_size) {
+			data.resize(header.data_size);
+			if (f->get_buffer(data.ptrw(), header.data_size) != int(header.data_size)) {
+				data.clear();
+			}
+		}
+		memdelete(f);
+	}
+
+	VkPipelineCacheCreateInfo cache_create_info;
+	cache_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	cache_create_info.pNext = nullptr;
+	cache_create_info.flags = 0;
+	cache_create_info.initialDataSize = data.size();
+	cache_create_info.pInitialData = data.ptr();
+
+	VkResult err = vkCreatePipelineCache(device, &cache_create_info, nullptr, &pipeline_cache);
+	if (err && data.size()) {
+		//driver refused the saved data, start from scratch
+		cache_create_info.initialDataSize = 0;
+		cache_create_info.pInitialData = nullptr;
+		err = vkCreatePipelineCache(device, &cache_create_info, nullptr, &pipeline_cache);
+	}
+
+	if (err) {
+		pipeline_cache = VK_NULL_HANDLE;
+		ERR_FAIL_MSG("vkCreatePipelineCache failed with error " + itos(err) + ".");
+	}
+}
+
+void RenderingDeviceVulkan::_save_pipeline_cache() {
+	size_t data_size = 0;
+	VkResult err = vkGetPipelineCacheData(device, pipeline_cache, &data_size, nullptr);
+	ERR_FAIL_COND_MSG(err, "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+	if (data_size == 0) {
+		return;
+	}
+
+	Vector<uint8_t> data;
+	data.resize(data_size);
+	err = vkGetPipelineCacheData(device, pipeline_cache, &data_size, data.ptrw());
+	ERR_FAIL_COND_MSG(err, "vkGetPipelineCacheData failed with error " + itos(err) + ".");
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	Error dir_err = da->make_dir_recursive(pipeline_cache_path.get_base_dir());
+	memdelete(da);
+	ERR_FAIL_COND(dir_err != OK);
+
+	FileAccess *f = FileAccess::open(pipeline_cache_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't write pipeline cache file: " + pipeline_cache_path + ".");
+
+	const VkPhysicalDeviceProperties &props = context->get_device_properties();
+
+	PipelineCacheHeader header;
+	header.magic = PIPELINE_CACHE_MAGIC;
+	header.data_size = data_size;
+	header.vendor_id = props.vendorID;
+	header.device_id = props.deviceID;
+	header.driver_version = props.driverVersion;
+	copymem(header.uuid, props.pipelineCacheUUID, VK_UUID_SIZE);
+
+	f->store_buffer((const uint8_t *)&header, sizeof(PipelineCacheHeader));
+	f->store_buffer(data.ptr(), data_size);
+	memdelete(f);
 }
 
 template <class T>
@@ -7325,6 +7435,12 @@ void RenderingDeviceVulkan::finalize() {
 
 	memdelete_arr(frames);
 
+	if (pipeline_cache != VK_NULL_HANDLE) {
+		_save_pipeline_cache();
+		vkDestroyPipelineCache(device, pipeline_cache, nullptr);
+		pipeline_cache = VK_NULL_HANDLE;
+	}
+
 	for (int i = 0; i < staging_buffer_blocks.size(); i++) {
 		vmaDestroyBuffer(allocator, staging_buffer_blocks[i].buffer, staging_buffer_blocks[i].allocation);
 	}
@@ -689,6 +689,27 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	RID_Owner<ComputePipeline, true> compute_pipeline_owner;
 
+	// Pipelines are created through a driver side
+	// cache which is saved to disk on exit, so the
+	// next run does not need to compile them again.
+	// The header guards against loading data from a
+	// different device or driver.
+
+	struct PipelineCacheHeader {
+		uint32_t magic;
+		uint32_t data_size;
+		uint32_t vendor_id;
+		uint32_t device_id;
+		uint32_t driver_version;
+		uint8_t uuid[VK_UUID_SIZE];
+	};
+
+	VkPipelineCache pipeline_cache = VK_NULL_HANDLE;
+	String pipeline_cache_path;
+
+	void _load_pipeline_cache();
+	void _save_pipeline_cache();
+
 	/*******************/
 	/**** DRAW LIST ****/
 	/*******************/
@@ -706,7 +727,11 @@ class RenderingDeviceVulkan : public RenderingDevice {
 
 	struct SplitDrawListAllocator {
 		VkCommandPool command_pool;
-		Vector<VkCommandBuffer> command_buffers; //one for each frame
+		struct FrameCommandBuffers {
+			Vector<VkCommandBuffer> command_buffers; //grows when a frame begins several split draw lists
+			uint32_t used = 0;
+		};
+		Vector<FrameCommandBuffers> frames; //one for each frame
 	};
 
 	Vector<SplitDrawListAllocator> split_draw_list_allocators;
@@ -1131,6 +1156,8 @@ public:
 
 	virtual uint64_t get_memory_usage() const;
 
+	virtual String get_device_identifier() const;
+
 	RenderingDeviceVulkan();
 	~RenderingDeviceVulkan();
 };
@@ -1476,6 +1476,10 @@ VkPhysicalDeviceLimits VulkanContext::get_device_limits() const {
 	return gpu_props.limits;
 }
 
+const VkPhysicalDeviceProperties &VulkanContext::get_device_properties() const {
+	return gpu_props;
+}
+
 VulkanContext::VulkanContext() {
 	queue_props = nullptr;
 	command_buffer_count = 0;
@@ -210,6 +210,7 @@ public:
 
 	VkFormat get_screen_format() const;
 	VkPhysicalDeviceLimits get_device_limits() const;
+	const VkPhysicalDeviceProperties &get_device_properties() const;
 
 	void set_setup_buffer(const VkCommandBuffer &pCommandBuffer);
 	void append_command_buffer(const VkCommandBuffer &pCommandBuffer);
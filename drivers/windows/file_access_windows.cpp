@@ -39,6 +39,7 @@
 #include <windows.h>
 
 #include <errno.h>
+#include <io.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <tchar.h>
@@ -133,6 +134,15 @@ void FileAccessWindows::close() {
 	if (!f)
 		return;
 
+	if (mapped) {
+		UnmapViewOfFile(mapped);
+		mapped = nullptr;
+	}
+	if (mapping) {
+		CloseHandle((HANDLE)mapping);
+		mapping = nullptr;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -259,6 +269,33 @@ int FileAccessWindows::get_buffer(uint8_t *p_dst, int p_length) const {
 	return read;
 };
 
+const uint8_t *FileAccessWindows::map_read_only(size_t &r_size) {
+	ERR_FAIL_COND_V(!f, nullptr);
+
+	if (!mapped) {
+		size_t len = get_len();
+		if (len == 0) {
+			return nullptr;
+		}
+
+		HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(f));
+		HANDLE map_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!map_handle) {
+			return nullptr; // Not fatal, callers fall back to regular reads.
+		}
+
+		mapped = (uint8_t *)MapViewOfFile(map_handle, FILE_MAP_READ, 0, 0, 0);
+		if (!mapped) {
+			CloseHandle(map_handle);
+			return nullptr;
+		}
+		mapping = map_handle;
+	}
+
+	r_size = get_len();
+	return mapped;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
@@ -48,6 +48,9 @@ class FileAccessWindows : public FileAccess {
 	String path_src;
 	String save_path;
 
+	void *mapping = nullptr;
+	uint8_t *mapped = nullptr;
+
 public:
 	virtual Error _open(const String &p_path, int p_mode_flags); ///< open a file
 	virtual void close(); ///< close a file
@@ -66,6 +69,8 @@ public:
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
 
+	virtual const uint8_t *map_read_only(size_t &r_size);
+
 	virtual Error get_error() const; ///< get last error
 
 	virtual void flush();
@@ -30,6 +30,7 @@
 
 #include "editor_file_system.h"
 
+#include "core/io/marshalls.h"
 #include "core/io/resource_importer.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -37,13 +38,68 @@
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "core/variant_parser.h"
+#include "core/version.h"
+#include "core/version_hash.gen.h"
 #include "editor_node.h"
 #include "editor_resource_preview.h"
 #include "editor_settings.h"
 
 EditorFileSystem *EditorFileSystem::singleton = nullptr;
 //the name is the version, to keep compatibility with different versions of Godot
-#define CACHE_FILE_NAME "filesystem_cache6"
+#define CACHE_FILE_NAME "filesystem_cache7"
+#define CACHE_FILE_MAGIC "GDFC"
+#define CACHE_FILE_VERSION 1
+
+// Reads the binary filesystem cache straight from memory, stopping at the first read past the end.
+struct FileSystemCacheReader {
+	const uint8_t *ptr = nullptr;
+	const uint8_t *end = nullptr;
+	bool error = false;
+
+	bool has_data() const {
+		return !error && ptr < end;
+	}
+
+	uint8_t get_8() {
+		if (end - ptr < 1) {
+			error = true;
+			return 0;
+		}
+		return *(ptr++);
+	}
+
+	uint32_t get_32() {
+		if (end - ptr < 4) {
+			error = true;
+			return 0;
+		}
+		uint32_t v = decode_uint32(ptr);
+		ptr += 4;
+		return v;
+	}
+
+	uint64_t get_64() {
+		if (end - ptr < 8) {
+			error = true;
+			return 0;
+		}
+		uint64_t v = decode_uint64(ptr);
+		ptr += 8;
+		return v;
+	}
+
+	String get_string() {
+		uint32_t len = get_32();
+		if (error || uint32_t(end - ptr) < len) {
+			error = true;
+			return String();
+		}
+		String str;
+		str.parse_utf8((const char *)ptr, len);
+		ptr += len;
+		return str;
+	}
+};
 
 void EditorFileSystemDirectory::sort_files() {
 	files.sort_custom<FileInfoSort>();
@@ -181,81 +237,66 @@ void EditorFileSystem::_scan_filesystem() {
 	ERR_FAIL_COND(!scanning || new_filesystem);
 
 	//read .fscache
-	String cpath;
-
 	sources_changed.clear();
 	file_cache.clear();
 
 	String project = ProjectSettings::get_singleton()->get_resource_path();
 
 	String fscache = EditorSettings::get_singleton()->get_project_settings_dir().plus_file(CACHE_FILE_NAME);
-	FileAccess *f = FileAccess::open(fscache, FileAccess::READ);
-
-	bool first = true;
-	if (f) {
-		//read the disk cache
-		while (!f->eof_reached()) {
-			String l = f->get_line().strip_edges();
-			if (first) {
-				if (first_scan) {
-					// only use this on first scan, afterwards it gets ignored
-					// this is so on first reimport we synchronize versions, then
-					// we don't care until editor restart. This is for usability mainly so
-					// your workflow is not killed after changing a setting by forceful reimporting
-					// everything there is.
-					filesystem_settings_version_for_import = l.strip_edges();
-					if (filesystem_settings_version_for_import != ResourceFormatImporter::get_singleton()->get_import_settings_hash()) {
-						revalidate_import_files = true;
-					}
-				}
-				first = false;
-				continue;
-			}
-			if (l == String()) {
-				continue;
+	Error err;
+	Vector<uint8_t> cache_data = FileAccess::get_file_as_array(fscache, &err);
+
+	if (cache_data.size() >= 8 && memcmp(cache_data.ptr(), CACHE_FILE_MAGIC, 4) == 0 && decode_uint32(cache_data.ptr() + 4) == CACHE_FILE_VERSION) {
+		//read the disk cache, straight from memory
+		FileSystemCacheReader r;
+		r.ptr = cache_data.ptr() + 8;
+		r.end = cache_data.ptr() + cache_data.size();
+
+		String settings_version = r.get_string();
+		if (first_scan) {
+			// only use this on first scan, afterwards it gets ignored
+			// this is so on first reimport we synchronize versions, then
+			// we don't care until editor restart. This is for usability mainly so
+			// your workflow is not killed after changing a setting by forceful reimporting
+			// everything there is.
+			filesystem_settings_version_for_import = settings_version;
+			if (filesystem_settings_version_for_import != ResourceFormatImporter::get_singleton()->get_import_settings_hash()) {
+				revalidate_import_files = true;
 			}
+		}
 
-			if (l.begins_with("::")) {
-				Vector<String> split = l.split("::");
-				ERR_CONTINUE(split.size() != 3);
-				String name = split[1];
-
-				cpath = name;
-
-			} else {
-				Vector<String> split = l.split("::");
-				ERR_CONTINUE(split.size() != 8);
-				String name = split[0];
-				String file;
+		while (r.has_data()) {
+			String cpath = r.get_string();
+			r.get_64(); // Directory modification time, unused.
+			uint32_t file_count = r.get_32();
 
-				file = name;
-				name = cpath.plus_file(name);
+			for (uint32_t i = 0; i < file_count && !r.error; i++) {
+				String name = cpath.plus_file(r.get_string());
 
 				FileCache fc;
-				fc.type = split[1];
-				fc.modification_time = split[2].to_int64();
-				fc.import_modification_time = split[3].to_int64();
-				fc.import_valid = split[4].to_int64() != 0;
-				fc.import_group_file = split[5].strip_edges();
-				fc.script_class_name = split[6].get_slice("<>", 0);
-				fc.script_class_extends = split[6].get_slice("<>", 1);
-				fc.script_class_icon_path = split[6].get_slice("<>", 2);
-
-				String deps = split[7].strip_edges();
-				if (deps.length()) {
-					Vector<String> dp = deps.split("<>");
-					for (int i = 0; i < dp.size(); i++) {
-						String path = dp[i];
-						fc.deps.push_back(path);
-					}
+				fc.type = r.get_string();
+				fc.modification_time = r.get_64();
+				fc.import_modification_time = r.get_64();
+				fc.import_valid = r.get_8() != 0;
+				fc.import_group_file = r.get_string();
+				fc.script_class_name = r.get_string();
+				fc.script_class_extends = r.get_string();
+				fc.script_class_icon_path = r.get_string();
+
+				uint32_t dep_count = r.get_32();
+				for (uint32_t j = 0; j < dep_count && !r.error; j++) {
+					fc.deps.push_back(r.get_string());
 				}
 
-				file_cache[name] = fc;
+				if (!r.error) {
+					file_cache[name] = fc;
+				}
 			}
 		}
 
-		f->close();
-		memdelete(f);
+		if (r.error) {
+			WARN_PRINT("Filesystem cache '" + fscache + "' is truncated, files past that point will be scanned again.");
+		}
 	}
 
 	String update_cache = EditorSettings::get_singleton()->get_project_settings_dir().plus_file("filesystem_update4");
@@ -308,7 +349,9 @@ void EditorFileSystem::_save_filesystem_cache() {
 	FileAccess *f = FileAccess::open(fscache, FileAccess::WRITE);
 	ERR_FAIL_COND_MSG(!f, "Cannot create file '" + fscache + "'. Check user write permissions.");
 
-	f->store_line(filesystem_settings_version_for_import);
+	f->store_buffer((const uint8_t *)CACHE_FILE_MAGIC, 4);
+	f->store_32(CACHE_FILE_VERSION);
+	f->store_pascal_string(filesystem_settings_version_for_import);
 	_save_filesystem_cache(filesystem, f);
 	f->close();
 	memdelete(f);
@@ -463,6 +506,10 @@ bool EditorFileSystem::_test_for_reimport(const String &p_path, bool p_only_impo
 	return false; //nothing changed
 }
 
+void EditorFileSystem::_test_for_reimport_work(uint32_t p_index, ReimportTest *p_tests) {
+	p_tests[p_index].reimport = _test_for_reimport(p_tests[p_index].path, false);
+}
+
 bool EditorFileSystem::_update_scan_actions() {
 	sources_changed.clear();
 
@@ -471,6 +518,24 @@ bool EditorFileSystem::_update_scan_actions() {
 	Vector<String> reimports;
 	Vector<String> reloads;
 
+	// Testing for reimport hashes the source and imported files, so do all the tests up front in parallel.
+	LocalVector<ReimportTest> reimport_tests;
+	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
+		if (E->get().action == ItemAction::ACTION_FILE_TEST_REIMPORT) {
+			ReimportTest test;
+			test.path = E->get().dir->get_path().plus_file(E->get().file);
+			reimport_tests.push_back(test);
+		}
+	}
+
+	if (reimport_tests.size() > 1) {
+		scan_pool.do_work(reimport_tests.size(), this, &EditorFileSystem::_test_for_reimport_work, reimport_tests.ptr());
+	} else if (reimport_tests.size() == 1) {
+		_test_for_reimport_work(0, reimport_tests.ptr());
+	}
+
+	uint32_t reimport_test_index = 0;
+
 	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
 		ItemAction &ia = E->get();
 
@@ -527,10 +592,11 @@ bool EditorFileSystem::_update_scan_actions() {
 
 			} break;
 			case ItemAction::ACTION_FILE_TEST_REIMPORT: {
+				bool reimport = reimport_tests[reimport_test_index++].reimport;
 				int idx = ia.dir->find_file_index(ia.file);
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
-				if (_test_for_reimport(full_path, false)) {
+				if (reimport) {
 					//must reimport
 					reimports.push_back(full_path);
 				} else {
@@ -627,7 +693,7 @@ EditorFileSystem::ScanProgress EditorFileSystem::ScanProgress::get_sub(int p_cur
 	return sp;
 }
 
-void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress) {
+void EditorFileSystem::_scan_new_dir_list(EditorFileSystemDirectory *p_dir, DirAccess *da, LocalVector<ScanFileWork> &r_work) {
 	List<String> dirs;
 	List<String> files;
 
@@ -670,10 +736,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 	dirs.sort_custom<NaturalNoCaseComparator>();
 	files.sort_custom<NaturalNoCaseComparator>();
 
-	int total = dirs.size() + files.size();
-	int idx = 0;
-
-	for (List<String>::Element *E = dirs.front(); E; E = E->next(), idx++) {
+	for (List<String>::Element *E = dirs.front(); E; E = E->next()) {
 		if (da->change_dir(E->get()) == OK) {
 			String d = da->get_current_dir();
 
@@ -685,7 +748,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 				efd->parent = p_dir;
 				efd->name = E->get();
 
-				_scan_new_dir(efd, da, p_progress.get_sub(idx, total));
+				_scan_new_dir_list(efd, da, r_work);
 
 				int idx2 = 0;
 				for (int i = 0; i < p_dir->subdirs.size(); i++) {
@@ -705,11 +768,9 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 		} else {
 			ERR_PRINT("Cannot go into subdir '" + E->get() + "'.");
 		}
-
-		p_progress.update(idx, total);
 	}
 
-	for (List<String>::Element *E = files.front(); E; E = E->next(), idx++) {
+	for (List<String>::Element *E = files.front(); E; E = E->next()) {
 		String ext = E->get().get_extension().to_lower();
 		if (!valid_extensions.has(ext)) {
 			continue; //invalid
@@ -717,20 +778,61 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 
 		EditorFileSystemDirectory::FileInfo *fi = memnew(EditorFileSystemDirectory::FileInfo);
 		fi->file = E->get();
+		p_dir->files.push_back(fi);
 
-		String path = cd.plus_file(fi->file);
+		ScanFileWork work;
+		work.dir = p_dir;
+		work.fi = fi;
+		work.path = cd.plus_file(fi->file);
+		work.imported = import_extensions.has(ext);
+		work.cache = file_cache.getptr(work.path);
+		r_work.push_back(work);
+	}
+}
 
-		FileCache *fc = file_cache.getptr(path);
-		uint64_t mt = FileAccess::get_modified_time(path);
+void EditorFileSystem::_scan_file_work(uint32_t p_index, ScanFileWork *p_work) {
+	ScanFileWork &work = p_work[p_index];
 
-		if (import_extensions.has(ext)) {
-			//is imported
-			uint64_t import_mt = 0;
-			if (FileAccess::exists(path + ".import")) {
-				import_mt = FileAccess::get_modified_time(path + ".import");
-			}
+	work.modified_time = FileAccess::get_modified_time(work.path);
+
+	if (work.imported) {
+		if (FileAccess::exists(work.path + ".import")) {
+			work.import_modified_time = FileAccess::get_modified_time(work.path + ".import");
+		}
+
+		work.cache_valid = work.cache && work.cache->modification_time == work.modified_time && work.cache->import_modification_time == work.import_modified_time && !_test_for_reimport(work.path, true);
+
+		if (work.cache_valid && revalidate_import_files) {
+			work.import_settings_valid = ResourceFormatImporter::get_singleton()->are_import_settings_valid(work.path);
+		}
+	} else {
+		work.cache_valid = work.cache && work.cache->modification_time == work.modified_time;
+	}
+}
 
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress) {
+	// Listing directories is cheap, checking every file against the cache and its
+	// import metadata is not, so the tree is listed first and the files are checked
+	// in parallel. Whatever the cache can't answer is resolved afterwards in listing
+	// order, as it may need the script languages and loaders.
+	LocalVector<ScanFileWork> work;
+	_scan_new_dir_list(p_dir, da, work);
+
+	if (work.size() > 1) {
+		scan_pool.do_work(work.size(), this, &EditorFileSystem::_scan_file_work, work.ptr());
+	} else if (work.size() == 1) {
+		_scan_file_work(0, work.ptr());
+	}
+
+	for (uint32_t i = 0; i < work.size(); i++) {
+		const ScanFileWork &w = work[i];
+		EditorFileSystemDirectory::FileInfo *fi = w.fi;
+		const FileCache *fc = w.cache;
+		const String &path = w.path;
+
+		if (w.imported) {
+			//is imported
+			if (w.cache_valid) {
 				fi->type = fc->type;
 				fi->deps = fc->deps;
 				fi->modified_time = fc->modification_time;
@@ -742,11 +844,11 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 				fi->script_class_extends = fc->script_class_extends;
 				fi->script_class_icon_path = fc->script_class_icon_path;
 
-				if (revalidate_import_files && !ResourceFormatImporter::get_singleton()->are_import_settings_valid(path)) {
+				if (!w.import_settings_valid) {
 					ItemAction ia;
 					ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-					ia.dir = p_dir;
-					ia.file = E->get();
+					ia.dir = w.dir;
+					ia.file = fi->file;
 					scan_actions.push_back(ia);
 				}
 
@@ -767,12 +869,12 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 
 				ItemAction ia;
 				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-				ia.dir = p_dir;
-				ia.file = E->get();
+				ia.dir = w.dir;
+				ia.file = fi->file;
 				scan_actions.push_back(ia);
 			}
 		} else {
-			if (fc && fc->modification_time == mt) {
+			if (w.cache_valid) {
 				//not imported, so just update type if changed
 				fi->type = fc->type;
 				fi->modified_time = fc->modification_time;
@@ -787,18 +889,17 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 				fi->type = ResourceLoader::get_resource_type(path);
 				fi->script_class_name = _get_global_script_class(fi->type, path, &fi->script_class_extends, &fi->script_class_icon_path);
 				fi->deps = _get_dependencies(path);
-				fi->modified_time = mt;
+				fi->modified_time = w.modified_time;
 				fi->import_modified_time = 0;
 				fi->import_valid = true;
 			}
 		}
 
-		p_dir->files.push_back(fi);
-		p_progress.update(idx, total);
+		p_progress.update(i, work.size());
 	}
 }
 
-void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress) {
+void EditorFileSystem::_scan_fs_changes_dir(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress, LocalVector<ChangeCheckWork> &r_checks) {
 	uint64_t current_mtime = FileAccess::get_modified_time(p_dir->get_path());
 
 	bool updated_dir = false;
@@ -932,44 +1033,18 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 
 		if (import_extensions.has(p_dir->files[i]->file.get_extension().to_lower())) {
 			//check here if file must be imported or not
-
-			uint64_t mt = FileAccess::get_modified_time(path);
-
-			bool reimport = false;
-
-			if (mt != p_dir->files[i]->modified_time) {
-				reimport = true; //it was modified, must be reimported.
-			} else if (!FileAccess::exists(path + ".import")) {
-				reimport = true; //no .import file, obviously reimport
-			} else {
-				uint64_t import_mt = FileAccess::get_modified_time(path + ".import");
-				if (import_mt != p_dir->files[i]->import_modified_time) {
-					reimport = true;
-				} else if (_test_for_reimport(path, true)) {
-					reimport = true;
-				}
-			}
-
-			if (reimport) {
-				ItemAction ia;
-				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-				ia.dir = p_dir;
-				ia.file = p_dir->files[i]->file;
-				scan_actions.push_back(ia);
-			}
+			ChangeCheckWork check;
+			check.dir = p_dir;
+			check.fi = p_dir->files[i];
+			check.path = path;
+			check.imported = true;
+			r_checks.push_back(check);
 		} else if (ResourceCache::has(path)) { //test for potential reload
-
-			uint64_t mt = FileAccess::get_modified_time(path);
-
-			if (mt != p_dir->files[i]->modified_time) {
-				p_dir->files[i]->modified_time = mt; //save new time, but test for reload
-
-				ItemAction ia;
-				ia.action = ItemAction::ACTION_FILE_RELOAD;
-				ia.dir = p_dir;
-				ia.file = p_dir->files[i]->file;
-				scan_actions.push_back(ia);
-			}
+			ChangeCheckWork check;
+			check.dir = p_dir;
+			check.fi = p_dir->files[i];
+			check.path = path;
+			r_checks.push_back(check);
 		}
 	}
 
@@ -982,7 +1057,60 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 			scan_actions.push_back(ia);
 			continue;
 		}
-		_scan_fs_changes(p_dir->get_subdir(i), p_progress);
+		_scan_fs_changes_dir(p_dir->get_subdir(i), p_progress, r_checks);
+	}
+}
+
+void EditorFileSystem::_scan_fs_changes_work(uint32_t p_index, ChangeCheckWork *p_checks) {
+	ChangeCheckWork &check = p_checks[p_index];
+
+	check.modified_time = FileAccess::get_modified_time(check.path);
+
+	if (!check.imported) {
+		check.changed = check.modified_time != check.fi->modified_time;
+	} else if (check.modified_time != check.fi->modified_time) {
+		check.changed = true; //it was modified, must be reimported.
+	} else if (!FileAccess::exists(check.path + ".import")) {
+		check.changed = true; //no .import file, obviously reimport
+	} else {
+		uint64_t import_mt = FileAccess::get_modified_time(check.path + ".import");
+		if (import_mt != check.fi->import_modified_time) {
+			check.changed = true;
+		} else if (_test_for_reimport(check.path, true)) {
+			check.changed = true;
+		}
+	}
+}
+
+void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress) {
+	// Only directories whose modification time changed are listed again, but every
+	// imported or loaded file still has to be checked, so that is done in parallel.
+	LocalVector<ChangeCheckWork> checks;
+	_scan_fs_changes_dir(p_dir, p_progress, checks);
+
+	if (checks.size() > 1) {
+		scan_pool.do_work(checks.size(), this, &EditorFileSystem::_scan_fs_changes_work, checks.ptr());
+	} else if (checks.size() == 1) {
+		_scan_fs_changes_work(0, checks.ptr());
+	}
+
+	for (uint32_t i = 0; i < checks.size(); i++) {
+		ChangeCheckWork &check = checks[i];
+		if (!check.changed) {
+			continue;
+		}
+
+		ItemAction ia;
+		ia.dir = check.dir;
+		ia.file = check.fi->file;
+
+		if (check.imported) {
+			ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
+		} else {
+			check.fi->modified_time = check.modified_time; //save new time, but test for reload
+			ia.action = ItemAction::ACTION_FILE_RELOAD;
+		}
+		scan_actions.push_back(ia);
 	}
 }
 
@@ -1150,22 +1278,28 @@ void EditorFileSystem::_save_filesystem_cache(EditorFileSystemDirectory *p_dir,
 	if (!p_dir) {
 		return; //none
 	}
-	p_file->store_line("::" + p_dir->get_path() + "::" + String::num(p_dir->modified_time));
+	p_file->store_pascal_string(p_dir->get_path());
+	p_file->store_64(p_dir->modified_time);
+	p_file->store_32(p_dir->files.size());
 
 	for (int i = 0; i < p_dir->files.size(); i++) {
-		if (p_dir->files[i]->import_group_file != String()) {
-			group_file_cache.insert(p_dir->files[i]->import_group_file);
-		}
-		String s = p_dir->files[i]->file + "::" + p_dir->files[i]->type + "::" + itos(p_dir->files[i]->modified_time) + "::" + itos(p_dir->files[i]->import_modified_time) + "::" + itos(p_dir->files[i]->import_valid) + "::" + p_dir->files[i]->import_group_file + "::" + p_dir->files[i]->script_class_name + "<>" + p_dir->files[i]->script_class_extends + "<>" + p_dir->files[i]->script_class_icon_path;
-		s += "::";
-		for (int j = 0; j < p_dir->files[i]->deps.size(); j++) {
-			if (j > 0) {
-				s += "<>";
-			}
-			s += p_dir->files[i]->deps[j];
+		const EditorFileSystemDirectory::FileInfo *fi = p_dir->files[i];
+		if (fi->import_group_file != String()) {
+			group_file_cache.insert(fi->import_group_file);
+		}
+		p_file->store_pascal_string(fi->file);
+		p_file->store_pascal_string(fi->type);
+		p_file->store_64(fi->modified_time);
+		p_file->store_64(fi->import_modified_time);
+		p_file->store_8(fi->import_valid);
+		p_file->store_pascal_string(fi->import_group_file);
+		p_file->store_pascal_string(fi->script_class_name);
+		p_file->store_pascal_string(fi->script_class_extends);
+		p_file->store_pascal_string(fi->script_class_icon_path);
+		p_file->store_32(fi->deps.size());
+		for (int j = 0; j < fi->deps.size(); j++) {
+			p_file->store_pascal_string(fi->deps[j]);
 		}
-
-		p_file->store_line(s);
 	}
 
 	for (int i = 0; i < p_dir->subdirs.size(); i++) {
@@ -1654,6 +1788,144 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	bool found = _find_file(p_file, &fs, cpos);
 	ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
 
+	ReimportResult result;
+	result.path = p_file;
+	if (_reimport_file_import(result)) {
+		_reimport_file_update(result);
+	}
+}
+
+// The key covers everything the output of a cacheable importer depends on, so the
+// same source imported with the same options in another checkout maps to the same entry.
+String EditorFileSystem::_get_import_cache_key(const String &p_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const Map<StringName, Variant> &p_params) const {
+	String key = FileAccess::get_md5(p_file);
+	if (key == String()) {
+		return String();
+	}
+
+	key += "\n" + p_importer->get_importer_name();
+	key += "\n" + itos(p_importer->get_format_version());
+	key += "\n" + p_importer->get_import_settings_string();
+	key += "\n" VERSION_FULL_BUILD;
+	key += "\n" VERSION_HASH; //importer code can change without the version string changing
+
+	for (const List<ResourceImporter::ImportOption>::Element *E = p_options.front(); E; E = E->next()) {
+		String value;
+		VariantWriter::write_to_string(p_params[E->get().option.name], value);
+		key += "\n" + E->get().option.name + "=" + value;
+	}
+
+	return key.md5_text();
+}
+
+String EditorFileSystem::_get_import_cache_entry(const String &p_key) const {
+	return import_cache_path.plus_file(p_key.substr(0, 2)).plus_file(p_key);
+}
+
+static Error _copy_import_cache_file(const String &p_from, const String &p_to) {
+	FileAccess *src = FileAccess::open(p_from, FileAccess::READ);
+	if (!src) {
+		return ERR_FILE_CANT_OPEN;
+	}
+	FileAccess *dst = FileAccess::open(p_to, FileAccess::WRITE);
+	if (!dst) {
+		memdelete(src);
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	uint8_t buf[65536];
+	while (true) {
+		int read = src->get_buffer(buf, sizeof(buf));
+		if (read <= 0) {
+			break;
+		}
+		dst->store_buffer(buf, read);
+	}
+
+	Error err = dst->get_error();
+	memdelete(src);
+	memdelete(dst);
+	return err;
+}
+
+bool EditorFileSystem::_load_from_import_cache(const String &p_key, const String &p_base_path, const String &p_extension, List<String> *r_variants, Variant *r_metadata) {
+	String entry = _get_import_cache_entry(p_key);
+
+	Ref<ConfigFile> cf;
+	cf.instance();
+	if (cf->load(entry.plus_file("import.cfg")) != OK) {
+		return false;
+	}
+
+	Vector<String> variants = cf->get_value("import", "variants", Vector<String>());
+	if (variants.empty()) {
+		if (_copy_import_cache_file(entry.plus_file("main." + p_extension), p_base_path + "." + p_extension) != OK) {
+			return false;
+		}
+	} else {
+		for (int i = 0; i < variants.size(); i++) {
+			String file = variants[i] + "." + p_extension;
+			if (_copy_import_cache_file(entry.plus_file(file), p_base_path + "." + file) != OK) {
+				return false;
+			}
+		}
+	}
+
+	for (int i = 0; i < variants.size(); i++) {
+		r_variants->push_back(variants[i]);
+	}
+	*r_metadata = cf->get_value("import", "metadata", Variant());
+	return true;
+}
+
+void EditorFileSystem::_store_in_import_cache(const String &p_key, const String &p_base_path, const String &p_extension, const List<String> &p_variants, const Variant &p_metadata) {
+	String entry = _get_import_cache_entry(p_key);
+
+	// Fill a private directory and rename it into place, so other editors sharing the
+	// cache never see a partial entry. If another one got there first, keep theirs.
+	String tmp = entry + ".tmp" + itos(OS::get_singleton()->get_process_id()) + "_" + itos(Thread::get_caller_id());
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	if (da->dir_exists(entry) || da->make_dir_recursive(tmp) != OK) {
+		memdelete(da);
+		return;
+	}
+
+	bool ok = true;
+	Vector<String> variants;
+	if (p_variants.empty()) {
+		ok = _copy_import_cache_file(p_base_path + "." + p_extension, tmp.plus_file("main." + p_extension)) == OK;
+	} else {
+		for (const List<String>::Element *E = p_variants.front(); E && ok; E = E->next()) {
+			String file = E->get() + "." + p_extension;
+			ok = _copy_import_cache_file(p_base_path + "." + file, tmp.plus_file(file)) == OK;
+			variants.push_back(E->get());
+		}
+	}
+
+	if (ok) {
+		Ref<ConfigFile> cf;
+		cf.instance();
+		cf->set_value("import", "variants", variants);
+		cf->set_value("import", "metadata", p_metadata);
+		ok = cf->save(tmp.plus_file("import.cfg")) == OK;
+	}
+
+	if (!ok || da->rename(tmp, entry) != OK) {
+		if (da->change_dir(tmp) == OK) {
+			da->erase_contents_recursive();
+		}
+		da->remove(tmp);
+	}
+
+	memdelete(da);
+}
+
+// Runs the importer and writes the .import and .md5 files. It doesn't touch the
+// filesystem tree, so it can run on import threads for importers that allow it.
+bool EditorFileSystem::_reimport_file_import(ReimportResult &r_result) {
+	const String &p_file = r_result.path;
+
 	//try to obtain existing params
 
 	Map<StringName, Variant> params;
@@ -1678,7 +1950,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		}
 
 	} else {
-		late_added_files.insert(p_file); //imported files do not call update_file(), but just in case..
+		r_result.late_added = true; //imported files do not call update_file(), but just in case..
 	}
 
 	Ref<ResourceImporter> importer;
@@ -1694,7 +1966,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		load_default = true;
 		if (importer.is_null()) {
 			ERR_PRINT("BUG: File queued for import, but can't be imported!");
-			ERR_FAIL();
+			ERR_FAIL_V(false);
 		}
 	}
 
@@ -1725,16 +1997,27 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	List<String> import_variants;
 	List<String> gen_files;
 	Variant metadata;
-	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+	Error err = OK;
 
-	if (err != OK) {
-		ERR_PRINT("Error importing '" + p_file + "'.");
+	String cache_key;
+	if (import_cache_path != String() && importer->get_save_extension() != "" && importer->can_cache_import(params)) {
+		cache_key = _get_import_cache_key(p_file, importer, opts, params);
+	}
+
+	if (cache_key == String() || !_load_from_import_cache(cache_key, base_path, importer->get_save_extension(), &import_variants, &metadata)) {
+		err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
+
+		if (err != OK) {
+			ERR_PRINT("Error importing '" + p_file + "'.");
+		} else if (cache_key != String() && gen_files.empty()) {
+			_store_in_import_cache(cache_key, base_path, importer->get_save_extension(), import_variants, metadata);
+		}
 	}
 
 	//as import is complete, save the .import file
 
 	FileAccess *f = FileAccess::open(p_file + ".import", FileAccess::WRITE);
-	ERR_FAIL_COND_MSG(!f, "Cannot open file from path '" + p_file + ".import'.");
+	ERR_FAIL_COND_V_MSG(!f, false, "Cannot open file from path '" + p_file + ".import'.");
 
 	//write manually, as order matters ([remap] has to go first for performance).
 	f->store_line("[remap]");
@@ -1815,7 +2098,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 
 	// Store the md5's of the various files. These are stored separately so that the .import files can be version controlled.
 	FileAccess *md5s = FileAccess::open(base_path + ".md5", FileAccess::WRITE);
-	ERR_FAIL_COND_MSG(!md5s, "Cannot open MD5 file '" + base_path + ".md5'.");
+	ERR_FAIL_COND_V_MSG(!md5s, false, "Cannot open MD5 file '" + base_path + ".md5'.");
 
 	md5s->store_line("source_md5=\"" + FileAccess::get_md5(p_file) + "\"");
 	if (dest_paths.size()) {
@@ -1824,6 +2107,24 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	md5s->close();
 	memdelete(md5s);
 
+	r_result.importer = importer;
+	r_result.imported = true;
+	return true;
+}
+
+void EditorFileSystem::_reimport_file_update(const ReimportResult &p_result) {
+	const String &p_file = p_result.path;
+	const Ref<ResourceImporter> &importer = p_result.importer;
+
+	EditorFileSystemDirectory *fs = nullptr;
+	int cpos = -1;
+	bool found = _find_file(p_file, &fs, cpos);
+	ERR_FAIL_COND_MSG(!found, "Can't find file '" + p_file + "'.");
+
+	if (p_result.late_added) {
+		late_added_files.insert(p_file);
+	}
+
 	//update modified times, to avoid reimport
 	fs->files[cpos]->modified_time = FileAccess::get_modified_time(p_file);
 	fs->files[cpos]->import_modified_time = FileAccess::get_modified_time(p_file + ".import");
@@ -1863,6 +2164,80 @@ void EditorFileSystem::_find_group_files(EditorFileSystemDirectory *efd, Map<Str
 	}
 }
 
+void EditorFileSystem::_reimport_thread(void *p_userdata) {
+	ImportThreadData *data = (ImportThreadData *)p_userdata;
+	uint32_t worker = data->worker_count.fetch_add(1);
+
+	while (true) {
+		uint32_t index = data->next.fetch_add(1);
+		if (index >= data->count) {
+			break;
+		}
+
+		{
+			MutexLock lock(data->mutex);
+			data->worker_files.write[worker] = data->results[index].path.get_file();
+		}
+
+		singleton->_reimport_file_import(data->results[index]);
+		data->done.fetch_add(1);
+	}
+
+	MutexLock lock(data->mutex);
+	data->worker_files.write[worker] = String();
+}
+
+void EditorFileSystem::_reimport_files_threaded(LocalVector<ReimportResult> &r_results, int p_progress_from, EditorProgress &p_progress) {
+	ImportThreadData data;
+	data.results = r_results.ptr();
+	data.count = r_results.size();
+	data.next.store(0);
+	data.done.store(0);
+	data.worker_count.store(0);
+
+	int thread_count = MIN(OS::get_singleton()->get_processor_count(), (int)r_results.size());
+	data.worker_files.resize(thread_count);
+
+	Vector<Thread *> threads;
+	for (int i = 0; i < thread_count; i++) {
+		threads.push_back(Thread::create(_reimport_thread, &data));
+	}
+
+	// Keep the progress dialog alive with what every worker is importing.
+	uint32_t done = 0;
+	while (done < data.count) {
+		String state;
+		{
+			MutexLock lock(data.mutex);
+			for (int i = 0; i < data.worker_files.size(); i++) {
+				if (data.worker_files[i] == String()) {
+					continue;
+				}
+				if (state != String()) {
+					state += ", ";
+				}
+				state += data.worker_files[i];
+			}
+		}
+
+		p_progress.step(state, p_progress_from + done, false);
+		OS::get_singleton()->delay_usec(10000);
+		done = data.done.load();
+	}
+
+	for (int i = 0; i < threads.size(); i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+
+	// Updating the filesystem tree, resource cache and previews happens back on the main thread.
+	for (uint32_t i = 0; i < r_results.size(); i++) {
+		if (r_results[i].imported) {
+			_reimport_file_update(r_results[i]);
+		}
+	}
+}
+
 void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	{ //check that .import folder exists
 		DirAccess *da = DirAccess::open("res://");
@@ -1877,6 +2252,7 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 	}
 
 	importing = true;
+	import_cache_path = EDITOR_GET("filesystem/import/shared_cache_path");
 	EditorProgress pr("reimport", TTR("(Re)Importing Assets"), p_files.size());
 
 	Vector<ImportFile> files;
@@ -1898,6 +2274,7 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 			ImportFile ifile;
 			ifile.path = p_files[i];
 			ifile.order = ResourceFormatImporter::get_singleton()->get_import_order(p_files[i]);
+			ifile.threaded = use_import_threads && ResourceFormatImporter::get_singleton()->can_import_threaded(p_files[i]);
 			files.push_back(ifile);
 		}
 
@@ -1911,9 +2288,35 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	files.sort();
 
-	for (int i = 0; i < files.size(); i++) {
-		pr.step(files[i].path.get_file(), i);
-		_reimport_file(files[i].path);
+	for (int i = 0; i < files.size();) {
+		// Files of the same import order don't depend on each other (scenes come after
+		// the textures they use), so runs of thread safe importers go in parallel.
+		int from = i;
+		i++;
+		if (files[from].threaded) {
+			while (i < files.size() && files[i].threaded && files[i].order == files[from].order) {
+				i++;
+			}
+		}
+
+		if (i - from == 1) {
+			pr.step(files[from].path.get_file(), from);
+			_reimport_file(files[from].path);
+			continue;
+		}
+
+		LocalVector<ReimportResult> results;
+		for (int j = from; j < i; j++) {
+			EditorFileSystemDirectory *fs = nullptr;
+			int cpos = -1;
+			ERR_CONTINUE_MSG(!_find_file(files[j].path, &fs, cpos), "Can't find file '" + files[j].path + "'.");
+
+			ReimportResult result;
+			result.path = files[j].path;
+			results.push_back(result);
+		}
+
+		_reimport_files_threaded(results, from, pr);
 	}
 
 	//reimport groups
@@ -2037,6 +2440,7 @@ void EditorFileSystem::_update_extensions() {
 EditorFileSystem::EditorFileSystem() {
 	ResourceLoader::import = _resource_import;
 	reimport_on_missing_imported_files = GLOBAL_DEF("editor/reimport_missing_imported_files", true);
+	use_import_threads = GLOBAL_DEF("editor/import/use_multiple_threads", true);
 
 	singleton = this;
 	filesystem = memnew(EditorFileSystemDirectory); //like, empty
@@ -2066,7 +2470,10 @@ EditorFileSystem::EditorFileSystem() {
 	first_scan = true;
 	scan_changes_pending = false;
 	revalidate_import_files = false;
+
+	scan_pool.init();
 }
 
 EditorFileSystem::~EditorFileSystem() {
+	scan_pool.finish();
 }
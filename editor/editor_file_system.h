@@ -31,13 +31,18 @@
 #ifndef EDITOR_FILE_SYSTEM_H
 #define EDITOR_FILE_SYSTEM_H
 
+#include "core/io/resource_importer.h"
+#include "core/local_vector.h"
 #include "core/os/dir_access.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/set.h"
+#include "core/thread_work_pool.h"
 #include "scene/main/node.h"
 class FileAccess;
 
+struct EditorProgress;
 struct EditorProgressBG;
 class EditorFileSystemDirectory : public Object {
 	GDCLASS(EditorFileSystemDirectory, Object);
@@ -173,6 +178,37 @@ class EditorFileSystem : public Node {
 
 	HashMap<String, FileCache> file_cache;
 
+	/* Per file checks of a directory scan, run in parallel once the tree is listed */
+	struct ScanFileWork {
+		EditorFileSystemDirectory *dir = nullptr;
+		EditorFileSystemDirectory::FileInfo *fi = nullptr;
+		String path;
+		bool imported = false;
+		const FileCache *cache = nullptr;
+
+		uint64_t modified_time = 0;
+		uint64_t import_modified_time = 0;
+		bool cache_valid = false;
+		bool import_settings_valid = true;
+	};
+
+	struct ChangeCheckWork {
+		EditorFileSystemDirectory *dir = nullptr;
+		EditorFileSystemDirectory::FileInfo *fi = nullptr;
+		String path;
+		bool imported = false;
+
+		uint64_t modified_time = 0;
+		bool changed = false;
+	};
+
+	struct ReimportTest {
+		String path;
+		bool reimport = false;
+	};
+
+	ThreadWorkPool scan_pool;
+
 	struct ScanProgress {
 		float low;
 		float hi;
@@ -187,6 +223,8 @@ class EditorFileSystem : public Node {
 	bool _find_file(const String &p_file, EditorFileSystemDirectory **r_d, int &r_file_pos) const;
 
 	void _scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress);
+	void _scan_fs_changes_dir(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress, LocalVector<ChangeCheckWork> &r_checks);
+	void _scan_fs_changes_work(uint32_t p_index, ChangeCheckWork *p_checks);
 
 	void _delete_internal_files(String p_file);
 
@@ -194,6 +232,9 @@ class EditorFileSystem : public Node {
 	Set<String> import_extensions;
 
 	void _scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress);
+	void _scan_new_dir_list(EditorFileSystemDirectory *p_dir, DirAccess *da, LocalVector<ScanFileWork> &r_work);
+	void _scan_file_work(uint32_t p_index, ScanFileWork *p_work);
+	void _test_for_reimport_work(uint32_t p_index, ReimportTest *p_tests);
 
 	Thread *thread_sources;
 	bool scanning_changes;
@@ -208,7 +249,37 @@ class EditorFileSystem : public Node {
 
 	void _update_extensions();
 
+	struct ReimportResult {
+		String path;
+		Ref<ResourceImporter> importer;
+		bool late_added = false;
+		bool imported = false;
+	};
+
+	struct ImportThreadData {
+		ReimportResult *results = nullptr;
+		uint32_t count = 0;
+		std::atomic<uint32_t> next;
+		std::atomic<uint32_t> done;
+		std::atomic<uint32_t> worker_count;
+
+		Mutex mutex;
+		Vector<String> worker_files; // What each worker is importing, for the progress dialog.
+	};
+
+	bool use_import_threads;
+	String import_cache_path; // Shared import cache, empty if disabled.
+
+	String _get_import_cache_key(const String &p_file, const Ref<ResourceImporter> &p_importer, const List<ResourceImporter::ImportOption> &p_options, const Map<StringName, Variant> &p_params) const;
+	String _get_import_cache_entry(const String &p_key) const;
+	bool _load_from_import_cache(const String &p_key, const String &p_base_path, const String &p_extension, List<String> *r_variants, Variant *r_metadata);
+	void _store_in_import_cache(const String &p_key, const String &p_base_path, const String &p_extension, const List<String> &p_variants, const Variant &p_metadata);
+
 	void _reimport_file(const String &p_file);
+	bool _reimport_file_import(ReimportResult &r_result);
+	void _reimport_file_update(const ReimportResult &p_result);
+	void _reimport_files_threaded(LocalVector<ReimportResult> &r_results, int p_progress_from, EditorProgress &p_progress);
+	static void _reimport_thread(void *p_userdata);
 	Error _reimport_group(const String &p_group_file, const Vector<String> &p_files);
 
 	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
@@ -220,8 +291,12 @@ class EditorFileSystem : public Node {
 	struct ImportFile {
 		String path;
 		int order;
+		bool threaded = false;
 		bool operator<(const ImportFile &p_if) const {
-			return order < p_if.order;
+			if (order != p_if.order) {
+				return order < p_if.order;
+			}
+			return threaded && !p_if.threaded; // Keep threaded imports of the same order together.
 		}
 	};
 
@@ -3425,9 +3425,20 @@ void EditorNode::notify_all_debug_sessions_exited() {
 }
 
 void EditorNode::add_io_error(const String &p_error) {
+	if (Thread::get_caller_id() != Thread::get_main_id()) {
+		// Importers may run on worker threads, the dialog is shown from the main one.
+		Variant error = p_error;
+		const Variant *args[1] = { &error };
+		callable_mp(singleton, &EditorNode::_add_io_error).call_deferred(args, 1);
+		return;
+	}
 	_load_error_notify(singleton, p_error);
 }
 
+void EditorNode::_add_io_error(const String &p_error) {
+	_load_error_notify(this, p_error);
+}
+
 void EditorNode::_load_error_notify(void *p_ud, const String &p_text) {
 	EditorNode *en = (EditorNode *)p_ud;
 	en->load_errors->add_image(en->gui_base->get_theme_icon("Error", "EditorIcons"));
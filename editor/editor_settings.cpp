@@ -395,6 +395,8 @@ void EditorSettings::_load_defaults(Ref<ConfigFile> p_extra_config) {
 	hints["filesystem/import/pvrtc_texture_tool"] = PropertyInfo(Variant::STRING, "filesystem/import/pvrtc_texture_tool", PROPERTY_HINT_GLOBAL_FILE, "");
 #endif
 	_initial_set("filesystem/import/pvrtc_fast_conversion", false);
+	_initial_set("filesystem/import/shared_cache_path", "");
+	hints["filesystem/import/shared_cache_path"] = PropertyInfo(Variant::STRING, "filesystem/import/shared_cache_path", PROPERTY_HINT_GLOBAL_DIR);
 
 	/* Docks */
 
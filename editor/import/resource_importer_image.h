@@ -50,6 +50,10 @@ public:
 	virtual void get_import_options(List<ImportOption> *r_options, int p_preset = 0) const;
 	virtual bool get_option_visibility(const String &p_option, const Map<StringName, Variant> &p_options) const;
 
+	virtual bool can_import_threaded() const { return true; }
+	virtual bool can_cache_import(const Map<StringName, Variant> &p_options) const { return true; }
+	virtual int get_format_version() const { return 1; }
+
 	virtual Error import(const String &p_source_file, const String &p_save_path, const Map<StringName, Variant> &p_options, List<String> *r_platform_variants, List<String> *r_gen_files = nullptr, Variant *r_metadata = nullptr);
 
 	ResourceImporterImage();
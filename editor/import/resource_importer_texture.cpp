@@ -586,6 +586,11 @@ String ResourceImporterTexture::get_import_settings_string() const {
 	return s;
 }
 
+bool ResourceImporterTexture::can_cache_import(const Map<StringName, Variant> &p_options) const {
+	// Roughness taken from a normal map depends on another file, which is not part of the cache key.
+	return String(p_options["roughness/src_normal"]) == String();
+}
+
 bool ResourceImporterTexture::are_import_settings_valid(const String &p_path) const {
 	//will become invalid if formats are missing to import
 	Dictionary metadata = ResourceFormatImporter::get_singleton()->get_resource_metadata(p_path);
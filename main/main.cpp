@@ -1463,6 +1463,8 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 	ResourceLoader::load_path_remaps();
+	// The editor keeps loading on the calling thread, imports and tools code expect it.
+	ResourceLoader::set_load_dependencies_in_threads(!editor && !project_manager && GLOBAL_DEF("application/run/load_dependencies_in_threads", false));
 
 	audio_server->load_default_bus_layout();
 
@@ -0,0 +1,251 @@
+/*************************************************************************/
+/*  test_dynamic_bvh.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_dynamic_bvh.h"
+
+#include "core/local_vector.h"
+#include "core/math/dynamic_bvh.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+namespace TestDynamicBVH {
+
+// Every query is checked against a brute force pass over all the elements.
+
+enum {
+	ELEMENT_COUNT = 300,
+	QUERY_COUNT = 50,
+	TYPE_GEOMETRY = 1,
+	TYPE_LIGHT = 2,
+};
+
+struct Reference {
+	DynamicBVHElementID id = DYNAMIC_BVH_ELEMENT_INVALID_ID;
+	AABB aabb;
+	uint32_t type = TYPE_GEOMETRY;
+};
+
+static RandomPCG rng(1234);
+static int userdata[ELEMENT_COUNT];
+static Reference reference[ELEMENT_COUNT];
+
+static AABB _random_aabb(real_t p_max_size) {
+	Vector3 pos(rng.random(-100.0f, 100.0f), rng.random(-100.0f, 100.0f), rng.random(-100.0f, 100.0f));
+	Vector3 size(rng.random(0.0f, p_max_size), rng.random(0.0f, p_max_size), rng.random(0.0f, p_max_size));
+	return AABB(pos, size);
+}
+
+static void _create(DynamicBVH<int> &p_bvh, int p_index) {
+	Reference &r = reference[p_index];
+	r.aabb = _random_aabb(10);
+	r.type = p_index % 5 == 0 ? TYPE_LIGHT : TYPE_GEOMETRY;
+	bool pairable = r.type == TYPE_LIGHT;
+	r.id = p_bvh.create(&userdata[p_index], r.aabb, 0, pairable, r.type, pairable ? TYPE_GEOMETRY : 0);
+}
+
+static bool _outside_plane(const Plane &p_plane, const AABB &p_aabb) {
+	Vector3 half_extents = p_aabb.size * 0.5;
+	Vector3 center = p_aabb.position + half_extents;
+	real_t d = p_plane.normal.dot(center) - p_plane.d;
+	real_t r = Math::abs(p_plane.normal.x) * half_extents.x + Math::abs(p_plane.normal.y) * half_extents.y + Math::abs(p_plane.normal.z) * half_extents.z;
+	return d - r > 0;
+}
+
+static bool _compare(const char *p_what, int *const *p_result, int p_result_count, const LocalVector<int> &p_expected) {
+	LocalVector<int> found;
+	for (int i = 0; i < p_result_count; i++) {
+		found.push_back(p_result[i] - userdata);
+	}
+	found.sort();
+
+	bool ok = found.size() == p_expected.size();
+	for (uint32_t i = 0; ok && i < found.size(); i++) {
+		ok = found[i] == p_expected[i];
+	}
+	if (!ok) {
+		OS::get_singleton()->print("\t%s: found %d elements, expected %d\n", p_what, int(found.size()), int(p_expected.size()));
+	}
+	return ok;
+}
+
+static bool _check_queries(const DynamicBVH<int> &p_bvh) {
+	int *result[ELEMENT_COUNT];
+	LocalVector<int> expected;
+
+	for (int q = 0; q < QUERY_COUNT; q++) {
+		AABB query = _random_aabb(60);
+		uint32_t mask = q % 3 == 0 ? uint32_t(TYPE_LIGHT) : (q % 3 == 1 ? uint32_t(TYPE_GEOMETRY) : 0xFFFFFFFF);
+
+		expected.clear();
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			if (reference[i].id != DYNAMIC_BVH_ELEMENT_INVALID_ID && (reference[i].type & mask) && reference[i].aabb.intersects(query)) {
+				expected.push_back(i);
+			}
+		}
+		if (!_compare("aabb query", result, p_bvh.cull_aabb(query, result, ELEMENT_COUNT, mask), expected)) {
+			return false;
+		}
+
+		// The query box with one corner cut off, so not every plane is axis aligned.
+		Vector3 end = query.position + query.size;
+		Vector3 diagonal = Vector3(1, 1, 1).normalized();
+		Vector<Plane> convex;
+		convex.push_back(Plane(Vector3(1, 0, 0), end.x));
+		convex.push_back(Plane(Vector3(-1, 0, 0), -query.position.x));
+		convex.push_back(Plane(Vector3(0, 1, 0), end.y));
+		convex.push_back(Plane(Vector3(0, -1, 0), -query.position.y));
+		convex.push_back(Plane(Vector3(0, 0, 1), end.z));
+		convex.push_back(Plane(Vector3(0, 0, -1), -query.position.z));
+		convex.push_back(Plane(diagonal, diagonal.dot(query.position + query.size * 0.75)));
+
+		expected.clear();
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			if (reference[i].id == DYNAMIC_BVH_ELEMENT_INVALID_ID || !(reference[i].type & mask)) {
+				continue;
+			}
+			bool outside = false;
+			for (int j = 0; j < convex.size() && !outside; j++) {
+				outside = _outside_plane(convex[j], reference[i].aabb);
+			}
+			if (!outside) {
+				expected.push_back(i);
+			}
+		}
+		if (!_compare("convex query", result, p_bvh.cull_convex(convex, result, ELEMENT_COUNT, mask), expected)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool test_insert() {
+	OS::get_singleton()->print("\n\nTest 1: Insert\n");
+
+	DynamicBVH<int> bvh;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		_create(bvh, i);
+	}
+
+	return bvh.get_elem_count() == ELEMENT_COUNT && _check_queries(bvh);
+}
+
+bool test_update() {
+	OS::get_singleton()->print("\n\nTest 2: Update\n");
+
+	DynamicBVH<int> bvh;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		_create(bvh, i);
+	}
+
+	for (int pass = 0; pass < 4; pass++) {
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			AABB &aabb = reference[i].aabb;
+			if (i % 2 == 0) {
+				// Small moves stay inside the enlarged leaf and only refit pairs.
+				aabb.position += Vector3(rng.random(-0.05f, 0.05f), rng.random(-0.05f, 0.05f), rng.random(-0.05f, 0.05f));
+			} else {
+				aabb = _random_aabb(10);
+			}
+			bvh.move(reference[i].id, aabb);
+		}
+		if (!_check_queries(bvh)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool test_remove() {
+	OS::get_singleton()->print("\n\nTest 3: Remove\n");
+
+	DynamicBVH<int> bvh;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		_create(bvh, i);
+	}
+
+	for (int i = 0; i < ELEMENT_COUNT; i += 3) {
+		bvh.erase(reference[i].id);
+		reference[i].id = DYNAMIC_BVH_ELEMENT_INVALID_ID;
+	}
+	if (!_check_queries(bvh)) {
+		return false;
+	}
+
+	// Reuses the freed elements and nodes.
+	for (int i = 0; i < ELEMENT_COUNT; i += 6) {
+		_create(bvh, i);
+	}
+	if (!_check_queries(bvh)) {
+		return false;
+	}
+
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		if (reference[i].id != DYNAMIC_BVH_ELEMENT_INVALID_ID) {
+			bvh.erase(reference[i].id);
+			reference[i].id = DYNAMIC_BVH_ELEMENT_INVALID_ID;
+		}
+	}
+
+	return bvh.get_elem_count() == 0 && bvh.get_pair_count() == 0 && _check_queries(bvh);
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_insert,
+	test_update,
+	test_remove,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestDynamicBVH
@@ -0,0 +1,355 @@
+/*************************************************************************/
+/*  test_json.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_json.h"
+
+#include "core/io/json.h"
+#include "core/os/os.h"
+
+namespace TestJSON {
+
+// Parses p_json and prints the result back compact and indented. Numbers are
+// always parsed as floats, which print the same as the integers they hold.
+static bool _check_round_trip(const String &p_json, Variant &r_parsed) {
+	String err_str;
+	int err_line = 0;
+	Error err = JSON::parse(p_json, r_parsed, err_str, err_line);
+	if (err != OK) {
+		OS::get_singleton()->print("\tParse error at line %i: %ls\n", err_line, err_str.c_str());
+		return false;
+	}
+
+	String printed = JSON::print(r_parsed);
+	if (printed != p_json) {
+		OS::get_singleton()->print("\tPrinted: %ls\n\tExpected: %ls\n", printed.c_str(), p_json.c_str());
+		return false;
+	}
+
+	Variant reparsed;
+	err = JSON::parse(JSON::print(r_parsed, "\t"), reparsed, err_str, err_line);
+	if (err != OK || JSON::print(reparsed) != p_json) {
+		OS::get_singleton()->print("\tIndented output does not parse back the same\n");
+		return false;
+	}
+
+	return true;
+}
+
+bool test_nesting() {
+	OS::get_singleton()->print("\n\nTest 1: Round trip of nested objects and arrays\n");
+
+	String json = "{\"array\":[1,2.5,-3,true,false,null,[],{}],\"nested\":{\"deeper\":{\"deepest\":[\"x\",[[0]]]}},\"string\":\"text\"}";
+	Variant parsed;
+	if (!_check_round_trip(json, parsed)) {
+		return false;
+	}
+
+	Dictionary root = parsed;
+	Array array = root["array"];
+	Dictionary deeper = Dictionary(root["nested"])["deeper"];
+	Array deepest = deeper["deepest"];
+
+	return array.size() == 8 && array[1].get_type() == Variant::FLOAT && double(array[1]) == 2.5 && array[5].get_type() == Variant::NIL &&
+		   array[6].get_type() == Variant::ARRAY && array[7].get_type() == Variant::DICTIONARY &&
+		   deepest.size() == 2 && String(deepest[0]) == "x" && Array(Array(deepest[1])[0]).size() == 1;
+}
+
+bool test_deep_nesting() {
+	OS::get_singleton()->print("\n\nTest 2: Round trip of deeply nested arrays\n");
+
+	String json;
+	for (int i = 0; i < 64; i++) {
+		json += i % 2 ? "{\"k\":" : "[";
+	}
+	json += "0";
+	for (int i = 63; i >= 0; i--) {
+		json += i % 2 ? "}" : "]";
+	}
+
+	Variant parsed;
+	return _check_round_trip(json, parsed);
+}
+
+bool test_escapes() {
+	OS::get_singleton()->print("\n\nTest 3: Round trip of escaped strings\n");
+
+	// Written with the escapes the writer uses, so it prints back unchanged.
+	Variant parsed;
+	if (!_check_round_trip(String::utf8("{\"key \\\"quoted\\\"\":\"back\\\\slash \\n \\t \\r \\b \\f caf\xc3\xa9\"}"), parsed)) {
+		return false;
+	}
+
+	Dictionary root = parsed;
+	String expected = String("back\\slash \n \t \r \b \f caf") + String::chr(0xe9);
+	if (!root.has("key \"quoted\"") || String(root["key \"quoted\""]) != expected) {
+		OS::get_singleton()->print("\tUnescaped string does not match\n");
+		return false;
+	}
+
+	// Escapes the writer never produces.
+	String err_str;
+	int err_line = 0;
+	Error err = JSON::parse("[\"\\/ \\u20AC \\u00e9\"]", parsed, err_str, err_line);
+	if (err != OK) {
+		return false;
+	}
+	Array array = parsed;
+	return array.size() == 1 && String(array[0]) == String("/ ") + String::chr(0x20ac) + " " + String::chr(0xe9);
+}
+
+bool test_errors() {
+	OS::get_singleton()->print("\n\nTest 4: Report parse errors and their line\n");
+
+	struct ErrorCase {
+		const char *json;
+		const char *err_str;
+		int err_line;
+	};
+
+	static const ErrorCase cases[] = {
+		{ "[1,\n2", "", 1 },
+		{ "{\"a\" 1}", "Expected ':'", 0 },
+		{ "[1 2]", "Expected ','", 0 },
+		{ "{\"a\": 1\n\"b\": 2}", "Expected '}' or ','", 1 },
+		{ "{1: 2}", "Expected key", 0 },
+		{ "[tru]", "Expected 'true','false' or 'null', got 'tru'.", 0 },
+		{ "\n\n\"abc", "Unterminated String", 2 },
+		{ "[\"\\u12G4\"]", "Malformed hex constant in string", 0 },
+		{ "{\n\"a\":\n}", "Expected value, got '}'.", 2 },
+		{ "[@]", "Unexpected character.", 0 },
+		{ nullptr, nullptr, 0 }
+	};
+
+	bool pass = true;
+	for (int i = 0; cases[i].json; i++) {
+		Variant parsed;
+		String err_str;
+		int err_line = -1;
+		Error err = JSON::parse(cases[i].json, parsed, err_str, err_line);
+		if (err != ERR_PARSE_ERROR || err_str != cases[i].err_str || err_line != cases[i].err_line) {
+			OS::get_singleton()->print("\tCase %i: got '%ls' at line %i\n", i, err_str.c_str(), err_line);
+			pass = false;
+		}
+	}
+
+	return pass;
+}
+
+// Logs the events of JSON::parse_events() as text, one per token.
+class JSONEventLog : public JSON::Handler {
+public:
+	String log;
+	int fail_on_number = -1; // index of the number to fail on, -1 never fails
+	int numbers = 0;
+
+	virtual Error begin_object() {
+		log += "{ ";
+		return OK;
+	}
+	virtual Error end_object() {
+		log += "} ";
+		return OK;
+	}
+	virtual Error begin_array() {
+		log += "[ ";
+		return OK;
+	}
+	virtual Error end_array() {
+		log += "] ";
+		return OK;
+	}
+	virtual Error key(const CharType *p_str, int p_len) {
+		log += "k:" + String(p_str, p_len) + " ";
+		return OK;
+	}
+	virtual Error string_value(const CharType *p_str, int p_len) {
+		log += "s:" + String(p_str, p_len) + " ";
+		return OK;
+	}
+	virtual Error number_value(double p_value) {
+		if (numbers++ == fail_on_number) {
+			return ERR_SKIP;
+		}
+		log += "n:" + rtos(p_value) + " ";
+		return OK;
+	}
+	virtual Error bool_value(bool p_value) {
+		log += p_value ? "true " : "false ";
+		return OK;
+	}
+	virtual Error null_value() {
+		log += "null ";
+		return OK;
+	}
+};
+
+bool test_parse_events() {
+	OS::get_singleton()->print("\n\nTest 5: Parse events through a handler\n");
+
+	// Escaped strings are handed over from the scratch buffer, the rest as views into the text.
+	String json = "{\"plain\": [1, -2.5, \"view\", \"esc\\\"aped\\n\"], \"k\\tey\": {\"t\": true, \"f\": false, \"n\": null}}";
+	String expected = "{ k:plain [ n:1 n:-2.5 s:view s:esc\"aped\n ] k:k\tey { k:t true k:f false k:n null } } ";
+
+	JSONEventLog events;
+	String err_str;
+	int err_line = 0;
+	Error err = JSON::parse_events(json.ptr(), json.length(), &events, err_str, err_line);
+	if (err != OK || events.log != expected) {
+		OS::get_singleton()->print("\tGot: %ls\n", events.log.c_str());
+		return false;
+	}
+
+	// An error from the handler stops parsing and is returned as is.
+	JSONEventLog failing;
+	failing.fail_on_number = 1;
+	err = JSON::parse_events(json.ptr(), json.length(), &failing, err_str, err_line);
+	if (err != ERR_SKIP || failing.log != "{ k:plain [ n:1 ") {
+		OS::get_singleton()->print("\tHandler error not returned, got: %ls\n", failing.log.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool test_print_to_buffer() {
+	OS::get_singleton()->print("\n\nTest 6: Print to a reused buffer\n");
+
+	Dictionary d;
+	d["text"] = String("caf") + String::chr(0xe9) + " " + String::chr(0x20ac);
+	Array a;
+	a.push_back(1);
+	a.push_back(-7);
+	a.push_back(0.5);
+	a.push_back(Variant());
+	d["array"] = a;
+
+	// The buffer is appended to, and holds the same UTF-8 as print() returns.
+	LocalVector<uint8_t> buffer;
+	buffer.push_back('>');
+	JSON::print_to_buffer(d, buffer, "\t");
+	CharString expected = JSON::print(d, "\t").utf8();
+	if (buffer.size() != uint32_t(expected.length() + 1) || buffer[0] != '>' || memcmp(buffer.ptr() + 1, expected.get_data(), expected.length()) != 0) {
+		OS::get_singleton()->print("\tBuffer does not match print()\n");
+		return false;
+	}
+
+	buffer.clear();
+	JSON::print_to_buffer(a, buffer);
+	return String::utf8((const char *)buffer.ptr(), buffer.size()) == "[1,-7,0.5,null]";
+}
+
+bool test_pack_number_arrays() {
+	OS::get_singleton()->print("\n\nTest 7: Pack arrays of numbers\n");
+
+	String json = "{\"numbers\":[1,2.5,-3],\"empty\":[],\"mixed\":[1,\"x\"],\"nested\":[1,[2],3]}";
+	Variant parsed;
+	String err_str;
+	int err_line = 0;
+	if (JSON::parse(json, parsed, err_str, err_line, true) != OK) {
+		return false;
+	}
+	Dictionary d = parsed;
+
+	if (d["numbers"].get_type() != Variant::PACKED_FLOAT32_ARRAY) {
+		OS::get_singleton()->print("\tNumbers were not packed\n");
+		return false;
+	}
+	PackedFloat32Array numbers = d["numbers"];
+	if (numbers.size() != 3 || numbers[0] != 1 || numbers[1] != 2.5 || numbers[2] != -3) {
+		OS::get_singleton()->print("\tPacked numbers do not match\n");
+		return false;
+	}
+
+	// Empty arrays and arrays holding anything but numbers stay Array.
+	if (d["empty"].get_type() != Variant::ARRAY || Array(d["empty"]).size() != 0) {
+		OS::get_singleton()->print("\tEmpty array was packed\n");
+		return false;
+	}
+	Array mixed = d["mixed"];
+	if (d["mixed"].get_type() != Variant::ARRAY || mixed.size() != 2 || double(mixed[0]) != 1 || String(mixed[1]) != "x") {
+		OS::get_singleton()->print("\tMixed array was not kept\n");
+		return false;
+	}
+
+	// The numbers already seen must be kept in order when a nested array turns the outer one back into Array.
+	Array nested = d["nested"];
+	if (d["nested"].get_type() != Variant::ARRAY || nested.size() != 3 || double(nested[0]) != 1 || double(nested[2]) != 3 || nested[1].get_type() != Variant::PACKED_FLOAT32_ARRAY) {
+		OS::get_singleton()->print("\tNested array was not kept\n");
+		return false;
+	}
+	PackedFloat32Array inner = nested[1];
+	if (inner.size() != 1 || inner[0] != 2) {
+		return false;
+	}
+
+	// Without packing, the same text prints back unchanged.
+	if (JSON::parse(json, parsed, err_str, err_line) != OK || JSON::print(parsed, "", false) != json) {
+		OS::get_singleton()->print("\tUnpacked result does not print back\n");
+		return false;
+	}
+
+	return true;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_nesting,
+	test_deep_nesting,
+	test_escapes,
+	test_errors,
+	test_parse_events,
+	test_print_to_buffer,
+	test_pack_number_arrays,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestJSON
@@ -36,24 +36,38 @@
 
 #include "test_astar.h"
 #include "test_class_db.h"
+#include "test_dynamic_bvh.h"
 #include "test_gdscript.h"
 #include "test_gui.h"
+#include "test_json.h"
+#include "test_marshalls.h"
 #include "test_math.h"
 #include "test_oa_hash_map.h"
+#include "test_occlusion_buffer.h"
 #include "test_ordered_hash_map.h"
 #include "test_physics_2d.h"
 #include "test_physics_3d.h"
+#include "test_physics_sw.h"
 #include "test_render.h"
+#include "test_render_list.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
+#include "test_surface_tool.h"
 
 const char **tests_get_names() {
 	static const char *test_names[] = {
 		"string",
+		"json",
+		"marshalls",
 		"math",
+		"dynamic_bvh",
 		"physics_2d",
 		"physics_3d",
+		"physics_sw",
 		"render",
+		"render_list",
+		"occlusion_buffer",
+		"surface_tool",
 		"oa_hash_map",
 		"class_db",
 		"gui",
@@ -75,10 +89,22 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestString::test();
 	}
 
+	if (p_test == "json") {
+		return TestJSON::test();
+	}
+
+	if (p_test == "marshalls") {
+		return TestMarshalls::test();
+	}
+
 	if (p_test == "math") {
 		return TestMath::test();
 	}
 
+	if (p_test == "dynamic_bvh") {
+		return TestDynamicBVH::test();
+	}
+
 	if (p_test == "physics_2d") {
 		return TestPhysics2D::test();
 	}
@@ -87,10 +113,26 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestPhysics3D::test();
 	}
 
+	if (p_test == "physics_sw") {
+		return TestPhysicsSW::test();
+	}
+
 	if (p_test == "render") {
 		return TestRender::test();
 	}
 
+	if (p_test == "render_list") {
+		return TestRenderList::test();
+	}
+
+	if (p_test == "occlusion_buffer") {
+		return TestOcclusionBuffer::test();
+	}
+
+	if (p_test == "surface_tool") {
+		return TestSurfaceTool::test();
+	}
+
 	if (p_test == "oa_hash_map") {
 		return TestOAHashMap::test();
 	}
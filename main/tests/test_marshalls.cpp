@@ -0,0 +1,217 @@
+/*************************************************************************/
+/*  test_marshalls.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_marshalls.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+
+namespace TestMarshalls {
+
+// One value of every packed array type, empty or not.
+static Vector<Variant> _make_packed_arrays(bool p_empty) {
+	PackedByteArray bytes;
+	PackedInt32Array ints32;
+	PackedInt64Array ints64;
+	PackedFloat32Array floats32;
+	PackedFloat64Array floats64;
+	PackedStringArray strings;
+	PackedVector2Array vectors2;
+	PackedVector3Array vectors3;
+	PackedColorArray colors;
+
+	if (!p_empty) {
+		for (int i = 0; i < 5; i++) {
+			bytes.push_back(250 + i);
+			ints32.push_back(-100000 * i);
+			ints64.push_back(int64_t(1) << (40 + i));
+			floats32.push_back(0.25 * i - 1);
+			floats64.push_back(1e100 * i + 0.1);
+			strings.push_back(String("s").repeat(i)); // lengths that need every amount of padding
+			vectors2.push_back(Vector2(i, -i * 0.5));
+			vectors3.push_back(Vector3(i, i * 2, -i));
+			colors.push_back(Color(0.1 * i, 0.2, 0.3, 1));
+		}
+	}
+
+	Vector<Variant> values;
+	values.push_back(bytes);
+	values.push_back(ints32);
+	values.push_back(ints64);
+	values.push_back(floats32);
+	values.push_back(floats64);
+	values.push_back(strings);
+	values.push_back(vectors2);
+	values.push_back(vectors3);
+	values.push_back(colors);
+	return values;
+}
+
+static Vector<Variant> _make_values() {
+	Vector<Variant> values;
+	values.push_back(Variant());
+	values.push_back(true);
+	values.push_back(42);
+	values.push_back(int64_t(1) << 40);
+	values.push_back(0.5);
+	values.push_back(1e100);
+	values.push_back(String());
+	values.push_back(String("abc"));
+	values.push_back(String("caf") + String::chr(0xe9));
+	values.push_back(Vector2(1, 2));
+	values.push_back(Vector3(1, 2, 3));
+	values.push_back(Transform(Basis(Vector3(0, 1, 0), 1), Vector3(4, 5, 6)));
+	values.push_back(Color(1, 0.5, 0.25, 0.125));
+	values.push_back(NodePath("a/b:c"));
+
+	Vector<Variant> packed = _make_packed_arrays(false);
+	values.append_array(packed);
+	values.append_array(_make_packed_arrays(true));
+
+	Array array;
+	array.push_back(1);
+	array.push_back("two");
+	array.push_back(Array());
+	array.push_back(packed[2]);
+	values.push_back(array);
+
+	Dictionary dictionary;
+	dictionary["array"] = array;
+	dictionary[3] = String("three");
+	dictionary["nested"] = Dictionary();
+	values.push_back(dictionary);
+
+	return values;
+}
+
+bool test_single_pass() {
+	OS::get_singleton()->print("\n\nTest 1: Single pass encoding matches the two pass one\n");
+
+	Vector<Variant> values = _make_values();
+
+	// Reused between values and left larger than needed, so stale bytes would show.
+	Vector<uint8_t> single_pass;
+	single_pass.resize(4096);
+	memset(single_pass.ptrw(), 0xAB, single_pass.size());
+
+	bool pass = true;
+	for (int i = 0; i < values.size(); i++) {
+		int len = 0;
+		Error err = encode_variant(values[i], nullptr, len);
+		Vector<uint8_t> two_pass;
+		two_pass.resize(len);
+		int written = 0;
+		if (err == OK) {
+			err = encode_variant(values[i], two_pass.ptrw(), written);
+		}
+
+		int single_len = -1;
+		Error single_err = encode_variant(values[i], single_pass, single_len);
+
+		if (err != OK || single_err != OK || written != len || single_len != len || single_pass.size() < len || memcmp(single_pass.ptr(), two_pass.ptr(), len) != 0) {
+			OS::get_singleton()->print("\tValue %d (%s) differs: %d bytes, single pass %d bytes\n", i, Variant::get_type_name(values[i].get_type()).utf8().get_data(), len, single_len);
+			pass = false;
+		}
+	}
+
+	// A buffer that starts empty grows to fit.
+	Vector<uint8_t> empty;
+	int len = 0;
+	Error err = encode_variant(values[values.size() - 1], empty, len);
+	return pass && err == OK && len > 0 && empty.size() >= len;
+}
+
+bool test_packed_round_trip() {
+	OS::get_singleton()->print("\n\nTest 2: Round trip every packed array type\n");
+
+	Vector<Variant> values = _make_packed_arrays(false);
+	values.append_array(_make_packed_arrays(true));
+
+	bool pass = true;
+	for (int i = 0; i < values.size(); i++) {
+		CharString type_name = Variant::get_type_name(values[i].get_type()).utf8();
+		int count = Array(values[i]).size();
+
+		Vector<uint8_t> buffer;
+		int len = 0;
+		Error err = encode_variant(values[i], buffer, len);
+
+		Variant decoded;
+		int read = 0;
+		if (err == OK) {
+			err = decode_variant(decoded, buffer.ptr(), len, &read);
+		}
+		if (err != OK || read != len || decoded != values[i]) {
+			OS::get_singleton()->print("\t%s of size %d does not round trip\n", type_name.get_data(), count);
+			pass = false;
+		}
+
+		// The element count of the 64-bit arrays is 32 bits, like for every other packed array.
+		if (values[i].get_type() == Variant::PACKED_INT64_ARRAY || values[i].get_type() == Variant::PACKED_FLOAT64_ARRAY) {
+			if (len != 8 + count * 8 || decode_uint32(buffer.ptr() + 4) != uint32_t(count)) {
+				OS::get_singleton()->print("\t%s of size %d encoded as %d bytes\n", type_name.get_data(), count, len);
+				pass = false;
+			}
+		}
+	}
+
+	return pass;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_single_pass,
+	test_packed_round_trip,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestMarshalls
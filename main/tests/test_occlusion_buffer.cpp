@@ -0,0 +1,140 @@
+/*************************************************************************/
+/*  test_occlusion_buffer.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_occlusion_buffer.h"
+
+#include "core/os/os.h"
+#include "servers/rendering/occlusion_buffer.h"
+
+namespace TestOcclusionBuffer {
+
+// A 90 degree camera at the origin looking down -Z, so a point at depth d
+// projects to x / d in NDC and the 256x256 buffer maps NDC 0.5 to pixel 192.
+// The occluder is a quad made of two triangles at z = -10. Its right edge
+// sits at pixel 192.6, so the pixel at 192 has its center covered but not all
+// of its area.
+
+static const real_t OCCLUDER_RIGHT = (192.6 / 128.0 - 1.0) * 10.0;
+
+static void _setup(OcclusionBuffer &r_buffer) {
+	CameraMatrix projection;
+	projection.set_perspective(90, 1, 0.1, 100);
+	r_buffer.begin(projection, Transform());
+
+	Vector3 vertices[4] = {
+		Vector3(-5, -5, -10),
+		Vector3(OCCLUDER_RIGHT, -5, -10),
+		Vector3(OCCLUDER_RIGHT, 5, -10),
+		Vector3(-5, 5, -10),
+	};
+	int indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+	LocalVector<int> edge_neighbors;
+	OcclusionBuffer::build_edge_neighbors(indices, 6, edge_neighbors);
+
+	r_buffer.rasterize(Transform(), vertices, 4, indices, 6, edge_neighbors.ptr());
+	r_buffer.finish();
+}
+
+static AABB _box(const Vector3 &p_from, const Vector3 &p_to) {
+	return AABB(p_from, p_to - p_from);
+}
+
+bool test_hidden() {
+	OS::get_singleton()->print("\n\nTest 1: Box fully behind the occluder\n");
+
+	OcclusionBuffer buffer;
+	_setup(buffer);
+
+	// Also crosses the edge shared by both triangles, which must not leak.
+	return buffer.is_occluded(_box(Vector3(-1, -1, -20), Vector3(1, 1, -19)));
+}
+
+bool test_partly_visible() {
+	OS::get_singleton()->print("\n\nTest 2: Box partly behind the occluder\n");
+
+	OcclusionBuffer buffer;
+	_setup(buffer);
+
+	return !buffer.is_occluded(_box(Vector3(8, -1, -20), Vector3(14, 1, -19)));
+}
+
+bool test_in_front() {
+	OS::get_singleton()->print("\n\nTest 3: Box in front of the occluder\n");
+
+	OcclusionBuffer buffer;
+	_setup(buffer);
+
+	return !buffer.is_occluded(_box(Vector3(-1, -1, -6), Vector3(1, 1, -5)));
+}
+
+bool test_silhouette() {
+	OS::get_singleton()->print("\n\nTest 4: Box peeking less than a pixel past the silhouette\n");
+
+	OcclusionBuffer buffer;
+	_setup(buffer);
+
+	// Reaches pixel 192.8, past the occluder edge but inside the pixel whose
+	// center the occluder covers.
+	return !buffer.is_occluded(_box(Vector3(9.9, -0.01, -20.5), Vector3(10.125, 0.01, -20)));
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_hidden,
+	test_partly_visible,
+	test_in_front,
+	test_silhouette,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestOcclusionBuffer
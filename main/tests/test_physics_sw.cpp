@@ -0,0 +1,282 @@
+/*************************************************************************/
+/*  test_physics_sw.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_physics_sw.h"
+
+#include "core/os/os.h"
+#include "servers/physics_server_2d.h"
+#include "servers/physics_server_3d.h"
+
+namespace TestPhysicsSW {
+
+// These use the physics servers directly and need the software ones, so the 3D
+// tests are skipped when another 3D physics engine is selected.
+
+static bool _is_3d_sw() {
+	if (PhysicsServer3D::get_singleton()->get_class() == "PhysicsServer3DSW") {
+		return true;
+	}
+	OS::get_singleton()->print("\tskipped, set physics/3d/physics_engine to GodotPhysics3D\n");
+	return false;
+}
+
+bool test_ccd_sliding() {
+	OS::get_singleton()->print("\n\nTest 1: CCD on a body sliding along a surface\n");
+	if (!_is_3d_sw()) {
+		return true;
+	}
+
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	ps->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 0.0);
+
+	RID plane_shape = ps->shape_create(PhysicsServer3D::SHAPE_PLANE);
+	ps->shape_set_data(plane_shape, Plane(Vector3(0, 1, 0), 0));
+	RID floor = ps->body_create(PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, plane_shape);
+	ps->body_set_param(floor, PhysicsServer3D::BODY_PARAM_FRICTION, 0.0);
+	ps->body_set_space(floor, space);
+
+	// A fast ball moving parallel to the floor, closer to it than the CCD tolerance.
+	RID sphere_shape = ps->shape_create(PhysicsServer3D::SHAPE_SPHERE);
+	ps->shape_set_data(sphere_shape, 0.5);
+	RID ball = ps->body_create(PhysicsServer3D::BODY_MODE_RIGID);
+	ps->body_add_shape(ball, sphere_shape);
+	ps->body_set_param(ball, PhysicsServer3D::BODY_PARAM_FRICTION, 0.0);
+	ps->body_set_enable_continuous_collision_detection(ball, true);
+	ps->body_set_state(ball, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform(Basis(), Vector3(0, 0.502, 0)));
+	ps->body_set_state(ball, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(100, 0, 0));
+	ps->body_set_space(ball, space);
+
+	bool ok = true;
+	for (int i = 0; i < 10; i++) {
+		ps->step(1.0 / 60.0);
+		Vector3 velocity = ps->body_get_state(ball, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		if (velocity.x < 99.0) {
+			OS::get_singleton()->print("\tvelocity dropped to %f at step %d\n", velocity.x, i);
+			ok = false;
+			break;
+		}
+	}
+
+	ps->free(ball);
+	ps->free(sphere_shape);
+	ps->free(floor);
+	ps->free(plane_shape);
+	ps->free(space);
+
+	return ok;
+}
+
+// Snapshots are meant for rollback, so stepping from a restored snapshot must
+// give exactly the same state as stepping from the original one.
+
+enum {
+	SNAPSHOT_BOX_COUNT = 6,
+	SNAPSHOT_SETTLE_STEPS = 30,
+	SNAPSHOT_REPLAY_STEPS = 20,
+};
+
+bool test_snapshot_2d() {
+	OS::get_singleton()->print("\n\nTest 2: 2D snapshot, restore and re-step\n");
+
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	ps->space_set_deterministic(space, true);
+
+	RID floor_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(floor_shape, Vector2(100, 10));
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, floor_shape);
+	ps->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 10)));
+	ps->body_set_space(floor, space);
+
+	// A leaning stack, so bodies keep touching and sliding while replaying.
+	RID box_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(box_shape, Vector2(5, 5));
+	RID boxes[SNAPSHOT_BOX_COUNT];
+	for (int i = 0; i < SNAPSHOT_BOX_COUNT; i++) {
+		boxes[i] = ps->body_create();
+		ps->body_add_shape(boxes[i], box_shape);
+		ps->body_set_state(boxes[i], PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.1 * i, Vector2(i * 1.5, -5 - i * 10.5)));
+		ps->body_set_space(boxes[i], space);
+	}
+
+	for (int i = 0; i < SNAPSHOT_SETTLE_STEPS; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	Vector<uint8_t> snapshot = ps->space_get_snapshot(space);
+	bool ok = snapshot.size() > 0;
+
+	Transform2D expected_xform[SNAPSHOT_BOX_COUNT];
+	Vector2 expected_lv[SNAPSHOT_BOX_COUNT];
+	real_t expected_av[SNAPSHOT_BOX_COUNT];
+	for (int pass = 0; pass < 2 && ok; pass++) {
+		if (pass == 1) {
+			ok = ps->space_restore_snapshot(space, snapshot) == OK;
+		}
+		for (int i = 0; i < SNAPSHOT_REPLAY_STEPS; i++) {
+			ps->step(1.0 / 60.0);
+		}
+		for (int i = 0; i < SNAPSHOT_BOX_COUNT && ok; i++) {
+			Transform2D xform = ps->body_get_state(boxes[i], PhysicsServer2D::BODY_STATE_TRANSFORM);
+			Vector2 lv = ps->body_get_state(boxes[i], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+			real_t av = ps->body_get_state(boxes[i], PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+			if (pass == 0) {
+				expected_xform[i] = xform;
+				expected_lv[i] = lv;
+				expected_av[i] = av;
+			} else if (xform != expected_xform[i] || lv != expected_lv[i] || av != expected_av[i]) {
+				OS::get_singleton()->print("\tbox %d differs after replaying\n", i);
+				ok = false;
+			}
+		}
+	}
+
+	for (int i = 0; i < SNAPSHOT_BOX_COUNT; i++) {
+		ps->free(boxes[i]);
+	}
+	ps->free(box_shape);
+	ps->free(floor);
+	ps->free(floor_shape);
+	ps->free(space);
+
+	return ok;
+}
+
+bool test_snapshot_3d() {
+	OS::get_singleton()->print("\n\nTest 3: 3D snapshot, restore and re-step\n");
+	if (!_is_3d_sw()) {
+		return true;
+	}
+
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	ps->space_set_deterministic(space, true);
+
+	RID floor_shape = ps->shape_create(PhysicsServer3D::SHAPE_PLANE);
+	ps->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID floor = ps->body_create(PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, floor_shape);
+	ps->body_set_space(floor, space);
+
+	// A leaning stack, so bodies keep touching and sliding while replaying.
+	RID box_shape = ps->shape_create(PhysicsServer3D::SHAPE_BOX);
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID boxes[SNAPSHOT_BOX_COUNT];
+	for (int i = 0; i < SNAPSHOT_BOX_COUNT; i++) {
+		boxes[i] = ps->body_create(PhysicsServer3D::BODY_MODE_RIGID);
+		ps->body_add_shape(boxes[i], box_shape);
+		ps->body_set_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform(Basis(Vector3(0, 1, 0), 0.1 * i), Vector3(i * 0.15, 0.5 + i * 1.05, 0)));
+		ps->body_set_space(boxes[i], space);
+	}
+
+	for (int i = 0; i < SNAPSHOT_SETTLE_STEPS; i++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	Vector<uint8_t> snapshot = ps->space_get_snapshot(space);
+	bool ok = snapshot.size() > 0;
+
+	Transform expected_xform[SNAPSHOT_BOX_COUNT];
+	Vector3 expected_lv[SNAPSHOT_BOX_COUNT];
+	Vector3 expected_av[SNAPSHOT_BOX_COUNT];
+	for (int pass = 0; pass < 2 && ok; pass++) {
+		if (pass == 1) {
+			ok = ps->space_restore_snapshot(space, snapshot) == OK;
+		}
+		for (int i = 0; i < SNAPSHOT_REPLAY_STEPS; i++) {
+			ps->step(1.0 / 60.0);
+		}
+		for (int i = 0; i < SNAPSHOT_BOX_COUNT && ok; i++) {
+			Transform xform = ps->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			Vector3 lv = ps->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+			Vector3 av = ps->body_get_state(boxes[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+			if (pass == 0) {
+				expected_xform[i] = xform;
+				expected_lv[i] = lv;
+				expected_av[i] = av;
+			} else if (xform != expected_xform[i] || lv != expected_lv[i] || av != expected_av[i]) {
+				OS::get_singleton()->print("\tbox %d differs after replaying\n", i);
+				ok = false;
+			}
+		}
+	}
+
+	for (int i = 0; i < SNAPSHOT_BOX_COUNT; i++) {
+		ps->free(boxes[i]);
+	}
+	ps->free(box_shape);
+	ps->free(floor);
+	ps->free(floor_shape);
+	ps->free(space);
+
+	return ok;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_ccd_sliding,
+	test_snapshot_2d,
+	test_snapshot_3d,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestPhysicsSW
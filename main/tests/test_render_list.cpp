@@ -0,0 +1,220 @@
+/*************************************************************************/
+/*  test_render_list.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_render_list.h"
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/rasterizer_rd/rasterizer_scene_high_end_rd.h"
+
+namespace TestRenderList {
+
+// Runs the sort of the high end renderer's RenderList, including the cache of
+// previous sort orders, on random keys. Sorting by key never reads the
+// instances or materials, so elements are left without them.
+
+typedef RasterizerSceneHighEndRD::RenderList RenderList;
+
+enum {
+	ELEMENT_COUNT = 100000,
+	GEOMETRY_COUNT = 4096,
+	MATERIAL_COUNT = 2048,
+	SHADER_COUNT = 256,
+};
+
+static void _fill(RenderList &r_list, uint64_t p_seed) {
+	RandomPCG rng(p_seed);
+	r_list.clear();
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		RenderList::Element *e = r_list.add_element();
+		e->instance = nullptr;
+		e->material = nullptr;
+		e->surface_index = rng.rand() & 3;
+		e->sort_key = 0;
+		e->geometry_index = rng.rand() % GEOMETRY_COUNT;
+		e->material_index = rng.rand() % MATERIAL_COUNT;
+		e->shader_index = e->material_index % SHADER_COUNT;
+		e->uses_instancing = (rng.rand() & 15) == 0;
+		e->uses_lightmap = (rng.rand() & 7) == 0;
+		e->priority = 128;
+	}
+}
+
+// Sorted by key, and elements with the same key keep the order they were added in.
+static bool _check_sorted(const RenderList &p_list) {
+	for (int i = 1; i < p_list.element_count; i++) {
+		const RenderList::Element *a = p_list.elements[i - 1];
+		const RenderList::Element *b = p_list.elements[i];
+		if (a->sort_key > b->sort_key || (a->sort_key == b->sort_key && a > b)) {
+			OS::get_singleton()->print("\tout of order at %d\n", i);
+			return false;
+		}
+	}
+	return true;
+}
+
+static int _count_cached_orders(const RenderList &p_list) {
+	int count = 0;
+	for (int i = 0; i < RenderList::SORT_CACHE_MAX; i++) {
+		if (p_list.sort_cache[i].keys.size()) {
+			count++;
+		}
+	}
+	return count;
+}
+
+bool test_sort() {
+	OS::get_singleton()->print("\n\nTest 1: Sort by key\n");
+
+	RenderList list;
+	list.max_elements = ELEMENT_COUNT;
+	list.init();
+
+	_fill(list, 1);
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	list.sort_by_key(false);
+	OS::get_singleton()->print("\t%d elements sorted in %d usec\n", ELEMENT_COUNT, int(OS::get_singleton()->get_ticks_usec() - from));
+
+	return _check_sorted(list);
+}
+
+bool test_sort_cache() {
+	OS::get_singleton()->print("\n\nTest 2: Reuse the order of a repeated key sequence\n");
+
+	RenderList list;
+	list.max_elements = ELEMENT_COUNT;
+	list.init();
+
+	_fill(list, 2);
+	list.sort_by_key(false);
+	LocalVector<RenderList::Element *> first;
+	for (int i = 0; i < list.element_count; i++) {
+		first.push_back(list.elements[i]);
+	}
+
+	_fill(list, 2);
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	list.sort_by_key(false);
+	OS::get_singleton()->print("\t%d elements sorted from the cache in %d usec\n", ELEMENT_COUNT, int(OS::get_singleton()->get_ticks_usec() - from));
+
+	if (_count_cached_orders(list) != 1) {
+		OS::get_singleton()->print("\tthe same sequence was cached twice\n");
+		return false;
+	}
+	for (int i = 0; i < list.element_count; i++) {
+		if (list.elements[i] != first[i]) {
+			OS::get_singleton()->print("\tcached order differs at %d\n", i);
+			return false;
+		}
+	}
+	return _check_sorted(list);
+}
+
+bool test_sort_cache_invalidation() {
+	OS::get_singleton()->print("\n\nTest 3: Sort again when the key sequence changes\n");
+
+	RenderList list;
+	list.max_elements = ELEMENT_COUNT;
+	list.init();
+
+	_fill(list, 3);
+	list.sort_by_key(false);
+
+	// Same count, a single key changed, and it has to move to the other end.
+	_fill(list, 3);
+	list.base_elements[ELEMENT_COUNT / 2].priority = 0;
+	list.sort_by_key(false);
+	if (!_check_sorted(list) || list.elements[0] != &list.base_elements[ELEMENT_COUNT / 2]) {
+		OS::get_singleton()->print("\tstale order after changing a key\n");
+		return false;
+	}
+
+	// Same keys, one element fewer.
+	_fill(list, 3);
+	list.element_count--;
+	list.sort_by_key(false);
+	if (!_check_sorted(list)) {
+		OS::get_singleton()->print("\tstale order after removing an element\n");
+		return false;
+	}
+
+	return _count_cached_orders(list) == 3;
+}
+
+bool test_sort_cache_eviction() {
+	OS::get_singleton()->print("\n\nTest 4: Evict the least recently used order\n");
+
+	RenderList list;
+	list.max_elements = ELEMENT_COUNT;
+	list.init();
+
+	// One more sequence than the cache holds, the first one has to be sorted again.
+	for (int i = 0; i <= RenderList::SORT_CACHE_MAX; i++) {
+		_fill(list, 100 + i);
+		list.sort_by_key(false);
+	}
+	_fill(list, 100);
+	list.sort_by_key(false);
+
+	return _count_cached_orders(list) == RenderList::SORT_CACHE_MAX && _check_sorted(list);
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_sort,
+	test_sort_cache,
+	test_sort_cache_invalidation,
+	test_sort_cache_eviction,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestRenderList
@@ -0,0 +1,221 @@
+/*************************************************************************/
+/*  test_surface_tool.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_surface_tool.h"
+
+#include "core/os/os.h"
+#include "scene/resources/surface_tool.h"
+
+namespace TestSurfaceTool {
+
+// A flat grid of GRID_SIZE x GRID_SIZE quads on the XZ plane. With a seam, the
+// vertices of the middle column are duplicated and the right half of the grid
+// uses the copies, like a UV seam (same normals) or a hard edge (different
+// normals) would. The right half is mapped to its own UV island, shifted by one
+// in U.
+
+enum {
+	GRID_SIZE = 20,
+	SEAM_COLUMN = GRID_SIZE / 2,
+};
+
+struct Grid {
+	Vector<Vector3> vertices;
+	Vector<Vector3> normals;
+	Vector<Vector2> uvs;
+	Vector<int> indices;
+	int seam_start = -1; // first duplicated vertex
+};
+
+static Grid _make_grid(bool p_seam, const Vector3 &p_seam_normal) {
+	Grid grid;
+
+	for (int z = 0; z <= GRID_SIZE; z++) {
+		for (int x = 0; x <= GRID_SIZE; x++) {
+			grid.vertices.push_back(Vector3(x, 0, z));
+			grid.normals.push_back(Vector3(0, 1, 0));
+			grid.uvs.push_back(Vector2(float(x) / GRID_SIZE + (p_seam && x > SEAM_COLUMN ? 1 : 0), float(z) / GRID_SIZE));
+		}
+	}
+
+	if (p_seam) {
+		grid.seam_start = grid.vertices.size();
+		for (int z = 0; z <= GRID_SIZE; z++) {
+			grid.vertices.push_back(Vector3(SEAM_COLUMN, 0, z));
+			grid.normals.push_back(p_seam_normal);
+			grid.uvs.push_back(Vector2(float(SEAM_COLUMN) / GRID_SIZE + 1, float(z) / GRID_SIZE));
+		}
+	}
+
+	for (int z = 0; z < GRID_SIZE; z++) {
+		for (int x = 0; x < GRID_SIZE; x++) {
+			int corners[4] = {
+				z * (GRID_SIZE + 1) + x,
+				z * (GRID_SIZE + 1) + x + 1,
+				(z + 1) * (GRID_SIZE + 1) + x + 1,
+				(z + 1) * (GRID_SIZE + 1) + x,
+			};
+			if (p_seam && x == SEAM_COLUMN) {
+				corners[0] = grid.seam_start + z;
+				corners[3] = grid.seam_start + z + 1;
+			}
+
+			grid.indices.push_back(corners[0]);
+			grid.indices.push_back(corners[2]);
+			grid.indices.push_back(corners[1]);
+			grid.indices.push_back(corners[0]);
+			grid.indices.push_back(corners[3]);
+			grid.indices.push_back(corners[2]);
+		}
+	}
+
+	return grid;
+}
+
+// How many of the positions on the seam column are still used by the result.
+static int _count_seam_positions(const Grid &p_grid, const Vector<int> &p_indices) {
+	Vector<bool> used;
+	used.resize(GRID_SIZE + 1);
+	for (int i = 0; i <= GRID_SIZE; i++) {
+		used.write[i] = false;
+	}
+
+	for (int i = 0; i < p_indices.size(); i++) {
+		const Vector3 &v = p_grid.vertices[p_indices[i]];
+		if (v.x == SEAM_COLUMN) {
+			used.write[int(v.z)] = true;
+		}
+	}
+
+	int count = 0;
+	for (int i = 0; i <= GRID_SIZE; i++) {
+		count += used[i] ? 1 : 0;
+	}
+	return count;
+}
+
+// Whether every triangle of the result stays within one UV island and the
+// copies on the seam are still used, so no triangle samples the other half.
+static bool _check_uv_islands(const Grid &p_grid, const Vector<int> &p_indices) {
+	bool seam_copies_used = false;
+	for (int i = 0; i < p_indices.size(); i += 3) {
+		int island = p_grid.uvs[p_indices[i]].x >= 1 ? 1 : 0;
+		for (int j = 1; j < 3; j++) {
+			if ((p_grid.uvs[p_indices[i + j]].x >= 1 ? 1 : 0) != island) {
+				OS::get_singleton()->print("\ttriangle %d spans both UV islands\n", i / 3);
+				return false;
+			}
+		}
+		for (int j = 0; j < 3; j++) {
+			seam_copies_used = seam_copies_used || p_indices[i + j] >= p_grid.seam_start;
+		}
+	}
+
+	if (!seam_copies_used) {
+		OS::get_singleton()->print("\tthe seam copies are no longer used\n");
+	}
+	return seam_copies_used;
+}
+
+static bool _check_indices(const Grid &p_grid, const Vector<int> &p_indices) {
+	if (p_indices.size() == 0 || p_indices.size() % 3 != 0 || p_indices.size() >= p_grid.indices.size()) {
+		OS::get_singleton()->print("\tindex count went from %d to %d\n", p_grid.indices.size(), p_indices.size());
+		return false;
+	}
+	for (int i = 0; i < p_indices.size(); i++) {
+		if (p_indices[i] < 0 || p_indices[i] >= p_grid.vertices.size()) {
+			OS::get_singleton()->print("\tindex %d out of range\n", p_indices[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool test_simplify() {
+	OS::get_singleton()->print("\n\nTest 1: Simplify a flat grid\n");
+
+	Grid grid = _make_grid(false, Vector3());
+	float error = -1;
+	Vector<int> result = SurfaceTool::simplify_indices(grid.vertices, grid.normals, grid.indices, grid.indices.size() / 2, 1e20, &error);
+
+	// The grid is flat, so no collapse moves the surface.
+	return _check_indices(grid, result) && error >= 0 && error < CMP_EPSILON;
+}
+
+bool test_simplify_uv_seam() {
+	OS::get_singleton()->print("\n\nTest 2: Simplify across a seam with matching normals\n");
+
+	Grid grid = _make_grid(true, Vector3(0, 1, 0));
+	Vector<int> result = SurfaceTool::simplify_indices(grid.vertices, grid.normals, grid.indices, 0, 1e20);
+
+	// Only the ends of the seam are on the open border, the rest can go.
+	return _check_indices(grid, result) && _check_uv_islands(grid, result) && _count_seam_positions(grid, result) < GRID_SIZE + 1;
+}
+
+bool test_simplify_hard_edge() {
+	OS::get_singleton()->print("\n\nTest 3: Keep a seam with different normals\n");
+
+	Grid grid = _make_grid(true, Vector3(1, 0, 0));
+	Vector<int> result = SurfaceTool::simplify_indices(grid.vertices, grid.normals, grid.indices, 0, 1e20);
+
+	return _check_indices(grid, result) && _count_seam_positions(grid, result) == GRID_SIZE + 1;
+}
+
+typedef bool (*TestFunc)();
+
+TestFunc test_funcs[] = {
+	test_simplify,
+	test_simplify_uv_seam,
+	test_simplify_hard_edge,
+	nullptr
+};
+
+MainLoop *test() {
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count]) {
+			break;
+		}
+		bool pass = test_funcs[count]();
+		if (pass) {
+			passed++;
+		}
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return nullptr;
+}
+
+} // namespace TestSurfaceTool
@@ -210,6 +210,22 @@ PhysicsDirectSpaceState3D *BulletPhysicsServer3D::space_get_direct_state(RID p_s
 	return space->get_direct_state();
 }
 
+void BulletPhysicsServer3D::space_set_deterministic(RID p_space, bool p_enable) {
+	ERR_FAIL_COND_MSG(p_enable, "Deterministic stepping is not supported by Bullet physics.");
+}
+
+bool BulletPhysicsServer3D::space_is_deterministic(RID p_space) const {
+	return false;
+}
+
+Vector<uint8_t> BulletPhysicsServer3D::space_get_snapshot(RID p_space) const {
+	ERR_FAIL_V_MSG(Vector<uint8_t>(), "Space snapshots are not supported by Bullet physics.");
+}
+
+Error BulletPhysicsServer3D::space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Space snapshots are not supported by Bullet physics.");
+}
+
 void BulletPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	SpaceBullet *space = space_owner.getornull(p_space);
 	ERR_FAIL_COND(!space);
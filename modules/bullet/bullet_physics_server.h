@@ -114,6 +114,15 @@ public:
 
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space);
 
+	/// Not supported
+	virtual void space_set_deterministic(RID p_space, bool p_enable);
+	/// Not supported
+	virtual bool space_is_deterministic(RID p_space) const;
+	/// Not supported
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const;
+	/// Not supported
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot);
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const;
 	virtual int space_get_contact_count(RID p_space) const;
@@ -188,6 +188,16 @@ float GeometryInstance3D::get_lod_max_hysteresis() const {
 	return lod_max_hysteresis;
 }
 
+void GeometryInstance3D::set_lod_bias(float p_bias) {
+	ERR_FAIL_COND(p_bias <= 0.0);
+	lod_bias = p_bias;
+	RS::get_singleton()->instance_geometry_set_lod_bias(get_instance(), lod_bias);
+}
+
+float GeometryInstance3D::get_lod_bias() const {
+	return lod_bias;
+}
+
 void GeometryInstance3D::_notification(int p_what) {
 }
 
@@ -352,6 +362,9 @@ void GeometryInstance3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_lod_min_distance", "mode"), &GeometryInstance3D::set_lod_min_distance);
 	ClassDB::bind_method(D_METHOD("get_lod_min_distance"), &GeometryInstance3D::get_lod_min_distance);
 
+	ClassDB::bind_method(D_METHOD("set_lod_bias", "bias"), &GeometryInstance3D::set_lod_bias);
+	ClassDB::bind_method(D_METHOD("get_lod_bias"), &GeometryInstance3D::get_lod_bias);
+
 	ClassDB::bind_method(D_METHOD("set_extra_cull_margin", "margin"), &GeometryInstance3D::set_extra_cull_margin);
 	ClassDB::bind_method(D_METHOD("get_extra_cull_margin"), &GeometryInstance3D::get_extra_cull_margin);
 
@@ -378,6 +391,7 @@ void GeometryInstance3D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_min_hysteresis", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_min_hysteresis", "get_lod_min_hysteresis");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_distance", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_max_distance", "get_lod_max_distance");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_hysteresis", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_max_hysteresis", "get_lod_max_hysteresis");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_bias", PROPERTY_HINT_RANGE, "0.001,128,0.001"), "set_lod_bias", "get_lod_bias");
 
 	//ADD_SIGNAL( MethodInfo("visibility_changed"));
 
@@ -402,6 +416,7 @@ GeometryInstance3D::GeometryInstance3D() {
 	lod_max_distance = 0;
 	lod_min_hysteresis = 0;
 	lod_max_hysteresis = 0;
+	lod_bias = 1.0;
 
 	gi_mode = GI_MODE_DISABLED;
 	lightmap_scale = LIGHTMAP_SCALE_1X;
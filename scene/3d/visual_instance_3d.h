@@ -111,6 +111,7 @@ private:
 	float lod_max_distance;
 	float lod_min_hysteresis;
 	float lod_max_hysteresis;
+	float lod_bias;
 
 	mutable HashMap<StringName, Variant> instance_uniforms;
 	mutable HashMap<StringName, StringName> instance_uniform_property_remap;
@@ -145,6 +146,9 @@ public:
 	void set_lod_max_hysteresis(float p_dist);
 	float get_lod_max_hysteresis() const;
 
+	void set_lod_bias(float p_bias);
+	float get_lod_bias() const;
+
 	void set_material_override(const Ref<Material> &p_material);
 	Ref<Material> get_material_override() const;
 
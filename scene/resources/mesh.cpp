@@ -1505,6 +1505,82 @@ Error ArrayMesh::lightmap_unwrap_cached(int *&r_cache_data, unsigned int &r_cach
 	return OK;
 }
 
+void ArrayMesh::generate_lods() {
+	if (surfaces.size() == 0) {
+		return;
+	}
+
+	Vector<RS::SurfaceData> surface_data;
+	Vector<Ref<Material>> surface_materials;
+	Vector<String> surface_names;
+
+	for (int i = 0; i < surfaces.size(); i++) {
+		RS::SurfaceData sd = RS::get_singleton()->mesh_get_surface(mesh, i);
+
+		if (sd.primitive == RS::PRIMITIVE_TRIANGLES && sd.index_count > 0 && !(sd.format & ARRAY_FLAG_USE_2D_VERTICES)) {
+			Array arrays = surface_get_arrays(i);
+			Vector<Vector3> vertices = arrays[ARRAY_VERTEX];
+			Vector<Vector3> normals = arrays[ARRAY_NORMAL];
+			Vector<int> indices = arrays[ARRAY_INDEX];
+
+			sd.lods.clear();
+
+			// Each LOD halves the triangle count of the previous one, all are simplified from the full mesh so errors don't pile up.
+			int index_count = indices.size();
+			float error = 0.0;
+
+			while (sd.lods.size() < MESH_MAX_LODS) {
+				int target_index_count = (index_count / 6) * 3;
+				if (target_index_count < MESH_MIN_LOD_INDICES) {
+					break;
+				}
+
+				float lod_error = 0.0;
+				Vector<int> lod_indices = SurfaceTool::simplify_indices(vertices, normals, indices, target_index_count, 1e20, &lod_error);
+				if (lod_indices.size() > index_count * 3 / 4) {
+					break; // stuck on seams and borders, more LODs would barely save anything
+				}
+
+				error = MAX(error, lod_error);
+
+				RS::SurfaceData::LOD lod;
+				lod.edge_length = error;
+
+				const int *r = lod_indices.ptr();
+				if (sd.vertex_count <= 65536) {
+					lod.index_data.resize(lod_indices.size() * 2);
+					uint16_t *w = (uint16_t *)lod.index_data.ptrw();
+					for (int j = 0; j < lod_indices.size(); j++) {
+						w[j] = r[j];
+					}
+				} else {
+					lod.index_data.resize(lod_indices.size() * 4);
+					uint32_t *w = (uint32_t *)lod.index_data.ptrw();
+					for (int j = 0; j < lod_indices.size(); j++) {
+						w[j] = r[j];
+					}
+				}
+
+				sd.lods.push_back(lod);
+				index_count = lod_indices.size();
+			}
+		}
+
+		surface_data.push_back(sd);
+		surface_materials.push_back(surface_get_material(i));
+		surface_names.push_back(surface_get_name(i));
+	}
+
+	clear_surfaces();
+
+	for (int i = 0; i < surface_data.size(); i++) {
+		const RS::SurfaceData &sd = surface_data[i];
+		add_surface(sd.format, PrimitiveType(sd.primitive), sd.vertex_data, sd.vertex_count, sd.index_data, sd.index_count, sd.aabb, sd.blend_shapes, sd.bone_aabbs, sd.lods);
+		surface_set_material(i, surface_materials[i]);
+		surface_set_name(i, surface_names[i]);
+	}
+}
+
 void ArrayMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_blend_shape", "name"), &ArrayMesh::add_blend_shape);
 	ClassDB::bind_method(D_METHOD("get_blend_shape_count"), &ArrayMesh::get_blend_shape_count);
@@ -1530,6 +1606,8 @@ void ArrayMesh::_bind_methods() {
 	ClassDB::set_method_flags(get_class_static(), _scs_create("regen_normalmaps"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("lightmap_unwrap", "transform", "texel_size"), &ArrayMesh::lightmap_unwrap);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("lightmap_unwrap"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
+	ClassDB::bind_method(D_METHOD("generate_lods"), &ArrayMesh::generate_lods);
+	ClassDB::set_method_flags(get_class_static(), _scs_create("generate_lods"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("get_faces"), &ArrayMesh::get_faces);
 	ClassDB::bind_method(D_METHOD("generate_triangle_mesh"), &ArrayMesh::generate_triangle_mesh);
 
@@ -155,6 +155,11 @@ class ArrayMesh : public Mesh {
 	GDCLASS(ArrayMesh, Mesh);
 	RES_BASE_EXTENSION("mesh");
 
+	enum {
+		MESH_MAX_LODS = 8,
+		MESH_MIN_LOD_INDICES = 3 * 32,
+	};
+
 	Array _get_surfaces() const;
 	void _set_surfaces(const Array &p_data);
 
@@ -239,6 +244,8 @@ public:
 	Error lightmap_unwrap(const Transform &p_base_transform = Transform(), float p_texel_size = 0.05);
 	Error lightmap_unwrap_cached(int *&r_cache_data, unsigned int &r_cache_size, bool &r_used_cache, const Transform &p_base_transform = Transform(), float p_texel_size = 0.05);
 
+	void generate_lods();
+
 	virtual void reload_from_file();
 
 	ArrayMesh();
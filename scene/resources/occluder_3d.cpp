@@ -0,0 +1,109 @@
+/*************************************************************************/
+/*  occluder_3d.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "occluder_3d.h"
+
+#include "servers/rendering_server.h"
+
+void Occluder3D::_queue_update() {
+	// vertices and indices are usually set one after the other, only send the mesh once
+	if (update_pending) {
+		return;
+	}
+
+	update_pending = true;
+	call_deferred("_update");
+}
+
+void Occluder3D::_update() {
+	update_pending = false;
+
+	// the server validates the indices, only hand it complete triangles
+	if (indices.size() % 3 == 0) {
+		RS::get_singleton()->occluder_set_mesh(occluder, vertices, indices);
+	}
+	emit_changed();
+}
+
+void Occluder3D::set_vertices(const PackedVector3Array &p_vertices) {
+	vertices = p_vertices;
+	_queue_update();
+}
+
+PackedVector3Array Occluder3D::get_vertices() const {
+	return vertices;
+}
+
+void Occluder3D::set_indices(const PackedInt32Array &p_indices) {
+	indices = p_indices;
+	_queue_update();
+}
+
+PackedInt32Array Occluder3D::get_indices() const {
+	return indices;
+}
+
+AABB Occluder3D::get_aabb() const {
+	AABB aabb;
+	const Vector3 *ptr = vertices.ptr();
+	for (int i = 0; i < vertices.size(); i++) {
+		if (i == 0) {
+			aabb.position = ptr[i];
+		} else {
+			aabb.expand_to(ptr[i]);
+		}
+	}
+	return aabb;
+}
+
+RID Occluder3D::get_rid() const {
+	return occluder;
+}
+
+void Occluder3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("_update"), &Occluder3D::_update);
+
+	ClassDB::bind_method(D_METHOD("set_vertices", "vertices"), &Occluder3D::set_vertices);
+	ClassDB::bind_method(D_METHOD("get_vertices"), &Occluder3D::get_vertices);
+
+	ClassDB::bind_method(D_METHOD("set_indices", "indices"), &Occluder3D::set_indices);
+	ClassDB::bind_method(D_METHOD("get_indices"), &Occluder3D::get_indices);
+
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_VECTOR3_ARRAY, "vertices"), "set_vertices", "get_vertices");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_INT32_ARRAY, "indices"), "set_indices", "get_indices");
+}
+
+Occluder3D::Occluder3D() {
+	occluder = RS::get_singleton()->occluder_create();
+}
+
+Occluder3D::~Occluder3D() {
+	RS::get_singleton()->free(occluder);
+}
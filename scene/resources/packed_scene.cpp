@@ -84,8 +84,15 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	Map<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
 
+	//the editor tracks edits done through Object::set, so only take the shortcut at runtime
+	bool use_setter_cache = p_edit_state == GEN_EDIT_STATE_DISABLED;
+	if (use_setter_cache) {
+		_update_setter_cache();
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
+		bool use_setters = false;
 
 		Node *parent = nullptr;
 
@@ -169,6 +176,7 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 			}
 
 			node = Object::cast_to<Node>(obj);
+			use_setters = use_setter_cache && node->get_class_name() == snames[n.type]; //not a fallback or compat class
 
 		} else {
 			//print_line("Class is disabled for: " + itos(n.type));
@@ -240,6 +248,23 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
+
+						if (use_setters && !node->get_script_instance()) { //scripts may override properties
+							const PropertySetter &ps = setter_cache[setter_cache_offsets[i] + j];
+							if (ps.setter) {
+								Callable::CallError ce;
+								if (ps.index >= 0) {
+									Variant index = ps.index;
+									const Variant *args[2] = { &index, &value };
+									ps.setter->call(node, args, 2, ce);
+								} else {
+									const Variant *args[1] = { &value };
+									ps.setter->call(node, args, 1, ce);
+								}
+								continue;
+							}
+						}
+
 						node->set(snames[nprops[j].name], value, &valid);
 					}
 				}
@@ -896,7 +921,45 @@ String SceneState::get_path() const {
 	return path;
 }
 
+void SceneState::_update_setter_cache() const {
+	MutexLock lock(setter_cache_mutex);
+
+	if (setter_cache_valid) {
+		return;
+	}
+
+	setter_cache.clear();
+	setter_cache_offsets.resize(nodes.size());
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		setter_cache_offsets[i] = setter_cache.size();
+
+		//only nodes created from their class here, instanced and inherited ones are set through Object::set
+		bool from_class = n.type != TYPE_INSTANCED && n.instance < 0 && !(i == 0 && base_scene_idx >= 0) && n.type >= 0 && n.type < names.size();
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			PropertySetter ps;
+			int name = n.properties[j].name;
+			if (from_class && name >= 0 && name < names.size() && names[name] != CoreStringNames::get_singleton()->_script) {
+				ps.setter = ClassDB::get_property_setter_bind(names[n.type], names[name], &ps.index);
+			}
+			setter_cache.push_back(ps);
+		}
+	}
+
+	setter_cache_valid = true;
+}
+
+void SceneState::_clear_setter_cache() {
+	MutexLock lock(setter_cache_mutex);
+	setter_cache_valid = false;
+	setter_cache.clear();
+	setter_cache_offsets.clear();
+}
+
 void SceneState::clear() {
+	_clear_setter_cache();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1045,6 +1108,7 @@ bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_
 }
 
 void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
+	_clear_setter_cache();
 	ERR_FAIL_COND(!p_dictionary.has("names"));
 	ERR_FAIL_COND(!p_dictionary.has("variants"));
 	ERR_FAIL_COND(!p_dictionary.has("node_count"));
@@ -1507,6 +1571,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_setter_cache();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -1520,6 +1585,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	NodeData::Property prop;
 	prop.name = p_name;
 	prop.value = p_value;
+	_clear_setter_cache();
 	nodes.write[p_node].properties.push_back(prop);
 }
 
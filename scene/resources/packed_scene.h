@@ -31,6 +31,8 @@
 #ifndef PACKED_SCENE_H
 #define PACKED_SCENE_H
 
+#include "core/local_vector.h"
+#include "core/os/mutex.h"
 #include "core/resource.h"
 #include "scene/main/node.h"
 
@@ -88,6 +90,23 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	// Setters of the node properties, resolved once so instancing at runtime calls them directly
+	// instead of looking each one up by name through Object::set, for every node of every instance.
+	// Flat, in the same order as the properties of all nodes. Read only once built, so instancing
+	// from several threads at once is fine.
+	struct PropertySetter {
+		MethodBind *setter = nullptr; //null if it must go through Object::set
+		int index = -1;
+	};
+
+	mutable Mutex setter_cache_mutex;
+	mutable bool setter_cache_valid = false;
+	mutable LocalVector<PropertySetter> setter_cache;
+	mutable LocalVector<uint32_t> setter_cache_offsets; //first setter of each node
+
+	void _update_setter_cache() const;
+	void _clear_setter_cache();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
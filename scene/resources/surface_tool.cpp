@@ -30,6 +30,7 @@
 
 #include "surface_tool.h"
 
+#include "core/local_vector.h"
 #include "core/method_bind_ext.gen.inc"
 
 #define _VERTEX_SNAP 0.0001
@@ -963,6 +964,408 @@ void SurfaceTool::generate_normals(bool p_flip) {
 	}
 }
 
+// Quadric error metric of a set of planes weighted by triangle area, the error of a point is its mean squared distance to them.
+struct SimplifyQuadric {
+	double a2 = 0, ab = 0, ac = 0, ad = 0;
+	double b2 = 0, bc = 0, bd = 0;
+	double c2 = 0, cd = 0;
+	double d2 = 0;
+	double weight = 0;
+
+	void add_plane(const Plane &p_plane, double p_weight) {
+		double a = p_plane.normal.x;
+		double b = p_plane.normal.y;
+		double c = p_plane.normal.z;
+		double d = -p_plane.d;
+
+		a2 += p_weight * a * a;
+		ab += p_weight * a * b;
+		ac += p_weight * a * c;
+		ad += p_weight * a * d;
+		b2 += p_weight * b * b;
+		bc += p_weight * b * c;
+		bd += p_weight * b * d;
+		c2 += p_weight * c * c;
+		cd += p_weight * c * d;
+		d2 += p_weight * d * d;
+		weight += p_weight;
+	}
+
+	void operator+=(const SimplifyQuadric &p_q) {
+		a2 += p_q.a2;
+		ab += p_q.ab;
+		ac += p_q.ac;
+		ad += p_q.ad;
+		b2 += p_q.b2;
+		bc += p_q.bc;
+		bd += p_q.bd;
+		c2 += p_q.c2;
+		cd += p_q.cd;
+		d2 += p_q.d2;
+		weight += p_q.weight;
+	}
+
+	double get_error(const Vector3 &p_point, const SimplifyQuadric &p_other) const {
+		double x = p_point.x;
+		double y = p_point.y;
+		double z = p_point.z;
+		double err = (a2 + p_other.a2) * x * x + 2.0 * (ab + p_other.ab) * x * y + 2.0 * (ac + p_other.ac) * x * z + 2.0 * (ad + p_other.ad) * x +
+					 (b2 + p_other.b2) * y * y + 2.0 * (bc + p_other.bc) * y * z + 2.0 * (bd + p_other.bd) * y +
+					 (c2 + p_other.c2) * z * z + 2.0 * (cd + p_other.cd) * z +
+					 (d2 + p_other.d2);
+		double w = weight + p_other.weight;
+		return w > 0.0 ? MAX(err / w, 0.0) : 0.0;
+	}
+};
+
+// Normals of vertices split by a seam that are closer than this (about 2.5 degrees) count as the same.
+#define SIMPLIFY_SEAM_NORMAL_DOT 0.999
+
+struct SimplifyCollapse {
+	double error;
+	uint32_t from;
+	uint32_t to;
+
+	bool operator<(const SimplifyCollapse &p_other) const {
+		return error < p_other.error;
+	}
+};
+
+// The triangles along the edge from a to b tell which original vertex of b each original vertex of a becomes, as
+// (from, to) pairs. A copy of a on a side of a seam with no triangle along the edge would take the attributes of the
+// other side, so a can't collapse onto b.
+static bool _simplify_remap_corners(uint32_t p_a, uint32_t p_b, const LocalVector<uint32_t> &p_a_triangles, const LocalVector<uint32_t> &p_triangles, const LocalVector<uint32_t> &p_corners, const LocalVector<bool> &p_triangle_removed, LocalVector<uint32_t> &r_remap) {
+	r_remap.clear();
+	for (uint32_t j = 0; j < p_a_triangles.size(); j++) {
+		uint32_t t = p_a_triangles[j];
+		if (p_triangle_removed[t]) {
+			continue;
+		}
+		const uint32_t *tri = &p_triangles[t * 3];
+		for (uint32_t k = 0; k < 3; k++) {
+			if (tri[k] != p_b) {
+				continue;
+			}
+			uint32_t from = p_corners[t * 3 + (tri[(k + 1) % 3] == p_a ? (k + 1) % 3 : (k + 2) % 3)];
+			uint32_t to = p_corners[t * 3 + k];
+			uint32_t r = 0;
+			while (r < r_remap.size() && r_remap[r] != from) {
+				r += 2;
+			}
+			if (r == r_remap.size()) {
+				r_remap.push_back(from);
+				r_remap.push_back(to);
+			} else if (r_remap[r + 1] != to) {
+				return false;
+			}
+		}
+	}
+
+	for (uint32_t j = 0; j < p_a_triangles.size(); j++) {
+		uint32_t t = p_a_triangles[j];
+		if (p_triangle_removed[t]) {
+			continue;
+		}
+		for (uint32_t k = 0; k < 3; k++) {
+			if (p_triangles[t * 3 + k] != p_a) {
+				continue;
+			}
+			uint32_t r = 0;
+			while (r < r_remap.size() && r_remap[r] != p_corners[t * 3 + k]) {
+				r += 2;
+			}
+			if (r == r_remap.size()) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+Vector<int> SurfaceTool::simplify_indices(const Vector<Vector3> &p_vertices, const Vector<Vector3> &p_normals, const Vector<int> &p_indices, int p_target_index_count, float p_max_error, float *r_error) {
+	ERR_FAIL_COND_V(p_indices.size() % 3 != 0, Vector<int>());
+	ERR_FAIL_COND_V(p_normals.size() != 0 && p_normals.size() != p_vertices.size(), Vector<int>());
+
+	const uint32_t vertex_count = p_vertices.size();
+	const uint32_t triangle_count = p_indices.size() / 3;
+	const Vector3 *positions = p_vertices.ptr();
+	const Vector3 *normals = p_normals.size() ? p_normals.ptr() : nullptr;
+
+	// Vertices split by attribute seams share a position, collapses work on welded positions to keep those seams closed.
+	// Seams where the normals match (only UVs or other attributes differ) are merged into one vertex for the topology and
+	// the error instead, so they can be simplified like the rest of the surface, only hard edges stay locked. The output
+	// keeps using the original vertices, each on its own side of the seam.
+	LocalVector<uint32_t> merge;
+	LocalVector<uint32_t> weld;
+	LocalVector<uint32_t> weld_users;
+	merge.resize(vertex_count);
+	weld.resize(vertex_count);
+	{
+		Map<Vector3, uint32_t> weld_map;
+		LocalVector<LocalVector<uint32_t>> weld_vertices;
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			merge[i] = i;
+			Map<Vector3, uint32_t>::Element *E = weld_map.find(positions[i]);
+			if (!E) {
+				weld[i] = weld_users.size();
+				weld_map.insert(positions[i], weld[i]);
+				weld_users.push_back(1);
+				weld_vertices.push_back(LocalVector<uint32_t>());
+				weld_vertices[weld[i]].push_back(i);
+				continue;
+			}
+
+			uint32_t w = E->get();
+			weld[i] = w;
+			if (normals) {
+				for (uint32_t j = 0; j < weld_vertices[w].size(); j++) {
+					if (normals[i].dot(normals[weld_vertices[w][j]]) >= SIMPLIFY_SEAM_NORMAL_DOT) {
+						merge[i] = weld_vertices[w][j];
+						break;
+					}
+				}
+			}
+			if (merge[i] == i) {
+				weld_users[w]++;
+				weld_vertices[w].push_back(i);
+			}
+		}
+	}
+
+	LocalVector<uint32_t> triangles;
+	LocalVector<uint32_t> corners;
+	triangles.resize(triangle_count * 3);
+	corners.resize(triangle_count * 3);
+	for (uint32_t i = 0; i < triangle_count * 3; i++) {
+		ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_indices[i], vertex_count, Vector<int>());
+		triangles[i] = merge[p_indices[i]];
+		corners[i] = p_indices[i];
+	}
+
+	// Seam vertices and vertices on open or non-manifold edges never move, so the outline of the mesh is kept.
+	LocalVector<bool> locked;
+	locked.resize(vertex_count);
+	{
+		LocalVector<bool> weld_locked;
+		weld_locked.resize(weld_users.size());
+		for (uint32_t i = 0; i < weld_users.size(); i++) {
+			weld_locked[i] = weld_users[i] > 1;
+		}
+
+		Map<uint64_t, uint32_t> edges;
+		for (uint32_t i = 0; i < triangle_count * 3; i++) {
+			uint32_t a = weld[triangles[i]];
+			uint32_t b = weld[triangles[i - i % 3 + (i + 1) % 3]];
+			uint64_t key = a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+			Map<uint64_t, uint32_t>::Element *E = edges.find(key);
+			if (E) {
+				E->get()++;
+			} else {
+				edges.insert(key, 1);
+			}
+		}
+
+		for (Map<uint64_t, uint32_t>::Element *E = edges.front(); E; E = E->next()) {
+			if (E->get() != 2) {
+				weld_locked[E->key() >> 32] = true;
+				weld_locked[E->key() & 0xFFFFFFFF] = true;
+			}
+		}
+
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			locked[i] = weld_locked[weld[i]];
+		}
+	}
+
+	LocalVector<SimplifyQuadric> quadrics;
+	quadrics.resize(vertex_count);
+	LocalVector<LocalVector<uint32_t>> vertex_triangles;
+	vertex_triangles.resize(vertex_count);
+	LocalVector<bool> triangle_removed;
+	triangle_removed.resize(triangle_count);
+
+	for (uint32_t i = 0; i < triangle_count; i++) {
+		triangle_removed[i] = false;
+		const Vector3 &p0 = positions[triangles[i * 3 + 0]];
+		const Vector3 &p1 = positions[triangles[i * 3 + 1]];
+		const Vector3 &p2 = positions[triangles[i * 3 + 2]];
+		double area = (p1 - p0).cross(p2 - p0).length() * 0.5;
+		Plane plane(p0, p1, p2);
+		for (uint32_t j = 0; j < 3; j++) {
+			uint32_t v = triangles[i * 3 + j];
+			vertex_triangles[v].push_back(i);
+			if (area > 0.0) {
+				quadrics[v].add_plane(plane, area);
+			}
+		}
+	}
+
+	LocalVector<uint32_t> touched_pass;
+	touched_pass.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		touched_pass[i] = 0;
+	}
+
+	uint32_t index_count = triangle_count * 3;
+	const uint32_t target_index_count = MAX(p_target_index_count, 0);
+	const double max_error_sq = double(p_max_error) * double(p_max_error);
+	double result_error_sq = 0;
+	uint32_t pass = 0;
+
+	LocalVector<SimplifyCollapse> collapses;
+	LocalVector<uint32_t> corner_remap; // pairs of original vertices of a and b on the same side of the seams
+
+	while (index_count > target_index_count) {
+		pass++;
+
+		// Find the cheapest collapse of every free vertex onto one of its neighbors.
+		collapses.clear();
+		for (uint32_t a = 0; a < vertex_count; a++) {
+			if (locked[a] || vertex_triangles[a].empty()) {
+				continue;
+			}
+
+			SimplifyCollapse best;
+			best.error = 1e100;
+			best.from = a;
+			best.to = a;
+
+			for (uint32_t j = 0; j < vertex_triangles[a].size(); j++) {
+				uint32_t t = vertex_triangles[a][j];
+				if (triangle_removed[t]) {
+					continue;
+				}
+				for (uint32_t k = 0; k < 3; k++) {
+					uint32_t b = triangles[t * 3 + k];
+					if (b == a) {
+						continue;
+					}
+					double error = quadrics[a].get_error(positions[b], quadrics[b]);
+					if (error < best.error && _simplify_remap_corners(a, b, vertex_triangles[a], triangles, corners, triangle_removed, corner_remap)) {
+						best.error = error;
+						best.to = b;
+					}
+				}
+			}
+
+			if (best.to != a && best.error <= max_error_sq) {
+				collapses.push_back(best);
+			}
+		}
+
+		if (collapses.empty()) {
+			break;
+		}
+
+		collapses.sort();
+
+		// Apply them in order of cost, a vertex whose neighborhood already changed in this pass waits for the next one.
+		uint32_t applied = 0;
+		for (uint32_t i = 0; i < collapses.size() && index_count > target_index_count; i++) {
+			const SimplifyCollapse &collapse = collapses[i];
+			uint32_t a = collapse.from;
+			uint32_t b = collapse.to;
+
+			if (touched_pass[a] == pass || touched_pass[b] == pass) {
+				continue;
+			}
+
+			LocalVector<uint32_t> &a_triangles = vertex_triangles[a];
+			bool valid = true;
+
+			if (!_simplify_remap_corners(a, b, a_triangles, triangles, corners, triangle_removed, corner_remap)) {
+				continue;
+			}
+
+			for (uint32_t j = 0; j < a_triangles.size() && valid; j++) {
+				uint32_t t = a_triangles[j];
+				if (triangle_removed[t]) {
+					continue;
+				}
+				const uint32_t *tri = &triangles[t * 3];
+				if (weld[tri[0]] == weld[b] || weld[tri[1]] == weld[b] || weld[tri[2]] == weld[b]) {
+					continue; // collapses away
+				}
+				if (touched_pass[tri[0]] == pass || touched_pass[tri[1]] == pass || touched_pass[tri[2]] == pass) {
+					valid = false;
+					break;
+				}
+
+				// reject collapses that flip or squash a remaining triangle
+				Vector3 p[3] = { positions[tri[0]], positions[tri[1]], positions[tri[2]] };
+				Vector3 normal_before = (p[1] - p[0]).cross(p[2] - p[0]);
+				for (uint32_t k = 0; k < 3; k++) {
+					if (tri[k] == a) {
+						p[k] = positions[b];
+					}
+				}
+				Vector3 normal_after = (p[1] - p[0]).cross(p[2] - p[0]);
+				if (normal_before.dot(normal_after) <= 0.2 * normal_before.length() * normal_after.length()) {
+					valid = false;
+				}
+			}
+
+			if (!valid) {
+				continue;
+			}
+
+			for (uint32_t j = 0; j < a_triangles.size(); j++) {
+				uint32_t t = a_triangles[j];
+				if (triangle_removed[t]) {
+					continue;
+				}
+				uint32_t *tri = &triangles[t * 3];
+				for (uint32_t k = 0; k < 3; k++) {
+					touched_pass[tri[k]] = pass;
+					if (tri[k] == a) {
+						tri[k] = b;
+						uint32_t r = 0;
+						while (corner_remap[r] != corners[t * 3 + k]) {
+							r += 2;
+						}
+						corners[t * 3 + k] = corner_remap[r + 1];
+					}
+				}
+
+				if (weld[tri[0]] == weld[tri[1]] || weld[tri[1]] == weld[tri[2]] || weld[tri[2]] == weld[tri[0]]) {
+					triangle_removed[t] = true;
+					index_count -= 3;
+				} else {
+					vertex_triangles[b].push_back(t);
+				}
+			}
+
+			quadrics[b] += quadrics[a];
+			a_triangles.clear();
+			result_error_sq = MAX(result_error_sq, collapse.error);
+			applied++;
+		}
+
+		if (applied == 0) {
+			break;
+		}
+	}
+
+	Vector<int> result;
+	result.resize(index_count);
+	int *w = result.ptrw();
+	uint32_t idx = 0;
+	for (uint32_t i = 0; i < triangle_count; i++) {
+		if (!triangle_removed[i]) {
+			w[idx++] = corners[i * 3 + 0];
+			w[idx++] = corners[i * 3 + 1];
+			w[idx++] = corners[i * 3 + 2];
+		}
+	}
+
+	if (r_error) {
+		*r_error = Math::sqrt(result_error_sq);
+	}
+
+	return result;
+}
+
 void SurfaceTool::set_material(const Ref<Material> &p_material) {
 	material = p_material;
 }
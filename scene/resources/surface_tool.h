@@ -124,6 +124,9 @@ public:
 	void generate_normals(bool p_flip = false);
 	void generate_tangents();
 
+	// Quadric edge collapse, returns an index buffer with at most p_target_index_count indices when the error allows it.
+	static Vector<int> simplify_indices(const Vector<Vector3> &p_vertices, const Vector<Vector3> &p_normals, const Vector<int> &p_indices, int p_target_index_count, float p_max_error, float *r_error = nullptr);
+
 	void set_material(const Ref<Material> &p_material);
 
 	void clear();
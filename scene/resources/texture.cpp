@@ -31,9 +31,13 @@
 #include "texture.h"
 
 #include "core/core_string_names.h"
+#include "core/engine.h"
 #include "core/io/image_loader.h"
+#include "core/local_vector.h"
+#include "core/message_queue.h"
 #include "core/method_bind_ext.gen.inc"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "mesh.h"
 #include "scene/resources/bit_map.h"
 #include "servers/camera/camera_feed.h"
@@ -358,7 +362,7 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -431,26 +435,25 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 				}
 			}
 
-			image->create(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->create(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
 	} else if (data_format == DATA_FORMAT_IMAGE) {
 		int size = Image::get_image_data_size(w, h, format, mipmaps ? true : false);
+		size_t data_pos = f->get_position();
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
+			f->seek(data_pos + ofs);
 
 			{
 				uint8_t *wr = data.ptrw();
@@ -502,11 +505,21 @@ StreamTexture2D::TextureFormatRequestCallback StreamTexture2D::request_3d_callba
 StreamTexture2D::TextureFormatRoughnessRequestCallback StreamTexture2D::request_roughness_callback = nullptr;
 StreamTexture2D::TextureFormatRequestCallback StreamTexture2D::request_normal_callback = nullptr;
 
+Mutex StreamTexture2D::stream_mutex;
+Semaphore StreamTexture2D::stream_semaphore;
+Thread *StreamTexture2D::stream_thread = nullptr;
+bool StreamTexture2D::stream_exit = false;
+HashMap<uint32_t, StreamTexture2D *> StreamTexture2D::stream_textures;
+uint32_t StreamTexture2D::stream_last_id = 0;
+uint64_t StreamTexture2D::stream_budget = 0;
+uint64_t StreamTexture2D::stream_used = 0;
+int StreamTexture2D::stream_resident_size = 0;
+
 Image::Format StreamTexture2D::get_format() const {
 	return format;
 }
 
-Error StreamTexture2D::_load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
+Error StreamTexture2D::_load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int &r_stream_width, int &r_stream_height, int &r_stream_mipmaps, int p_size_limit) {
 	alpha_cache.unref();
 
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
@@ -551,7 +564,19 @@ Error StreamTexture2D::_load_data(const String &p_path, int &tw, int &th, int &t
 	r_request_normal = false;
 
 #endif
-	if (!(df & FORMAT_BIT_STREAM)) {
+	r_stream_width = 0;
+	r_stream_height = 0;
+	r_stream_mipmaps = 0;
+
+	if ((df & FORMAT_BIT_STREAM) && (df & FORMAT_BIT_HAS_MIPMAPS)) {
+		//peek at the data header, the size of the full image is needed to stream the rest later
+		size_t data_pos = f->get_position();
+		f->get_32(); //data format
+		r_stream_width = f->get_16();
+		r_stream_height = f->get_16();
+		r_stream_mipmaps = f->get_32();
+		f->seek(data_pos);
+	} else {
 		p_size_limit = 0;
 	}
 
@@ -563,6 +588,9 @@ Error StreamTexture2D::_load_data(const String &p_path, int &tw, int &th, int &t
 		return ERR_CANT_OPEN;
 	}
 
+	tw = image->get_width();
+	th = image->get_height();
+
 	return OK;
 }
 
@@ -575,12 +603,30 @@ Error StreamTexture2D::load(const String &p_path) {
 	bool request_normal;
 	bool request_roughness;
 	int mipmap_limit;
+	int sw, sh, smipmaps;
+
+	_stream_unregister(); //may be a reload
 
-	Error err = _load_data(p_path, lw, lh, lwc, lhc, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	Error err = _load_data(p_path, lw, lh, lwc, lhc, image, request_3d, request_normal, request_roughness, mipmap_limit, sw, sh, smipmaps, stream_resident_size);
 	if (err) {
 		return err;
 	}
 
+	//find which mipmap the loaded image starts at, when not the first one the rest is streamed
+	int level = 0;
+	while (level < smipmaps && MAX(sw >> level, 1) > lw) {
+		level++;
+	}
+
+	if (level > 0) {
+		lw = sw;
+		lh = sh;
+		if (!lwc && !lhc) {
+			lwc = sw;
+			lhc = sh;
+		}
+	}
+
 	if (texture.is_valid()) {
 		RID new_texture = RS::get_singleton()->texture_2d_create(image);
 		RS::get_singleton()->texture_replace(texture, new_texture);
@@ -628,11 +674,275 @@ Error StreamTexture2D::load(const String &p_path) {
 	}
 
 #endif
+	if (level > 0) {
+		stream_width = sw;
+		stream_height = sh;
+		stream_mipmaps = smipmaps;
+		_stream_register(level);
+	}
+
 	_change_notify();
 	emit_changed();
 	return OK;
 }
 
+int StreamTexture2D::_get_stream_level(uint32_t p_size) const {
+	//smallest mipmap that is still at least as big as the size it's drawn at
+	int level = stream_min_level;
+	while (level > 0 && uint32_t(MAX(MAX(stream_width, stream_height) >> level, 1)) < p_size) {
+		level--;
+	}
+	return level;
+}
+
+uint64_t StreamTexture2D::_get_stream_level_bytes(int p_level) const {
+	return Image::get_image_data_size(stream_width, stream_height, format, true) - Image::get_image_mipmap_offset(stream_width, stream_height, format, p_level);
+}
+
+void StreamTexture2D::_stream_register(int p_level) {
+	{
+		MutexLock lock(stream_mutex);
+
+		if (!stream_thread) {
+			stream_exit = false;
+			stream_thread = Thread::create(_stream_thread_function, nullptr);
+		}
+
+		stream_last_id++;
+		if (stream_last_id == 0) {
+			stream_last_id++; //zero is never a valid id
+		}
+		stream_id = stream_last_id;
+		stream_textures[stream_id] = this;
+
+		streaming = true;
+		stream_min_level = p_level;
+		stream_level = p_level;
+		stream_target_level = -1;
+		stream_requested_size = 0;
+		stream_requested_frame = 0;
+		stream_bytes = _get_stream_level_bytes(p_level);
+		stream_used += stream_bytes;
+	}
+
+	//the id is passed instead of a pointer, so a request arriving after this texture is gone is ignored
+	RS::get_singleton()->texture_set_stream_callback(texture, _requested_stream, (void *)(uintptr_t)stream_id);
+}
+
+void StreamTexture2D::_stream_unregister() {
+	if (!streaming) {
+		return;
+	}
+
+	{
+		MutexLock lock(stream_mutex);
+		stream_textures.erase(stream_id);
+		stream_used -= stream_bytes;
+		streaming = false;
+		stream_id = 0;
+		stream_bytes = 0;
+		stream_target_level = -1;
+	}
+
+	if (texture.is_valid()) {
+		RS::get_singleton()->texture_set_stream_callback(texture, nullptr, nullptr);
+	}
+}
+
+void StreamTexture2D::_stream_apply(const Ref<Image> &p_image, int p_level) {
+	{
+		MutexLock lock(stream_mutex);
+		if (!streaming || p_level != stream_target_level) {
+			return; //reloaded or unregistered meanwhile
+		}
+
+		if (p_image.is_null() || p_image->empty()) {
+			//keep what is resident and stop streaming, the file is no longer readable
+			stream_used -= stream_bytes;
+			stream_bytes = _get_stream_level_bytes(stream_level);
+			stream_used += stream_bytes;
+			stream_target_level = -1;
+			stream_textures.erase(stream_id);
+			streaming = false;
+			ERR_FAIL_MSG("Failed streaming mipmaps of texture: " + path_to_file);
+		}
+	}
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	//replacing takes everything from the new texture, restore what is set on this one. Detect
+	//callbacks already fired, as streaming is only requested once the texture is drawn.
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+	RS::get_singleton()->texture_set_path(texture, get_path() != String() ? get_path() : path_to_file);
+	RS::get_singleton()->texture_set_stream_callback(texture, _requested_stream, (void *)(uintptr_t)stream_id);
+	alpha_cache.unref();
+
+	{
+		MutexLock lock(stream_mutex);
+		stream_level = p_level;
+		stream_target_level = -1;
+	}
+
+	stream_semaphore.post(); //more requests may be waiting for this one
+}
+
+void StreamTexture2D::_requested_stream(void *p_ud, int p_size) {
+	MutexLock lock(stream_mutex);
+
+	StreamTexture2D **st = stream_textures.getptr(uint32_t(uintptr_t(p_ud)));
+	if (!st) {
+		return;
+	}
+
+	(*st)->stream_requested_size = p_size;
+	(*st)->stream_requested_frame = Engine::get_singleton()->get_frames_drawn();
+
+	if ((*st)->stream_target_level < 0 && (*st)->_get_stream_level(p_size) < (*st)->stream_level) {
+		stream_semaphore.post();
+	}
+}
+
+Ref<Image> StreamTexture2D::_load_stream_image(const String &p_path, int p_size_limit) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V(!f, Ref<Image>());
+
+	f->seek(36); //skip the header, it was validated when loaded
+	Ref<Image> image = load_image_from_file(f, p_size_limit);
+	memdelete(f);
+
+	return image;
+}
+
+void StreamTexture2D::_stream_thread_function(void *p_ud) {
+	struct StreamJob {
+		ObjectID object;
+		String path;
+		int level;
+		int size_limit;
+	};
+
+	LocalVector<StreamJob> jobs;
+
+	while (true) {
+		stream_semaphore.wait();
+
+		stream_mutex.lock();
+
+		if (stream_exit) {
+			stream_mutex.unlock();
+			break;
+		}
+
+		//pick the texture furthest from the mipmap it is requested at
+
+		StreamTexture2D *pick = nullptr;
+		int pick_level = 0;
+
+		const uint32_t *k = nullptr;
+		while ((k = stream_textures.next(k))) {
+			StreamTexture2D *st = stream_textures[*k];
+			if (st->stream_target_level >= 0) {
+				continue; //busy
+			}
+			int level = st->_get_stream_level(st->stream_requested_size);
+			if (level < st->stream_level && (!pick || st->stream_level - level > pick->stream_level - pick_level)) {
+				pick = st;
+				pick_level = level;
+			}
+		}
+
+		if (pick) {
+			//make room by dropping the textures that were drawn least recently back to their resident mipmap
+
+			while (stream_used - pick->stream_bytes + pick->_get_stream_level_bytes(pick_level) > stream_budget) {
+				StreamTexture2D *victim = nullptr;
+
+				k = nullptr;
+				while ((k = stream_textures.next(k))) {
+					StreamTexture2D *st = stream_textures[*k];
+					if (st == pick || st->stream_target_level >= 0 || st->stream_level >= st->stream_min_level || st->stream_requested_frame >= pick->stream_requested_frame) {
+						continue;
+					}
+					if (!victim || st->stream_requested_frame < victim->stream_requested_frame) {
+						victim = st;
+					}
+				}
+
+				if (!victim) {
+					break;
+				}
+
+				victim->stream_target_level = victim->stream_min_level;
+				stream_used -= victim->stream_bytes;
+				victim->stream_bytes = victim->_get_stream_level_bytes(victim->stream_min_level);
+				stream_used += victim->stream_bytes;
+
+				StreamJob job;
+				job.object = victim->get_instance_id();
+				job.path = victim->path_to_file;
+				job.level = victim->stream_min_level;
+				job.size_limit = MAX(MAX(victim->stream_width, victim->stream_height) >> job.level, 1);
+				jobs.push_back(job);
+			}
+
+			//if it still does not fit, settle for a smaller mipmap
+			while (pick_level < pick->stream_level && stream_used - pick->stream_bytes + pick->_get_stream_level_bytes(pick_level) > stream_budget) {
+				pick_level++;
+			}
+
+			if (pick_level < pick->stream_level) {
+				pick->stream_target_level = pick_level;
+				stream_used -= pick->stream_bytes;
+				pick->stream_bytes = pick->_get_stream_level_bytes(pick_level);
+				stream_used += pick->stream_bytes;
+
+				StreamJob job;
+				job.object = pick->get_instance_id();
+				job.path = pick->path_to_file;
+				job.level = pick_level;
+				job.size_limit = MAX(MAX(pick->stream_width, pick->stream_height) >> pick_level, 1);
+				jobs.push_back(job);
+			}
+		}
+
+		stream_mutex.unlock();
+
+		//read outside the lock, textures are replaced on the main thread as RID replacement is not thread safe
+
+		for (uint32_t i = 0; i < jobs.size(); i++) {
+			Ref<Image> image = _load_stream_image(jobs[i].path, jobs[i].size_limit);
+			MessageQueue::get_singleton()->push_call(jobs[i].object, "_stream_apply", image, jobs[i].level);
+		}
+
+		if (jobs.size()) {
+			jobs.clear();
+			stream_semaphore.post(); //look for more work
+		}
+	}
+}
+
+void StreamTexture2D::initialize_streaming() {
+	stream_resident_size = GLOBAL_DEF("rendering/texture_streaming/resident_size", 128);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/texture_streaming/resident_size", PropertyInfo(Variant::INT, "rendering/texture_streaming/resident_size", PROPERTY_HINT_RANGE, "0,4096,1"));
+	stream_budget = uint64_t(int(GLOBAL_DEF("rendering/texture_streaming/memory_budget_mb", 512))) * 1024 * 1024;
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/texture_streaming/memory_budget_mb", PropertyInfo(Variant::INT, "rendering/texture_streaming/memory_budget_mb", PROPERTY_HINT_RANGE, "1,65536,1"));
+}
+
+void StreamTexture2D::finish_streaming() {
+	if (stream_thread) {
+		stream_mutex.lock();
+		stream_exit = true;
+		stream_mutex.unlock();
+
+		stream_semaphore.post();
+		Thread::wait_to_finish(stream_thread);
+		memdelete(stream_thread);
+		stream_thread = nullptr;
+	}
+
+	stream_resident_size = 0; //textures loaded after this point are not streamed
+}
+
 String StreamTexture2D::get_load_path() const {
 	return path_to_file;
 }
@@ -747,6 +1057,8 @@ void StreamTexture2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "path"), &StreamTexture2D::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &StreamTexture2D::get_load_path);
 
+	ClassDB::bind_method(D_METHOD("_stream_apply", "image", "level"), &StreamTexture2D::_stream_apply);
+
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.stex"), "load", "get_load_path");
 }
 
@@ -757,6 +1069,7 @@ StreamTexture2D::StreamTexture2D() {
 }
 
 StreamTexture2D::~StreamTexture2D() {
+	_stream_unregister();
 	if (texture.is_valid()) {
 		RS::get_singleton()->free(texture);
 	}
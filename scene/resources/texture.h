@@ -36,6 +36,8 @@
 #include "core/os/file_access.h"
 #include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/resource.h"
 #include "scene/resources/curve.h"
@@ -158,7 +160,7 @@ public:
 	};
 
 private:
-	Error _load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	Error _load_data(const String &p_path, int &tw, int &th, int &tw_custom, int &th_custom, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int &r_stream_width, int &r_stream_height, int &r_stream_mipmaps, int p_size_limit = 0);
 	String path_to_file;
 	mutable RID texture;
 	Image::Format format;
@@ -171,6 +173,42 @@ private:
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
 
+	// Mipmap streaming, for textures imported as streamed with mipmaps. Only the mipmaps up to
+	// the resident size are loaded with the texture, larger ones are read by the streaming thread
+	// once the renderer reports the texture is drawn big enough, and dropped again when the
+	// memory budget is exceeded by textures drawn more recently.
+	bool streaming = false;
+	uint32_t stream_id = 0;
+	int stream_width = 0; //size and mipmap count in file
+	int stream_height = 0;
+	int stream_mipmaps = 0;
+	int stream_min_level = 0; //mipmap always resident
+	int stream_level = 0; //first mipmap currently resident
+	int stream_target_level = -1; //being loaded, -1 if none
+	uint32_t stream_requested_size = 0;
+	uint64_t stream_requested_frame = 0;
+	uint64_t stream_bytes = 0; //accounted against the budget
+
+	int _get_stream_level(uint32_t p_size) const;
+	uint64_t _get_stream_level_bytes(int p_level) const;
+	void _stream_register(int p_level);
+	void _stream_unregister();
+	void _stream_apply(const Ref<Image> &p_image, int p_level);
+
+	static void _requested_stream(void *p_ud, int p_size);
+	static void _stream_thread_function(void *p_ud);
+	static Ref<Image> _load_stream_image(const String &p_path, int p_size_limit);
+
+	static Mutex stream_mutex;
+	static Semaphore stream_semaphore;
+	static Thread *stream_thread;
+	static bool stream_exit;
+	static HashMap<uint32_t, StreamTexture2D *> stream_textures;
+	static uint32_t stream_last_id;
+	static uint64_t stream_budget;
+	static uint64_t stream_used;
+	static int stream_resident_size;
+
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &property) const;
@@ -185,6 +223,9 @@ public:
 	static TextureFormatRoughnessRequestCallback request_roughness_callback;
 	static TextureFormatRequestCallback request_normal_callback;
 
+	static void initialize_streaming();
+	static void finish_streaming();
+
 	Image::Format get_format() const;
 	Error load(const String &p_path);
 	String get_load_path() const;
@@ -46,6 +46,8 @@ public:
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
 
+	virtual uint64_t get_order_key() const { return area->get_self().get_id(); }
+
 	AreaPair2DSW(Body2DSW *p_body, int p_body_shape, Area2DSW *p_area, int p_area_shape);
 	~AreaPair2DSW();
 };
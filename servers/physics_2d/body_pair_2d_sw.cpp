@@ -502,6 +502,48 @@ void BodyPair2DSW::solve(real_t p_step) {
 	}
 }
 
+struct _BodyPairCachedState2DHeader {
+	Vector2 sep_axis;
+	int contact_count;
+	bool collided;
+	bool oneway_disabled;
+};
+
+uint32_t BodyPair2DSW::get_cached_state_size() const {
+	return sizeof(_BodyPairCachedState2DHeader) + sizeof(Contact) * contact_count;
+}
+
+void BodyPair2DSW::save_cached_state(uint8_t *r_buffer) const {
+	_BodyPairCachedState2DHeader header;
+	header.sep_axis = sep_axis;
+	header.contact_count = contact_count;
+	header.collided = collided;
+	header.oneway_disabled = oneway_disabled;
+	copymem(r_buffer, &header, sizeof(header));
+	copymem(r_buffer + sizeof(header), contacts, sizeof(Contact) * contact_count);
+}
+
+bool BodyPair2DSW::load_cached_state(const uint8_t *p_buffer, uint32_t p_size) {
+	_BodyPairCachedState2DHeader header;
+	ERR_FAIL_COND_V(p_size < sizeof(header), false);
+	copymem(&header, p_buffer, sizeof(header));
+	ERR_FAIL_INDEX_V(header.contact_count, MAX_CONTACTS + 1, false);
+	ERR_FAIL_COND_V(p_size != sizeof(header) + sizeof(Contact) * header.contact_count, false);
+	sep_axis = header.sep_axis;
+	contact_count = header.contact_count;
+	collided = header.collided;
+	oneway_disabled = header.oneway_disabled;
+	copymem(contacts, p_buffer + sizeof(header), sizeof(Contact) * contact_count);
+	return true;
+}
+
+void BodyPair2DSW::clear_cached_state() {
+	sep_axis = Vector2();
+	contact_count = 0;
+	collided = false;
+	oneway_disabled = false;
+}
+
 BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_shape_B) :
 		Constraint2DSW(_arr, 2) {
 	A = p_A;
@@ -87,6 +87,13 @@ public:
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
 
+	virtual uint64_t get_order_key() const { return (uint64_t(shape_A) << 32) | uint32_t(shape_B); }
+
+	virtual uint32_t get_cached_state_size() const;
+	virtual void save_cached_state(uint8_t *r_buffer) const;
+	virtual bool load_cached_state(const uint8_t *p_buffer, uint32_t p_size);
+	virtual void clear_cached_state();
+
 	BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_shape_B);
 	~BodyPair2DSW();
 };
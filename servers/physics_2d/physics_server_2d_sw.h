@@ -32,6 +32,7 @@
 #define PHYSICS_2D_SERVER_SW
 
 #include "core/rid_owner.h"
+#include "core/thread_work_pool.h"
 #include "joints_2d_sw.h"
 #include "servers/physics_server_2d.h"
 #include "shape_2d_sw.h"
@@ -74,9 +75,14 @@ class PhysicsServer2DSW : public PhysicsServer2D {
 	SelfList<CollisionObject2DSW>::List pending_shape_update_list;
 	void _update_shapes();
 
+	// Only started once a batch of motion tests needs it.
+	ThreadWorkPool thread_work_pool;
+	bool thread_work_pool_started = false;
+
 	RID _shape_create(ShapeType p_shape);
 
 public:
+
 	struct CollCbkData {
 		Vector2 valid_dir;
 		real_t valid_depth;
@@ -123,6 +129,12 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space);
 
+	virtual void space_set_deterministic(RID p_space, bool p_enable);
+	virtual bool space_is_deterministic(RID p_space) const;
+
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const;
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot);
+
 	/* AREA API */
 
 	virtual RID area_create();
@@ -248,6 +260,7 @@ public:
 	virtual void body_set_pickable(RID p_body, bool p_pickable);
 
 	virtual bool body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin = 0.001, MotionResult *r_result = nullptr, bool p_exclude_raycast_shapes = true);
+	virtual void body_test_motions(MotionQuery *p_queries, int p_count);
 	virtual int body_test_ray_separation(RID p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin = 0.001);
 
 	// this function only works on physics process, errors and returns null otherwise
@@ -113,6 +113,19 @@ public:
 		return physics_2d_server->space_get_direct_state(p_space);
 	}
 
+	FUNC2(space_set_deterministic, RID, bool);
+	FUNC1RC(bool, space_is_deterministic, RID);
+
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const {
+		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), Vector<uint8_t>());
+		return physics_2d_server->space_get_snapshot(p_space);
+	}
+
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), ERR_UNAVAILABLE);
+		return physics_2d_server->space_restore_snapshot(p_space, p_snapshot);
+	}
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), Vector<Vector2>());
@@ -255,6 +268,11 @@ public:
 		return physics_2d_server->body_test_motion(p_body, p_from, p_motion, p_infinite_inertia, p_margin, r_result, p_exclude_raycast_shapes);
 	}
 
+	void body_test_motions(MotionQuery *p_queries, int p_count) {
+		ERR_FAIL_COND(main_thread != Thread::get_caller_id());
+		physics_2d_server->body_test_motions(p_queries, p_count);
+	}
+
 	int body_test_ray_separation(RID p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin = 0.001) {
 		ERR_FAIL_COND_V(main_thread != Thread::get_caller_id(), false);
 		return physics_2d_server->body_test_ray_separation(p_body, p_transform, p_infinite_inertia, r_recover_motion, r_results, p_result_max, p_margin);
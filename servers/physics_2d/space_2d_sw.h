@@ -38,7 +38,9 @@
 #include "broad_phase_2d_sw.h"
 #include "collision_object_2d_sw.h"
 #include "core/hash_map.h"
+#include "core/os/mutex.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "core/typedefs.h"
 
 class PhysicsDirectSpaceState2DSW : public PhysicsDirectSpaceState2D {
@@ -109,20 +111,30 @@ private:
 		INTERSECTION_QUERY_MAX = 2048
 	};
 
-	CollisionObject2DSW *intersection_query_results[INTERSECTION_QUERY_MAX];
-	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
+	// Broadphase query results. Every thread running motion tests needs its own,
+	// the one in the space is used by the direct state and the calling thread.
+	struct QueryContext {
+		CollisionObject2DSW *results[INTERSECTION_QUERY_MAX];
+		int subindex_results[INTERSECTION_QUERY_MAX];
+		bool threaded = false; // Batched motion tests cull concurrently and must lock the broadphase.
+	};
+
+	QueryContext query_context;
+	Mutex broadphase_query_mutex;
 
 	real_t body_linear_velocity_sleep_threshold;
 	real_t body_angular_velocity_sleep_threshold;
 	real_t body_time_to_sleep;
 
 	bool locked;
+	bool deterministic = false;
 
 	int island_count;
 	int active_objects;
 	int collision_pairs;
 
-	int _cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb);
+	int _cull_aabb_for_body(QueryContext &r_context, Body2DSW *p_body, const Rect2 &p_aabb);
+	bool _test_body_motion(QueryContext &r_context, Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer2D::MotionResult *r_result, bool p_exclude_raycast_shapes);
 
 	Vector<Vector2> contact_debug;
 	int contact_debug_count;
@@ -185,6 +197,23 @@ public:
 	int get_collision_pairs() const { return collision_pairs; }
 
 	bool test_body_motion(Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer2D::MotionResult *r_result, bool p_exclude_raycast_shapes = true);
+
+	struct MotionQuery {
+		Body2DSW *body = nullptr;
+		Transform2D from;
+		Vector2 motion;
+		bool infinite_inertia = false;
+		real_t margin = 0.08;
+		bool exclude_raycast_shapes = true;
+		PhysicsServer2D::MotionResult *result = nullptr;
+		bool collided = false;
+	};
+
+private:
+	void _test_body_motion_job(uint32_t p_index, MotionQuery *p_queries);
+
+public:
+	void test_body_motions(ThreadWorkPool &p_pool, MotionQuery *p_queries, int p_count);
 	int test_body_ray_separation(Body2DSW *p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, PhysicsServer2D::SeparationResult *r_results, int p_result_max, real_t p_margin);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -199,6 +228,12 @@ public:
 
 	PhysicsDirectSpaceState2DSW *get_direct_state();
 
+	void set_deterministic(bool p_enable) { deterministic = p_enable; }
+	bool is_deterministic() const { return deterministic; }
+
+	Vector<uint8_t> get_snapshot() const;
+	Error restore_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
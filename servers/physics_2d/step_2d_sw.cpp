@@ -128,6 +128,37 @@ void Step2DSW::_check_suspend(Body2DSW *p_island, real_t p_delta) {
 	}
 }
 
+struct _ConstraintOrder2DSW {
+	_FORCE_INLINE_ bool operator()(const Constraint2DSW *p_a, const Constraint2DSW *p_b) const {
+		if (p_a->get_body_count() != p_b->get_body_count()) {
+			return p_a->get_body_count() < p_b->get_body_count();
+		}
+		for (int i = 0; i < p_a->get_body_count(); i++) {
+			RID rid_a = p_a->get_body_ptr()[i]->get_self();
+			RID rid_b = p_b->get_body_ptr()[i]->get_self();
+			if (rid_a != rid_b) {
+				return rid_a < rid_b;
+			}
+		}
+		return p_a->get_order_key() < p_b->get_order_key();
+	}
+};
+
+Constraint2DSW *Step2DSW::_sort_island(Constraint2DSW *p_island) {
+	island_sort_buffer.clear();
+	for (Constraint2DSW *c = p_island; c; c = c->get_island_next()) {
+		island_sort_buffer.push_back(c);
+	}
+
+	island_sort_buffer.sort_custom<_ConstraintOrder2DSW>();
+
+	for (uint32_t i = 0; i < island_sort_buffer.size(); i++) {
+		island_sort_buffer[i]->set_island_next(i + 1 < island_sort_buffer.size() ? island_sort_buffer[i + 1] : nullptr);
+	}
+
+	return island_sort_buffer[0];
+}
+
 void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 	p_space->lock(); // can't access space during this
 
@@ -187,6 +218,24 @@ void Step2DSW::step(Space2DSW *p_space, real_t p_delta, int p_iterations) {
 
 	p_space->set_island_count(island_count);
 
+	if (p_space->is_deterministic()) {
+		// Solving order changes the results, don't let it depend on memory addresses.
+		Constraint2DSW *prev = nullptr;
+		Constraint2DSW *ci = constraint_island_list;
+		while (ci) {
+			Constraint2DSW *next = ci->get_island_list_next();
+			Constraint2DSW *sorted = _sort_island(ci);
+			sorted->set_island_list_next(next);
+			if (prev) {
+				prev->set_island_list_next(sorted);
+			} else {
+				constraint_island_list = sorted;
+			}
+			prev = sorted;
+			ci = next;
+		}
+	}
+
 	const SelfList<Area2DSW>::List &aml = p_space->get_moved_area_list();
 
 	while (aml.first()) {
@@ -198,6 +198,20 @@ void Area3DSW::set_monitorable(bool p_monitorable) {
 	_set_static(!monitorable);
 }
 
+void Area3DSW::_sort_monitor_changes(const MonitorMap &p_map) {
+	monitor_changes.clear();
+	for (MonitorMap::Iterator it = p_map.iter(); it.valid; it = p_map.next_iter(it)) {
+		if (it.value->state == 0) {
+			continue; //nothing happened
+		}
+		MonitorChange change;
+		change.key = *it.key;
+		change.state = it.value->state;
+		monitor_changes.push_back(change);
+	}
+	monitor_changes.sort();
+}
+
 void Area3DSW::call_queries() {
 	if (monitor_callback_id.is_valid() && !monitored_bodies.empty()) {
 		Variant res[5];
@@ -213,16 +227,15 @@ void Area3DSW::call_queries() {
 			return;
 		}
 
-		for (Map<BodyKey, BodyState>::Element *E = monitored_bodies.front(); E; E = E->next()) {
-			if (E->get().state == 0) {
-				continue; //nothing happened
-			}
+		_sort_monitor_changes(monitored_bodies);
 
-			res[0] = E->get().state > 0 ? PhysicsServer3D::AREA_BODY_ADDED : PhysicsServer3D::AREA_BODY_REMOVED;
-			res[1] = E->key().rid;
-			res[2] = E->key().instance_id;
-			res[3] = E->key().body_shape;
-			res[4] = E->key().area_shape;
+		for (uint32_t i = 0; i < monitor_changes.size(); i++) {
+			const MonitorChange &change = monitor_changes[i];
+			res[0] = change.state > 0 ? PhysicsServer3D::AREA_BODY_ADDED : PhysicsServer3D::AREA_BODY_REMOVED;
+			res[1] = change.key.rid;
+			res[2] = change.key.instance_id;
+			res[3] = change.key.body_shape;
+			res[4] = change.key.area_shape;
 
 			Callable::CallError ce;
 			obj->call(monitor_callback_method, (const Variant **)resptr, 5, ce);
@@ -245,16 +258,15 @@ void Area3DSW::call_queries() {
 			return;
 		}
 
-		for (Map<BodyKey, BodyState>::Element *E = monitored_areas.front(); E; E = E->next()) {
-			if (E->get().state == 0) {
-				continue; //nothing happened
-			}
+		_sort_monitor_changes(monitored_areas);
 
-			res[0] = E->get().state > 0 ? PhysicsServer3D::AREA_BODY_ADDED : PhysicsServer3D::AREA_BODY_REMOVED;
-			res[1] = E->key().rid;
-			res[2] = E->key().instance_id;
-			res[3] = E->key().body_shape;
-			res[4] = E->key().area_shape;
+		for (uint32_t i = 0; i < monitor_changes.size(); i++) {
+			const MonitorChange &change = monitor_changes[i];
+			res[0] = change.state > 0 ? PhysicsServer3D::AREA_BODY_ADDED : PhysicsServer3D::AREA_BODY_REMOVED;
+			res[1] = change.key.rid;
+			res[2] = change.key.instance_id;
+			res[3] = change.key.body_shape;
+			res[4] = change.key.area_shape;
 
 			Callable::CallError ce;
 			obj->call(area_monitor_callback_method, (const Variant **)resptr, 5, ce);
@@ -268,7 +280,9 @@ void Area3DSW::call_queries() {
 Area3DSW::Area3DSW() :
 		CollisionObject3DSW(TYPE_AREA),
 		monitor_query_list(this),
-		moved_list(this) {
+		moved_list(this),
+		monitored_bodies(8),
+		monitored_areas(8) {
 	_set_static(true); //areas are never active
 	space_override_mode = PhysicsServer3D::AREA_SPACE_OVERRIDE_DISABLED;
 	gravity = 9.80665;
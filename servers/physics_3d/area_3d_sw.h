@@ -32,6 +32,8 @@
 #define AREA_SW_H
 
 #include "collision_object_3d_sw.h"
+#include "core/local_vector.h"
+#include "core/oa_hash_map.h"
 #include "core/self_list.h"
 #include "servers/physics_server_3d.h"
 //#include "servers/physics_3d/query_sw.h"
@@ -67,6 +69,10 @@ class Area3DSW : public CollisionObject3DSW {
 		uint32_t body_shape;
 		uint32_t area_shape;
 
+		_FORCE_INLINE_ bool operator==(const BodyKey &p_key) const {
+			return rid == p_key.rid && body_shape == p_key.body_shape && area_shape == p_key.area_shape;
+		}
+
 		_FORCE_INLINE_ bool operator<(const BodyKey &p_key) const {
 			if (rid == p_key.rid) {
 				if (body_shape == p_key.body_shape) {
@@ -91,8 +97,43 @@ class Area3DSW : public CollisionObject3DSW {
 		_FORCE_INLINE_ BodyState() { state = 0; }
 	};
 
-	Map<BodyKey, BodyState> monitored_bodies;
-	Map<BodyKey, BodyState> monitored_areas;
+	struct BodyKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const BodyKey &p_key) {
+			uint32_t h = hash_one_uint64(p_key.rid.get_id());
+			h = hash_djb2_one_32(p_key.body_shape, h);
+			return hash_djb2_one_32(p_key.area_shape, h);
+		}
+	};
+
+	typedef OAHashMap<BodyKey, BodyState, BodyKeyHasher> MonitorMap;
+
+	// Only bodies and areas that entered or exited since the last query are kept here.
+	MonitorMap monitored_bodies;
+	MonitorMap monitored_areas;
+
+	struct MonitorChange {
+		BodyKey key;
+		int state;
+
+		_FORCE_INLINE_ bool operator<(const MonitorChange &p_change) const { return key < p_change.key; }
+	};
+
+	// Changes are reported sorted by key, so callbacks run in the same order every run.
+	LocalVector<MonitorChange> monitor_changes;
+	void _sort_monitor_changes(const MonitorMap &p_map);
+
+	_FORCE_INLINE_ void _update_monitor_state(MonitorMap &r_map, const BodyKey &p_key, bool p_entered) {
+		BodyState *state = r_map.lookup_ptr(p_key);
+		if (!state) {
+			r_map.insert(p_key, BodyState());
+			state = r_map.lookup_ptr(p_key);
+		}
+		if (p_entered) {
+			state->inc();
+		} else {
+			state->dec();
+		}
+	}
 
 	//virtual void shape_changed_notify(ShapeSW *p_shape);
 	//virtual void shape_deleted_notify(ShapeSW *p_shape);
@@ -112,6 +153,9 @@ public:
 	void set_area_monitor_callback(ObjectID p_id, const StringName &p_method);
 	_FORCE_INLINE_ bool has_area_monitor_callback() const { return area_monitor_callback_id.is_valid(); }
 
+	// Areas that neither monitor nor override space parameters need no overlap tests.
+	_FORCE_INLINE_ bool is_body_monitoring_needed() const { return monitor_callback_id.is_valid() || space_override_mode != PhysicsServer3D::AREA_SPACE_OVERRIDE_DISABLED; }
+
 	_FORCE_INLINE_ void add_body_to_query(Body3DSW *p_body, uint32_t p_body_shape, uint32_t p_area_shape);
 	_FORCE_INLINE_ void remove_body_from_query(Body3DSW *p_body, uint32_t p_body_shape, uint32_t p_area_shape);
 
@@ -168,7 +212,7 @@ public:
 
 void Area3DSW::add_body_to_query(Body3DSW *p_body, uint32_t p_body_shape, uint32_t p_area_shape) {
 	BodyKey bk(p_body, p_body_shape, p_area_shape);
-	monitored_bodies[bk].inc();
+	_update_monitor_state(monitored_bodies, bk, true);
 	if (!monitor_query_list.in_list()) {
 		_queue_monitor_update();
 	}
@@ -176,7 +220,7 @@ void Area3DSW::add_body_to_query(Body3DSW *p_body, uint32_t p_body_shape, uint32
 
 void Area3DSW::remove_body_from_query(Body3DSW *p_body, uint32_t p_body_shape, uint32_t p_area_shape) {
 	BodyKey bk(p_body, p_body_shape, p_area_shape);
-	monitored_bodies[bk].dec();
+	_update_monitor_state(monitored_bodies, bk, false);
 	if (!monitor_query_list.in_list()) {
 		_queue_monitor_update();
 	}
@@ -184,7 +228,7 @@ void Area3DSW::remove_body_from_query(Body3DSW *p_body, uint32_t p_body_shape, u
 
 void Area3DSW::add_area_to_query(Area3DSW *p_area, uint32_t p_area_shape, uint32_t p_self_shape) {
 	BodyKey bk(p_area, p_area_shape, p_self_shape);
-	monitored_areas[bk].inc();
+	_update_monitor_state(monitored_areas, bk, true);
 	if (!monitor_query_list.in_list()) {
 		_queue_monitor_update();
 	}
@@ -192,7 +236,7 @@ void Area3DSW::add_area_to_query(Area3DSW *p_area, uint32_t p_area_shape, uint32
 
 void Area3DSW::remove_area_from_query(Area3DSW *p_area, uint32_t p_area_shape, uint32_t p_self_shape) {
 	BodyKey bk(p_area, p_area_shape, p_self_shape);
-	monitored_areas[bk].dec();
+	_update_monitor_state(monitored_areas, bk, false);
 	if (!monitor_query_list.in_list()) {
 		_queue_monitor_update();
 	}
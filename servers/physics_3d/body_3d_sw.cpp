@@ -740,6 +740,41 @@ void Body3DSW::set_kinematic_margin(real_t p_margin) {
 	kinematic_safe_margin = p_margin;
 }
 
+void Body3DSW::save_snapshot(Snapshot &r_snapshot) const {
+	r_snapshot.transform = get_transform();
+	r_snapshot.new_transform = new_transform;
+	r_snapshot.linear_velocity = linear_velocity;
+	r_snapshot.angular_velocity = angular_velocity;
+	r_snapshot.biased_linear_velocity = biased_linear_velocity;
+	r_snapshot.biased_angular_velocity = biased_angular_velocity;
+	r_snapshot.applied_force = applied_force;
+	r_snapshot.applied_torque = applied_torque;
+	r_snapshot.still_time = still_time;
+	r_snapshot.active = active;
+	r_snapshot.first_integration = first_integration;
+}
+
+void Body3DSW::restore_snapshot(const Snapshot &p_snapshot) {
+	new_transform = p_snapshot.new_transform;
+	linear_velocity = p_snapshot.linear_velocity;
+	angular_velocity = p_snapshot.angular_velocity;
+	biased_linear_velocity = p_snapshot.biased_linear_velocity;
+	biased_angular_velocity = p_snapshot.biased_angular_velocity;
+	applied_force = p_snapshot.applied_force;
+	applied_torque = p_snapshot.applied_torque;
+	still_time = p_snapshot.still_time;
+	first_integration = p_snapshot.first_integration;
+
+	// Also moves the shapes in the broadphase, which re-pairs them right away.
+	_set_transform(p_snapshot.transform);
+	_set_inv_transform(p_snapshot.transform.affine_inverse());
+	_update_transform_dependant();
+
+	if (mode != PhysicsServer3D::BODY_MODE_STATIC) {
+		set_active(p_snapshot.active);
+	}
+}
+
 Body3DSW::Body3DSW() :
 		CollisionObject3DSW(TYPE_BODY),
 
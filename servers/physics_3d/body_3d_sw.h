@@ -326,6 +326,24 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulation state that changes while stepping, saved by space snapshots.
+	struct Snapshot {
+		Transform transform;
+		Transform new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 biased_linear_velocity;
+		Vector3 biased_angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		real_t still_time;
+		bool active;
+		bool first_integration;
+	};
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	Body3DSW();
 	~Body3DSW();
 };
@@ -159,44 +159,151 @@ void BodyPair3DSW::validate_contacts() {
 	}
 }
 
-bool BodyPair3DSW::_test_ccd(real_t p_step, Body3DSW *p_A, int p_shape_A, const Transform &p_xform_A, Body3DSW *p_B, int p_shape_B, const Transform &p_xform_B) {
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
-	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON) {
-		return false;
+#define CCD_MAX_ITERATIONS 16
+
+// Swept motion of a shape over one step, used for conservative advancement.
+struct _CCDSweep {
+	const Shape3DSW *shape;
+	Transform xform; // shape transform at the start of the step
+	Vector3 center; // center of mass, the shape rotates around it
+	Vector3 motion; // linear displacement over the whole step
+	Vector3 rot_axis;
+	real_t rot_angle; // rotation over the whole step
+	real_t radius; // farthest point of the shape from the center
+	real_t tolerance;
+
+	Transform get_xform(real_t p_t) const {
+		Transform xf = xform;
+		if (rot_angle > CMP_EPSILON) {
+			Basis rot(rot_axis, rot_angle * p_t);
+			xf.basis = rot * xf.basis;
+			xf.origin = center + rot.xform(xf.origin - center);
+		}
+		xf.origin += motion * p_t;
+		return xf;
 	}
+};
+
+// Advances along the sweep by steps that can't make the shapes overlap, as the
+// distance is divided by an upper bound of the approach speed. Returns the
+// fraction of the step at which the shapes touch, or -1 if they never do.
+// Shapes already touching at the start of the step are left to the solver.
+static real_t _ccd_conservative_advance(const _CCDSweep &p_sweep, const Shape3DSW *p_shape_B, const Transform &p_xform_B) {
+	real_t t = 0;
+
+	for (int i = 0; i < CCD_MAX_ITERATIONS; i++) {
+		Vector3 point_A, point_B;
+		if (!CollisionSolver3DSW::solve_distance(p_sweep.shape, p_sweep.get_xform(t), p_shape_B, p_xform_B, point_A, point_B, AABB())) {
+			return t > 0 ? t : -1; // overlapping
+		}
+
+		Vector3 dir = point_B - point_A;
+		real_t dist = dir.length();
 
-	Vector3 mnormal = motion / mlen;
+		// No point of the shape moves towards B faster than this.
+		real_t approach = p_sweep.rot_angle * p_sweep.radius;
+		if (dist > CMP_EPSILON) {
+			approach += p_sweep.motion.dot(dir / dist);
+		}
+		if (approach <= CMP_EPSILON) {
+			return -1; // moving away or parallel, like sliding along a surface
+		}
 
-	real_t min, max;
-	p_A->get_shape(p_shape_A)->project_range(mnormal, p_xform_A, min, max);
-	bool fast_object = mlen > (max - min) * 0.3; //going too fast in that direction
+		if (dist < p_sweep.tolerance) {
+			return t > 0 ? t : -1;
+		}
 
-	if (!fast_object) { //did it move enough in this direction to even attempt raycast? let's say it should move more than 1/3 the size of the object in that axis
+		t += dist / approach;
+		if (t >= 1.0) {
+			return -1;
+		}
+	}
+
+	return t; // did not converge, but stayed conservative
+}
+
+struct _CCDConcaveInfo {
+	const _CCDSweep *sweep;
+	const Transform *xform_B;
+	real_t toi;
+};
+
+static void _ccd_concave_callback(void *p_userdata, Shape3DSW *p_convex) {
+	_CCDConcaveInfo &info = *(_CCDConcaveInfo *)p_userdata;
+	real_t toi = _ccd_conservative_advance(*info.sweep, p_convex, *info.xform_B);
+	if (toi >= 0 && (info.toi < 0 || toi < info.toi)) {
+		info.toi = toi;
+	}
+}
+
+bool BodyPair3DSW::_test_ccd(real_t p_step, Body3DSW *p_A, int p_shape_A, const Transform &p_xform_A, Body3DSW *p_B, int p_shape_B, const Transform &p_xform_B) {
+	Shape3DSW *shape_A_ptr = p_A->get_shape(p_shape_A);
+	Shape3DSW *shape_B_ptr = p_B->get_shape(p_shape_B);
+
+	if (shape_A_ptr->is_concave()) {
 		return false;
 	}
 
-	//cast a segment from support in motion normal, in the same direction of motion by motion length
-	//support is the worst case collision point, so real collision happened before
-	Vector3 s = p_A->get_shape(p_shape_A)->get_support(p_xform_A.basis.xform(mnormal).normalized());
-	Vector3 from = p_xform_A.xform(s);
-	Vector3 to = from + motion;
+	_CCDSweep sweep;
+	sweep.shape = shape_A_ptr;
+	sweep.xform = p_xform_A;
+	sweep.motion = p_A->get_linear_velocity() * p_step;
+
+	Vector3 rot = p_A->get_angular_velocity() * p_step;
+	sweep.rot_angle = rot.length();
+	sweep.rot_axis = sweep.rot_angle > CMP_EPSILON ? rot / sweep.rot_angle : Vector3();
 
-	Transform from_inv = p_xform_B.affine_inverse();
+	// Body origin in the same space as the shape transforms, plus its center of mass.
+	Transform body_xform = p_xform_A * p_A->get_shape_transform(p_shape_A).affine_inverse();
+	sweep.center = body_xform.origin + p_A->get_center_of_mass();
 
-	Vector3 local_from = from_inv.xform(from - mnormal * mlen * 0.1); //start from a little inside the bounding box
-	Vector3 local_to = from_inv.xform(to);
+	AABB aabb_A = p_xform_A.xform(shape_A_ptr->get_aabb());
+	sweep.radius = 0;
+	for (int i = 0; i < 8; i++) {
+		sweep.radius = MAX(sweep.radius, aabb_A.get_endpoint(i).distance_to(sweep.center));
+	}
+
+	real_t mlen = sweep.motion.length();
+	real_t thickness;
+	if (mlen > CMP_EPSILON) {
+		real_t min, max;
+		shape_A_ptr->project_range(sweep.motion / mlen, p_xform_A, min, max);
+		thickness = max - min;
+	} else {
+		thickness = MIN(aabb_A.size.x, MIN(aabb_A.size.y, aabb_A.size.z));
+	}
 
-	Vector3 rpos, rnorm;
-	if (!p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm)) {
+	// Did it move more than 1/3 of its size in this step? Otherwise discrete collision will catch it.
+	real_t sweep_len = mlen + sweep.rot_angle * sweep.radius;
+	if (sweep_len < CMP_EPSILON || sweep_len <= thickness * 0.3) {
 		return false;
 	}
 
-	//shorten the linear velocity so it does not hit, but gets close enough, next frame will hit softly or soft enough
-	Vector3 hitpos = p_xform_B.xform(rpos);
+	sweep.tolerance = thickness * 0.01;
+
+	real_t toi;
+	if (shape_B_ptr->is_concave()) {
+		// Cull the faces touched by the whole sweep, in the local space of B.
+		AABB swept_aabb = aabb_A.merge(sweep.get_xform(1.0).xform(shape_A_ptr->get_aabb()));
+		swept_aabb = swept_aabb.grow(sweep.rot_angle * sweep.radius);
+
+		_CCDConcaveInfo info;
+		info.sweep = &sweep;
+		info.xform_B = &p_xform_B;
+		info.toi = -1;
+		static_cast<const ConcaveShape3DSW *>(shape_B_ptr)->cull(p_xform_B.affine_inverse().xform(swept_aabb), _ccd_concave_callback, &info);
+		toi = info.toi;
+	} else {
+		toi = _ccd_conservative_advance(sweep, shape_B_ptr, p_xform_B);
+	}
+
+	if (toi <= 0) {
+		return false;
+	}
 
-	real_t newlen = hitpos.distance_to(from) - (max - min) * 0.01;
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
+	// Slow the body down so it arrives right before the impact, next step will hit softly or soft enough.
+	p_A->set_linear_velocity(p_A->get_linear_velocity() * toi);
+	p_A->set_angular_velocity(p_A->get_angular_velocity() * toi);
 
 	return true;
 }
@@ -240,7 +347,7 @@ bool BodyPair3DSW::setup(real_t p_step) {
 	this->collided = collided;
 
 	if (!collided) {
-		//test ccd (currently just a raycast)
+		//test ccd (conservative advancement of the fast body against the other)
 
 		if (A->is_continuous_collision_detection_enabled() && A->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
 			_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
@@ -455,6 +562,44 @@ void BodyPair3DSW::solve(real_t p_step) {
 	}
 }
 
+struct _BodyPairCachedStateHeader {
+	Vector3 sep_axis;
+	int contact_count;
+	bool collided;
+};
+
+uint32_t BodyPair3DSW::get_cached_state_size() const {
+	return sizeof(_BodyPairCachedStateHeader) + sizeof(Contact) * contact_count;
+}
+
+void BodyPair3DSW::save_cached_state(uint8_t *r_buffer) const {
+	_BodyPairCachedStateHeader header;
+	header.sep_axis = sep_axis;
+	header.contact_count = contact_count;
+	header.collided = collided;
+	copymem(r_buffer, &header, sizeof(header));
+	copymem(r_buffer + sizeof(header), contacts, sizeof(Contact) * contact_count);
+}
+
+bool BodyPair3DSW::load_cached_state(const uint8_t *p_buffer, uint32_t p_size) {
+	_BodyPairCachedStateHeader header;
+	ERR_FAIL_COND_V(p_size < sizeof(header), false);
+	copymem(&header, p_buffer, sizeof(header));
+	ERR_FAIL_INDEX_V(header.contact_count, MAX_CONTACTS + 1, false);
+	ERR_FAIL_COND_V(p_size != sizeof(header) + sizeof(Contact) * header.contact_count, false);
+	sep_axis = header.sep_axis;
+	contact_count = header.contact_count;
+	collided = header.collided;
+	copymem(contacts, p_buffer + sizeof(header), sizeof(Contact) * contact_count);
+	return true;
+}
+
+void BodyPair3DSW::clear_cached_state() {
+	sep_axis = Vector3();
+	contact_count = 0;
+	collided = false;
+}
+
 BodyPair3DSW::BodyPair3DSW(Body3DSW *p_A, int p_shape_A, Body3DSW *p_B, int p_shape_B) :
 		Constraint3DSW(_arr, 2) {
 	A = p_A;
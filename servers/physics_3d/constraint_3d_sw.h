@@ -78,6 +78,16 @@ public:
 	virtual bool setup(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// Constraints are ordered by their bodies and this key when stepping
+	// deterministically, as their addresses change when they are re-created.
+	virtual uint64_t get_order_key() const { return self.get_id(); }
+
+	// State kept between steps (such as cached contacts), saved by space snapshots.
+	virtual uint32_t get_cached_state_size() const { return 0; }
+	virtual void save_cached_state(uint8_t *r_buffer) const {}
+	virtual bool load_cached_state(const uint8_t *p_buffer, uint32_t p_size) { return false; }
+	virtual void clear_cached_state() {}
+
 	virtual ~Constraint3DSW() {}
 };
 
@@ -33,6 +33,7 @@
 #include "broad_phase_3d_basic.h"
 #include "broad_phase_octree.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/local_vector.h"
 #include "core/os/os.h"
 #include "joints/cone_twist_joint_3d_sw.h"
 #include "joints/generic_6dof_joint_3d_sw.h"
@@ -179,6 +180,30 @@ PhysicsDirectSpaceState3D *PhysicsServer3DSW::space_get_direct_state(RID p_space
 	return space->get_direct_state();
 }
 
+void PhysicsServer3DSW::space_set_deterministic(RID p_space, bool p_enable) {
+	Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND(!space);
+	space->set_deterministic(p_enable);
+}
+
+bool PhysicsServer3DSW::space_is_deterministic(RID p_space) const {
+	const Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, false);
+	return space->is_deterministic();
+}
+
+Vector<uint8_t> PhysicsServer3DSW::space_get_snapshot(RID p_space) const {
+	const Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	return space->get_snapshot();
+}
+
+Error PhysicsServer3DSW::space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	Space3DSW *space = space_owner.getornull(p_space);
+	ERR_FAIL_COND_V(!space, ERR_INVALID_PARAMETER);
+	return space->restore_snapshot(p_snapshot);
+}
+
 void PhysicsServer3DSW::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	Space3DSW *space = space_owner.getornull(p_space);
 	ERR_FAIL_COND(!space);
@@ -874,6 +899,64 @@ bool PhysicsServer3DSW::body_test_motion(RID p_body, const Transform &p_from, co
 	return body->get_space()->test_body_motion(body, p_from, p_motion, p_infinite_inertia, body->get_kinematic_margin(), r_result, p_exclude_raycast_shapes);
 }
 
+void PhysicsServer3DSW::body_test_motions(MotionQuery *p_queries, int p_count) {
+	_update_shapes();
+
+	LocalVector<Space3DSW::MotionQuery> batch;
+	LocalVector<int> batch_indices;
+	batch.reserve(p_count);
+	batch_indices.reserve(p_count);
+
+	int i = 0;
+	while (i < p_count) {
+		// Consecutive tests in the same space run as one batch.
+		Space3DSW *space = nullptr;
+		batch.clear();
+		batch_indices.clear();
+
+		for (; i < p_count; i++) {
+			MotionQuery &q = p_queries[i];
+			q.collided = false;
+
+			Body3DSW *body = body_owner.getornull(q.body);
+			ERR_CONTINUE(!body);
+			ERR_CONTINUE(!body->get_space());
+			ERR_CONTINUE(body->get_space()->is_locked());
+
+			if (space && body->get_space() != space) {
+				break;
+			}
+			space = body->get_space();
+
+			Space3DSW::MotionQuery sq;
+			sq.body = body;
+			sq.from = q.from;
+			sq.motion = q.motion;
+			sq.infinite_inertia = q.infinite_inertia;
+			sq.margin = body->get_kinematic_margin();
+			sq.exclude_raycast_shapes = q.exclude_raycast_shapes;
+			sq.result = q.result;
+			batch.push_back(sq);
+			batch_indices.push_back(i);
+		}
+
+		if (batch.size() == 0) {
+			continue;
+		}
+
+		if (batch.size() > 1 && !thread_work_pool_started) {
+			thread_work_pool.init();
+			thread_work_pool_started = true;
+		}
+
+		space->test_body_motions(thread_work_pool, batch.ptr(), batch.size());
+
+		for (uint32_t j = 0; j < batch.size(); j++) {
+			p_queries[batch_indices[j]].collided = batch[j].collided;
+		}
+	}
+}
+
 int PhysicsServer3DSW::body_test_ray_separation(RID p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin) {
 	Body3DSW *body = body_owner.getornull(p_body);
 	ERR_FAIL_COND_V(!body, false);
@@ -1380,6 +1463,8 @@ void PhysicsServer3DSW::flush_queries() {
 };
 
 void PhysicsServer3DSW::finish() {
+	thread_work_pool.finish();
+	thread_work_pool_started = false;
 	memdelete(stepper);
 	memdelete(direct_state);
 };
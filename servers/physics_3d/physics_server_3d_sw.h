@@ -32,6 +32,7 @@
 #define PHYSICS_SERVER_SW
 
 #include "core/rid_owner.h"
+#include "core/thread_work_pool.h"
 #include "joints_3d_sw.h"
 #include "servers/physics_server_3d.h"
 #include "shape_3d_sw.h"
@@ -69,6 +70,10 @@ class PhysicsServer3DSW : public PhysicsServer3D {
 	SelfList<CollisionObject3DSW>::List pending_shape_update_list;
 	void _update_shapes();
 
+	// Only started once a batch of motion tests needs it.
+	ThreadWorkPool thread_work_pool;
+	bool thread_work_pool_started = false;
+
 public:
 	static PhysicsServer3DSW *singleton;
 
@@ -104,6 +109,12 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space);
 
+	virtual void space_set_deterministic(RID p_space, bool p_enable);
+	virtual bool space_is_deterministic(RID p_space) const;
+
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const;
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot);
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const;
 	virtual int space_get_contact_count(RID p_space) const;
@@ -236,6 +247,7 @@ public:
 	virtual bool body_is_ray_pickable(RID p_body) const;
 
 	virtual bool body_test_motion(RID p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, MotionResult *r_result = nullptr, bool p_exclude_raycast_shapes = true);
+	virtual void body_test_motions(MotionQuery *p_queries, int p_count);
 	virtual int body_test_ray_separation(RID p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin = 0.001);
 
 	// this function only works on physics process, errors and returns null otherwise
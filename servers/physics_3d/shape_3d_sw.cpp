@@ -32,7 +32,7 @@
 
 #include "core/math/geometry.h"
 #include "core/math/quick_hull.h"
-#include "core/sort_array.h"
+#include "core/local_vector.h"
 
 #define _POINT_SNAP 0.001953125
 #define _EDGE_IS_VALID_SUPPORT_THRESHOLD 0.0002
@@ -1074,20 +1074,23 @@ Vector3 ConcavePolygonShape3DSW::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void ConcavePolygonShape3DSW::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *bvh = &p_params->bvh[p_idx];
+void ConcavePolygonShape3DSW::_cull_segment(_SegmentCullParams *p_params) const {
+	const BVH *bvh_ptr = p_params->bvh;
+	int idx = 0;
 
-	/*
-	if (p_params->dir.dot(bvh->aabb.get_support(-p_params->dir))>p_params->min_d)
-		return; //test against whole AABB, which isn't very costly
-	*/
+	while (idx < p_params->bvh_count) {
+		const BVH *bvh = &bvh_ptr[idx];
 
-	//printf("addr: %p\n",bvh);
-	if (!bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
-	}
+		if (!bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
+			idx = bvh->skip;
+			continue;
+		}
+
+		if (bvh->face_index < 0) {
+			idx++; // descend into first child
+			continue;
+		}
 
-	if (bvh->face_index >= 0) {
 		Vector3 res;
 		Vector3 vertices[3] = {
 			p_params->vertices[p_params->faces[bvh->face_index].indices[0]],
@@ -1112,13 +1115,7 @@ void ConcavePolygonShape3DSW::_cull_segment(int p_idx, _SegmentCullParams *p_par
 			}
 		}
 
-	} else {
-		if (bvh->left >= 0) {
-			_cull_segment(bvh->left, p_params);
-		}
-		if (bvh->right >= 0) {
-			_cull_segment(bvh->right, p_params);
-		}
+		idx = bvh->skip;
 	}
 }
 
@@ -1141,10 +1138,11 @@ bool ConcavePolygonShape3DSW::intersect_segment(const Vector3 &p_begin, const Ve
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_count = bvh.size();
 
 	params.min_d = 1e20;
 	// cull
-	_cull_segment(0, &params);
+	_cull_segment(&params);
 
 	if (params.collisions > 0) {
 		r_result = params.result;
@@ -1163,14 +1161,23 @@ Vector3 ConcavePolygonShape3DSW::get_closest_point_to(const Vector3 &p_point) co
 	return Vector3();
 }
 
-void ConcavePolygonShape3DSW::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *bvh = &p_params->bvh[p_idx];
+void ConcavePolygonShape3DSW::_cull(_CullParams *p_params) const {
+	const BVH *bvh_ptr = p_params->bvh;
+	int idx = 0;
 
-	if (!p_params->aabb.intersects(bvh->aabb)) {
-		return;
-	}
+	while (idx < p_params->bvh_count) {
+		const BVH *bvh = &bvh_ptr[idx];
+
+		if (!p_params->aabb.intersects(bvh->aabb)) {
+			idx = bvh->skip;
+			continue;
+		}
+
+		if (bvh->face_index < 0) {
+			idx++; // descend into first child
+			continue;
+		}
 
-	if (bvh->face_index >= 0) {
 		const Face *f = &p_params->faces[bvh->face_index];
 		FaceShape3DSW *face = p_params->face;
 		face->normal = f->normal;
@@ -1179,14 +1186,7 @@ void ConcavePolygonShape3DSW::_cull(int p_idx, _CullParams *p_params) const {
 		face->vertex[2] = p_params->vertices[f->indices[2]];
 		p_params->callback(p_params->userdata, face);
 
-	} else {
-		if (bvh->left >= 0) {
-			_cull(bvh->left, p_params);
-		}
-
-		if (bvh->right >= 0) {
-			_cull(bvh->right, p_params);
-		}
+		idx = bvh->skip;
 	}
 }
 
@@ -1211,11 +1211,12 @@ void ConcavePolygonShape3DSW::cull(const AABB &p_local_aabb, Callback p_callback
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_count = bvh.size();
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	_cull(&params);
 }
 
 Vector3 ConcavePolygonShape3DSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1234,105 +1235,141 @@ struct _VolumeSW_BVH_Element {
 	int face_index;
 };
 
-struct _VolumeSW_BVH_CompareX {
-	_FORCE_INLINE_ bool operator()(const _VolumeSW_BVH_Element &a, const _VolumeSW_BVH_Element &b) const {
-		return a.center.x < b.center.x;
-	}
-};
+#define _VOLUME_SW_BVH_BINS 16
 
-struct _VolumeSW_BVH_CompareY {
-	_FORCE_INLINE_ bool operator()(const _VolumeSW_BVH_Element &a, const _VolumeSW_BVH_Element &b) const {
-		return a.center.y < b.center.y;
-	}
+struct _VolumeSW_BVH_Bin {
+	AABB aabb;
+	int count = 0;
 };
 
-struct _VolumeSW_BVH_CompareZ {
-	_FORCE_INLINE_ bool operator()(const _VolumeSW_BVH_Element &a, const _VolumeSW_BVH_Element &b) const {
-		return a.center.z < b.center.z;
-	}
-};
+static _FORCE_INLINE_ real_t _volume_sw_bvh_half_area(const AABB &p_aabb) {
+	const Vector3 &s = p_aabb.size;
+	return s.x * s.y + s.y * s.z + s.z * s.x;
+}
 
-struct _VolumeSW_BVH {
-	AABB aabb;
-	_VolumeSW_BVH *left;
-	_VolumeSW_BVH *right;
+// Splits the range with a binned surface area heuristic and returns the amount
+// of elements in the first half. Elements are partitioned in place.
+static int _volume_sw_bvh_split(_VolumeSW_BVH_Element *p_elements, int p_size) {
+	AABB center_aabb(p_elements[0].center, Vector3());
+	for (int i = 1; i < p_size; i++) {
+		center_aabb.expand_to(p_elements[i].center);
+	}
 
-	int face_index;
-};
+	int axis = center_aabb.get_longest_axis_index();
+	real_t axis_min = center_aabb.position[axis];
+	real_t axis_len = center_aabb.size[axis];
 
-_VolumeSW_BVH *_volume_sw_build_bvh(_VolumeSW_BVH_Element *p_elements, int p_size, int &count) {
-	_VolumeSW_BVH *bvh = memnew(_VolumeSW_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+	if (axis_len <= CMP_EPSILON) {
+		return p_size / 2; // all centers overlap, any split is as good as another
 	}
 
-	AABB aabb;
+	_VolumeSW_BVH_Bin bins[_VOLUME_SW_BVH_BINS];
+	real_t bin_scale = _VOLUME_SW_BVH_BINS / axis_len;
+
 	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
+		int b = MIN(int((p_elements[i].center[axis] - axis_min) * bin_scale), _VOLUME_SW_BVH_BINS - 1);
+		if (bins[b].count == 0) {
+			bins[b].aabb = p_elements[i].aabb;
 		} else {
-			aabb.merge_with(p_elements[i].aabb);
+			bins[b].aabb.merge_with(p_elements[i].aabb);
+		}
+		bins[b].count++;
+	}
+
+	// Sweep from the right to get the cost of every right half, then from the left.
+	real_t right_cost[_VOLUME_SW_BVH_BINS];
+	AABB acc;
+	int acc_count = 0;
+	for (int i = _VOLUME_SW_BVH_BINS - 1; i > 0; i--) {
+		if (bins[i].count) {
+			if (acc_count == 0) {
+				acc = bins[i].aabb;
+			} else {
+				acc.merge_with(bins[i].aabb);
+			}
+			acc_count += bins[i].count;
+		}
+		right_cost[i] = acc_count ? _volume_sw_bvh_half_area(acc) * acc_count : 0;
+	}
+
+	int best_bin = -1;
+	real_t best_cost = 0;
+	acc_count = 0;
+	for (int i = 0; i < _VOLUME_SW_BVH_BINS - 1; i++) {
+		if (bins[i].count) {
+			if (acc_count == 0) {
+				acc = bins[i].aabb;
+			} else {
+				acc.merge_with(bins[i].aabb);
+			}
+			acc_count += bins[i].count;
+		}
+
+		if (acc_count == 0 || acc_count == p_size) {
+			continue; // both halves must have elements
+		}
+
+		real_t cost = _volume_sw_bvh_half_area(acc) * acc_count + right_cost[i + 1];
+		if (best_bin == -1 || cost < best_cost) {
+			best_bin = i;
+			best_cost = cost;
 		}
 	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
-		case 0: {
-			SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
-
-		} break;
-		case 1: {
-			SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
-			SortArray<_VolumeSW_BVH_Element, _VolumeSW_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
+
+	if (best_bin == -1) {
+		return p_size / 2;
 	}
 
-	int split = p_size / 2;
-	bvh->left = _volume_sw_build_bvh(p_elements, split, count);
-	bvh->right = _volume_sw_build_bvh(&p_elements[split], p_size - split, count);
+	int left = 0;
+	for (int i = 0; i < p_size; i++) {
+		int b = MIN(int((p_elements[i].center[axis] - axis_min) * bin_scale), _VOLUME_SW_BVH_BINS - 1);
+		if (b <= best_bin) {
+			SWAP(p_elements[i], p_elements[left]);
+			left++;
+		}
+	}
 
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
+	return left;
 }
 
-void ConcavePolygonShape3DSW::_fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
+void ConcavePolygonShape3DSW::_build_bvh(_VolumeSW_BVH_Element *p_elements, int p_size, BVH *p_bvh_array) {
+	// Every leaf holds a single face, so a range of N faces always takes 2N-1
+	// nodes. This lets node indices be assigned up front and the tree be built
+	// iteratively in depth-first order, without recursion or temporary nodes.
+	struct Range {
+		int from;
+		int size;
+		int node;
+	};
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+	LocalVector<Range> stack;
+	stack.push_back({ 0, p_size, 0 });
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	while (stack.size()) {
+		Range r = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
 
-	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
+		_VolumeSW_BVH_Element *elements = &p_elements[r.from];
+		BVH &node = p_bvh_array[r.node];
+		node.skip = r.node + r.size * 2 - 1;
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+		if (r.size == 1) {
+			node.aabb = elements[0].aabb;
+			node.face_index = elements[0].face_index;
+			continue;
+		}
 
-	} else {
-		p_bvh_array[p_idx].right = -1;
-	}
+		node.face_index = -1;
+		node.aabb = elements[0].aabb;
+		for (int i = 1; i < r.size; i++) {
+			node.aabb.merge_with(elements[i].aabb);
+		}
+
+		int split = _volume_sw_bvh_split(elements, r.size);
 
-	memdelete(p_bvh_tree);
+		stack.push_back({ r.from + split, r.size - split, r.node + split * 2 });
+		stack.push_back({ r.from, split, r.node + 1 });
+	}
 }
 
 void ConcavePolygonShape3DSW::_setup(Vector<Vector3> p_faces) {
@@ -1380,15 +1417,8 @@ void ConcavePolygonShape3DSW::_setup(Vector<Vector3> p_faces) {
 		}
 	}
 
-	int count = 0;
-	_VolumeSW_BVH *bvh_tree = _volume_sw_build_bvh(bvh_arrayw, src_face_count, count);
-
-	bvh.resize(count + 1);
-
-	BVH *bvh_arrayw2 = bvh.ptrw();
-
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	bvh.resize(src_face_count * 2 - 1);
+	_build_bvh(bvh_arrayw, src_face_count, bvh.ptrw());
 
 	configure(_aabb); // this type of shape has no margin
 }
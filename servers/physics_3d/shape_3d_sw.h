@@ -276,7 +276,7 @@ public:
 	ConvexPolygonShape3DSW();
 };
 
-struct _VolumeSW_BVH;
+struct _VolumeSW_BVH_Element;
 struct FaceShape3DSW;
 
 struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
@@ -290,12 +290,13 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Nodes are stored in depth-first order, so the first child of a branch is
+	// always the next node. When a node is rejected (or is a leaf), traversal
+	// continues at 'skip', which makes culling stackless.
 	struct BVH {
 		AABB aabb;
-		int left;
-		int right;
-
-		int face_index;
+		int skip;
+		int face_index; // -1 for branches
 	};
 
 	Vector<BVH> bvh;
@@ -307,6 +308,7 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 		const Face *faces;
 		const Vector3 *vertices;
 		const BVH *bvh;
+		int bvh_count;
 		FaceShape3DSW *face;
 	};
 
@@ -316,6 +318,7 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 		const Face *faces;
 		const Vector3 *vertices;
 		const BVH *bvh;
+		int bvh_count;
 		Vector3 dir;
 
 		Vector3 result;
@@ -324,10 +327,10 @@ struct ConcavePolygonShape3DSW : public ConcaveShape3DSW {
 		int collisions;
 	};
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	void _cull(int p_idx, _CullParams *p_params) const;
+	void _cull_segment(_SegmentCullParams *p_params) const;
+	void _cull(_CullParams *p_params) const;
 
-	void _fill_bvh(_VolumeSW_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	void _build_bvh(_VolumeSW_BVH_Element *p_elements, int p_size, BVH *p_bvh_array);
 
 	void _setup(Vector<Vector3> p_faces);
 
@@ -52,7 +52,7 @@ _FORCE_INLINE_ static bool _can_collide_with(CollisionObject3DSW *p_object, uint
 
 int PhysicsDirectSpaceState3DSW::intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	ERR_FAIL_COND_V(space->locked, false);
-	int amount = space->broadphase->cull_point(p_point, space->intersection_query_results, Space3DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_point(p_point, space->query_context.results, Space3DSW::INTERSECTION_QUERY_MAX, space->query_context.subindex_results);
 	int cc = 0;
 
 	//Transform ai = p_xform.affine_inverse();
@@ -62,18 +62,18 @@ int PhysicsDirectSpaceState3DSW::intersect_point(const Vector3 &p_point, ShapeRe
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+		if (!_can_collide_with(space->query_context.results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_exclude.has(space->query_context.results[i]->get_self())) {
 			continue;
 		}
 
-		const CollisionObject3DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObject3DSW *col_obj = space->query_context.results[i];
+		int shape_idx = space->query_context.subindex_results[i];
 
 		Transform inv_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		inv_xform.affine_invert();
@@ -106,7 +106,7 @@ bool PhysicsDirectSpaceState3DSW::intersect_ray(const Vector3 &p_from, const Vec
 	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, Space3DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, space->query_context.results, Space3DSW::INTERSECTION_QUERY_MAX, space->query_context.subindex_results);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -117,21 +117,21 @@ bool PhysicsDirectSpaceState3DSW::intersect_ray(const Vector3 &p_from, const Vec
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+		if (!_can_collide_with(space->query_context.results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		if (p_pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_pick_ray && !(space->query_context.results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_exclude.has(space->query_context.results[i]->get_self())) {
 			continue;
 		}
 
-		const CollisionObject3DSW *col_obj = space->intersection_query_results[i];
+		const CollisionObject3DSW *col_obj = space->query_context.results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = space->query_context.subindex_results[i];
 		Transform inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -186,7 +186,7 @@ int PhysicsDirectSpaceState3DSW::intersect_shape(const RID &p_shape, const Trans
 
 	AABB aabb = p_xform.xform(shape->get_aabb());
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space3DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->query_context.results, Space3DSW::INTERSECTION_QUERY_MAX, space->query_context.subindex_results);
 
 	int cc = 0;
 
@@ -197,18 +197,18 @@ int PhysicsDirectSpaceState3DSW::intersect_shape(const RID &p_shape, const Trans
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+		if (!_can_collide_with(space->query_context.results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_exclude.has(space->query_context.results[i]->get_self())) {
 			continue;
 		}
 
-		const CollisionObject3DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObject3DSW *col_obj = space->query_context.results[i];
+		int shape_idx = space->query_context.subindex_results[i];
 
 		if (!CollisionSolver3DSW::solve_static(shape, p_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_margin, 0)) {
 			continue;
@@ -239,7 +239,7 @@ bool PhysicsDirectSpaceState3DSW::cast_motion(const RID &p_shape, const Transfor
 	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space3DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->query_context.results, Space3DSW::INTERSECTION_QUERY_MAX, space->query_context.subindex_results);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
@@ -254,16 +254,16 @@ bool PhysicsDirectSpaceState3DSW::cast_motion(const RID &p_shape, const Transfor
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+		if (!_can_collide_with(space->query_context.results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		if (p_exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_exclude.has(space->query_context.results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const CollisionObject3DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObject3DSW *col_obj = space->query_context.results[i];
+		int shape_idx = space->query_context.subindex_results[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = p_motion.normalized();
@@ -346,7 +346,7 @@ bool PhysicsDirectSpaceState3DSW::collide_shape(RID p_shape, const Transform &p_
 	AABB aabb = p_shape_xform.xform(shape->get_aabb());
 	aabb = aabb.grow(p_margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space3DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->query_context.results, Space3DSW::INTERSECTION_QUERY_MAX, space->query_context.subindex_results);
 
 	bool collided = false;
 	r_result_count = 0;
@@ -360,12 +360,12 @@ bool PhysicsDirectSpaceState3DSW::collide_shape(RID p_shape, const Transform &p_
 	PhysicsServer3DSW::CollCbkData *cbkptr = &cbk;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+		if (!_can_collide_with(space->query_context.results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		const CollisionObject3DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObject3DSW *col_obj = space->query_context.results[i];
+		int shape_idx = space->query_context.subindex_results[i];
 
 		if (p_exclude.has(col_obj->get_self())) {
 			continue;
@@ -418,7 +418,7 @@ bool PhysicsDirectSpaceState3DSW::rest_info(RID p_shape, const Transform &p_shap
 	AABB aabb = p_shape_xform.xform(shape->get_aabb());
 	aabb = aabb.grow(p_margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space3DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, space->query_context.results, Space3DSW::INTERSECTION_QUERY_MAX, space->query_context.subindex_results);
 
 	_RestCallbackData rcd;
 	rcd.best_len = 0;
@@ -427,12 +427,12 @@ bool PhysicsDirectSpaceState3DSW::rest_info(RID p_shape, const Transform &p_shap
 	rcd.min_allowed_depth = space->test_motion_min_contact_depth;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
+		if (!_can_collide_with(space->query_context.results[i], p_collision_mask, p_collide_with_bodies, p_collide_with_areas)) {
 			continue;
 		}
 
-		const CollisionObject3DSW *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const CollisionObject3DSW *col_obj = space->query_context.results[i];
+		int shape_idx = space->query_context.subindex_results[i];
 
 		if (p_exclude.has(col_obj->get_self())) {
 			continue;
@@ -513,8 +513,18 @@ PhysicsDirectSpaceState3DSW::PhysicsDirectSpaceState3DSW() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int Space3DSW::_cull_aabb_for_body(Body3DSW *p_body, const AABB &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+int Space3DSW::_cull_aabb_for_body(QueryContext &r_context, Body3DSW *p_body, const AABB &p_aabb) {
+	CollisionObject3DSW **intersection_query_results = r_context.results;
+	int *intersection_query_subindex_results = r_context.subindex_results;
+
+	int amount;
+	if (r_context.threaded) {
+		// The broadphase keeps per-query pass counters, so culls can't overlap.
+		MutexLock lock(broadphase_query_mutex);
+		amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	} else {
+		amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	}
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
@@ -595,7 +605,7 @@ int Space3DSW::test_body_ray_separation(Body3DSW *p_body, const Transform &p_tra
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = _cull_aabb_for_body(query_context, p_body, body_aabb);
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_set_as_disabled(j)) {
@@ -611,8 +621,8 @@ int Space3DSW::test_body_ray_separation(Body3DSW *p_body, const Transform &p_tra
 				Transform body_shape_xform = body_transform * p_body->get_shape_transform(j);
 
 				for (int i = 0; i < amount; i++) {
-					const CollisionObject3DSW *col_obj = intersection_query_results[i];
-					int shape_idx = intersection_query_subindex_results[i];
+					const CollisionObject3DSW *col_obj = query_context.results[i];
+					int shape_idx = query_context.subindex_results[i];
 
 					cbk.amount = 0;
 					cbk.ptr = sr;
@@ -699,6 +709,10 @@ int Space3DSW::test_body_ray_separation(Body3DSW *p_body, const Transform &p_tra
 }
 
 bool Space3DSW::test_body_motion(Body3DSW *p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer3D::MotionResult *r_result, bool p_exclude_raycast_shapes) {
+	return _test_body_motion(query_context, p_body, p_from, p_motion, p_infinite_inertia, p_margin, r_result, p_exclude_raycast_shapes);
+}
+
+bool Space3DSW::_test_body_motion(QueryContext &r_context, Body3DSW *p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer3D::MotionResult *r_result, bool p_exclude_raycast_shapes) {
 	//give me back regular physics engine logic
 	//this is madness
 	//and most people using this function will think
@@ -759,7 +773,7 @@ bool Space3DSW::test_body_motion(Body3DSW *p_body, const Transform &p_from, cons
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = _cull_aabb_for_body(r_context, p_body, body_aabb);
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_set_as_disabled(j)) {
@@ -773,8 +787,8 @@ bool Space3DSW::test_body_motion(Body3DSW *p_body, const Transform &p_from, cons
 				}
 
 				for (int i = 0; i < amount; i++) {
-					const CollisionObject3DSW *col_obj = intersection_query_results[i];
-					int shape_idx = intersection_query_subindex_results[i];
+					const CollisionObject3DSW *col_obj = r_context.results[i];
+					int shape_idx = r_context.subindex_results[i];
 
 					if (CollisionSolver3DSW::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, p_margin)) {
 						collided = cbk.amount > 0;
@@ -818,7 +832,7 @@ bool Space3DSW::test_body_motion(Body3DSW *p_body, const Transform &p_from, cons
 		motion_aabb.position += p_motion;
 		motion_aabb = motion_aabb.merge(body_aabb);
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+		int amount = _cull_aabb_for_body(r_context, p_body, motion_aabb);
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 			if (p_body->is_shape_set_as_disabled(j)) {
@@ -843,8 +857,8 @@ bool Space3DSW::test_body_motion(Body3DSW *p_body, const Transform &p_from, cons
 			real_t best_unsafe = 1;
 
 			for (int i = 0; i < amount; i++) {
-				const CollisionObject3DSW *col_obj = intersection_query_results[i];
-				int shape_idx = intersection_query_subindex_results[i];
+				const CollisionObject3DSW *col_obj = r_context.results[i];
+				int shape_idx = r_context.subindex_results[i];
 
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
@@ -937,11 +951,11 @@ bool Space3DSW::test_body_motion(Body3DSW *p_body, const Transform &p_from, cons
 
 		body_aabb.position += p_motion * unsafe;
 
-		int amount = _cull_aabb_for_body(p_body, body_aabb);
+		int amount = _cull_aabb_for_body(r_context, p_body, body_aabb);
 
 		for (int i = 0; i < amount; i++) {
-			const CollisionObject3DSW *col_obj = intersection_query_results[i];
-			int shape_idx = intersection_query_subindex_results[i];
+			const CollisionObject3DSW *col_obj = r_context.results[i];
+			int shape_idx = r_context.subindex_results[i];
 
 			rcd.object = col_obj;
 			rcd.shape = shape_idx;
@@ -986,6 +1000,201 @@ bool Space3DSW::test_body_motion(Body3DSW *p_body, const Transform &p_from, cons
 	return collided;
 }
 
+void Space3DSW::_test_body_motion_job(uint32_t p_index, MotionQuery *p_queries) {
+	QueryContext context;
+	context.threaded = true;
+	MotionQuery &q = p_queries[p_index];
+	q.collided = _test_body_motion(context, q.body, q.from, q.motion, q.infinite_inertia, q.margin, q.result, q.exclude_raycast_shapes);
+}
+
+void Space3DSW::test_body_motions(ThreadWorkPool &p_pool, MotionQuery *p_queries, int p_count) {
+	if (p_count == 1) {
+		p_queries[0].collided = test_body_motion(p_queries[0].body, p_queries[0].from, p_queries[0].motion, p_queries[0].infinite_inertia, p_queries[0].margin, p_queries[0].result, p_queries[0].exclude_raycast_shapes);
+		return;
+	}
+
+	// Motion tests only read the space, so they can run in parallel as long as
+	// each one uses its own query context.
+	p_pool.do_work(p_count, this, &Space3DSW::_test_body_motion_job, p_queries);
+}
+
+#define SPACE_SNAPSHOT_MAGIC 0x33535350 // "PSS3"
+
+// Snapshot layout, all in native byte order as snapshots never leave the running process:
+//  uint32 magic, uint32 body count
+//  for each body: uint64 rid, Body3DSW::Snapshot
+//  uint32 constraint count
+//  for each constraint: uint32 body count, uint64 rid for each body, uint64 order key, uint32 size, cached state
+
+template <class T>
+static _FORCE_INLINE_ void _snapshot_put(uint8_t *&r_ptr, const T &p_value) {
+	copymem(r_ptr, &p_value, sizeof(T));
+	r_ptr += sizeof(T);
+}
+
+template <class T>
+static _FORCE_INLINE_ bool _snapshot_get(const uint8_t *&r_ptr, const uint8_t *p_end, T &r_value) {
+	if (r_ptr + sizeof(T) > p_end) {
+		return false;
+	}
+	copymem(&r_value, r_ptr, sizeof(T));
+	r_ptr += sizeof(T);
+	return true;
+}
+
+Vector<uint8_t> Space3DSW::get_snapshot() const {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Can't take a snapshot of a space while it's being stepped.");
+
+	LocalVector<const Body3DSW *> bodies;
+	LocalVector<const Constraint3DSW *> constraints;
+
+	uint32_t size = sizeof(uint32_t) * 3;
+
+	for (const Set<CollisionObject3DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject3DSW::TYPE_BODY) {
+			continue;
+		}
+		const Body3DSW *body = static_cast<const Body3DSW *>(E->get());
+		bodies.push_back(body);
+		size += sizeof(uint64_t) + sizeof(Body3DSW::Snapshot);
+
+		for (const Map<Constraint3DSW *, int>::Element *C = body->get_constraint_map().front(); C; C = C->next()) {
+			const Constraint3DSW *constraint = C->key();
+			// Save each constraint once, through its first body.
+			if (constraint->get_body_count() == 0 || constraint->get_body_ptr()[0] != body || constraint->get_cached_state_size() == 0) {
+				continue;
+			}
+			constraints.push_back(constraint);
+			size += sizeof(uint32_t) * 2 + sizeof(uint64_t) * (constraint->get_body_count() + 1) + constraint->get_cached_state_size();
+		}
+	}
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(size);
+	uint8_t *w = snapshot.ptrw();
+
+	_snapshot_put<uint32_t>(w, SPACE_SNAPSHOT_MAGIC);
+	_snapshot_put<uint32_t>(w, bodies.size());
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		Body3DSW::Snapshot body_snapshot;
+		bodies[i]->save_snapshot(body_snapshot);
+		_snapshot_put<uint64_t>(w, bodies[i]->get_self().get_id());
+		_snapshot_put(w, body_snapshot);
+	}
+
+	_snapshot_put<uint32_t>(w, constraints.size());
+	for (uint32_t i = 0; i < constraints.size(); i++) {
+		const Constraint3DSW *constraint = constraints[i];
+		_snapshot_put<uint32_t>(w, constraint->get_body_count());
+		for (int j = 0; j < constraint->get_body_count(); j++) {
+			_snapshot_put<uint64_t>(w, constraint->get_body_ptr()[j]->get_self().get_id());
+		}
+		_snapshot_put<uint64_t>(w, constraint->get_order_key());
+		uint32_t state_size = constraint->get_cached_state_size();
+		_snapshot_put<uint32_t>(w, state_size);
+		constraint->save_cached_state(w);
+		w += state_size;
+	}
+
+	return snapshot;
+}
+
+Error Space3DSW::restore_snapshot(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_V_MSG(locked, ERR_LOCKED, "Can't restore a snapshot of a space while it's being stepped.");
+
+	const uint8_t *r = p_snapshot.ptr();
+	const uint8_t *end = r + p_snapshot.size();
+
+	uint32_t magic = 0;
+	uint32_t body_count = 0;
+	ERR_FAIL_COND_V(!_snapshot_get(r, end, magic) || magic != SPACE_SNAPSHOT_MAGIC, ERR_FILE_UNRECOGNIZED);
+	ERR_FAIL_COND_V(!_snapshot_get(r, end, body_count), ERR_FILE_CORRUPT);
+
+	HashMap<uint64_t, Body3DSW *> bodies;
+	for (const Set<CollisionObject3DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() == CollisionObject3DSW::TYPE_BODY) {
+			bodies[E->get()->get_self().get_id()] = static_cast<Body3DSW *>(E->get());
+		}
+	}
+
+	for (uint32_t i = 0; i < body_count; i++) {
+		uint64_t rid = 0;
+		Body3DSW::Snapshot body_snapshot;
+		ERR_FAIL_COND_V(!_snapshot_get(r, end, rid) || !_snapshot_get(r, end, body_snapshot), ERR_FILE_CORRUPT);
+
+		Body3DSW **body = bodies.getptr(rid);
+		if (!body) {
+			continue; // removed since the snapshot was taken
+		}
+		(*body)->restore_snapshot(body_snapshot);
+	}
+
+	// Moving the bodies re-paired them in the broadphase, so every pair that
+	// existed when the snapshot was taken exists again. Start from clean caches
+	// and fill in the saved ones.
+	broadphase->update();
+
+	for (const Set<CollisionObject3DSW *>::Element *E = objects.front(); E; E = E->next()) {
+		if (E->get()->get_type() != CollisionObject3DSW::TYPE_BODY) {
+			continue;
+		}
+		const Body3DSW *body = static_cast<const Body3DSW *>(E->get());
+		for (const Map<Constraint3DSW *, int>::Element *C = body->get_constraint_map().front(); C; C = C->next()) {
+			C->key()->clear_cached_state();
+		}
+	}
+
+	uint32_t constraint_count = 0;
+	ERR_FAIL_COND_V(!_snapshot_get(r, end, constraint_count), ERR_FILE_CORRUPT);
+
+	for (uint32_t i = 0; i < constraint_count; i++) {
+		uint32_t constraint_body_count = 0;
+		ERR_FAIL_COND_V(!_snapshot_get(r, end, constraint_body_count) || constraint_body_count == 0, ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(r + sizeof(uint64_t) * constraint_body_count > end, ERR_FILE_CORRUPT);
+		const uint8_t *rids = r;
+		r += sizeof(uint64_t) * constraint_body_count;
+
+		uint64_t order_key = 0;
+		uint32_t state_size = 0;
+		ERR_FAIL_COND_V(!_snapshot_get(r, end, order_key) || !_snapshot_get(r, end, state_size), ERR_FILE_CORRUPT);
+		ERR_FAIL_COND_V(r + state_size > end, ERR_FILE_CORRUPT);
+		const uint8_t *state = r;
+		r += state_size;
+
+		uint64_t first_rid;
+		copymem(&first_rid, rids, sizeof(uint64_t));
+		Body3DSW **first_body = bodies.getptr(first_rid);
+		if (!first_body) {
+			continue;
+		}
+
+		for (const Map<Constraint3DSW *, int>::Element *C = (*first_body)->get_constraint_map().front(); C; C = C->next()) {
+			Constraint3DSW *constraint = C->key();
+			// Don't compare the cached state size, it shrank when the caches were cleared above.
+			if (constraint->get_body_count() != int(constraint_body_count) || constraint->get_order_key() != order_key) {
+				continue;
+			}
+
+			bool match = true;
+			for (uint32_t j = 0; j < constraint_body_count; j++) {
+				uint64_t rid;
+				copymem(&rid, rids + sizeof(uint64_t) * j, sizeof(uint64_t));
+				if (constraint->get_body_ptr()[j]->get_self().get_id() != rid) {
+					match = false;
+					break;
+				}
+			}
+
+			if (match) {
+				constraint->load_cached_state(state, state_size);
+				break;
+			}
+		}
+	}
+
+	return OK;
+}
+
 void *Space3DSW::_broadphase_pair(CollisionObject3DSW *A, int p_subindex_A, CollisionObject3DSW *B, int p_subindex_B, void *p_self) {
 	CollisionObject3DSW::Type type_A = A->get_type();
 	CollisionObject3DSW::Type type_B = B->get_type();
@@ -1011,6 +1220,11 @@ void *Space3DSW::_broadphase_pair(CollisionObject3DSW *A, int p_subindex_A, Coll
 			return area_pair;
 		}
 	} else {
+		if (B->get_self() < A->get_self()) {
+			// Keep a stable body order, so pairs match again after restoring a snapshot.
+			SWAP(A, B);
+			SWAP(p_subindex_A, p_subindex_B);
+		}
 		BodyPair3DSW *b = memnew(BodyPair3DSW((Body3DSW *)A, p_subindex_A, (Body3DSW *)B, p_subindex_B));
 		return b;
 	}
@@ -38,7 +38,9 @@
 #include "broad_phase_3d_sw.h"
 #include "collision_object_3d_sw.h"
 #include "core/hash_map.h"
+#include "core/os/mutex.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "core/typedefs.h"
 
 class PhysicsDirectSpaceState3DSW : public PhysicsDirectSpaceState3D {
@@ -101,8 +103,16 @@ private:
 		INTERSECTION_QUERY_MAX = 2048
 	};
 
-	CollisionObject3DSW *intersection_query_results[INTERSECTION_QUERY_MAX];
-	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
+	// Broadphase query results. Every thread running motion tests needs its own,
+	// the one in the space is used by the direct state and the calling thread.
+	struct QueryContext {
+		CollisionObject3DSW *results[INTERSECTION_QUERY_MAX];
+		int subindex_results[INTERSECTION_QUERY_MAX];
+		bool threaded = false; // Batched motion tests cull concurrently and must lock the broadphase.
+	};
+
+	QueryContext query_context;
+	Mutex broadphase_query_mutex;
 
 	real_t body_linear_velocity_sleep_threshold;
 	real_t body_angular_velocity_sleep_threshold;
@@ -110,6 +120,7 @@ private:
 	real_t body_angular_velocity_damp_ratio;
 
 	bool locked;
+	bool deterministic = false;
 
 	int island_count;
 	int active_objects;
@@ -122,7 +133,8 @@ private:
 
 	friend class PhysicsDirectSpaceState3DSW;
 
-	int _cull_aabb_for_body(Body3DSW *p_body, const AABB &p_aabb);
+	int _cull_aabb_for_body(QueryContext &r_context, Body3DSW *p_body, const AABB &p_aabb);
+	bool _test_body_motion(QueryContext &r_context, Body3DSW *p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer3D::MotionResult *r_result, bool p_exclude_raycast_shapes);
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
@@ -195,12 +207,35 @@ public:
 	void set_static_global_body(RID p_body) { static_global_body = p_body; }
 	RID get_static_global_body() { return static_global_body; }
 
+	void set_deterministic(bool p_enable) { deterministic = p_enable; }
+	bool is_deterministic() const { return deterministic; }
+
+	Vector<uint8_t> get_snapshot() const;
+	Error restore_snapshot(const Vector<uint8_t> &p_snapshot);
+
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
 	int test_body_ray_separation(Body3DSW *p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, PhysicsServer3D::SeparationResult *r_results, int p_result_max, real_t p_margin);
 	bool test_body_motion(Body3DSW *p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer3D::MotionResult *r_result, bool p_exclude_raycast_shapes);
 
+	struct MotionQuery {
+		Body3DSW *body = nullptr;
+		Transform from;
+		Vector3 motion;
+		bool infinite_inertia = false;
+		real_t margin = 0.001;
+		bool exclude_raycast_shapes = true;
+		PhysicsServer3D::MotionResult *result = nullptr;
+		bool collided = false;
+	};
+
+private:
+	void _test_body_motion_job(uint32_t p_index, MotionQuery *p_queries);
+
+public:
+	void test_body_motions(ThreadWorkPool &p_pool, MotionQuery *p_queries, int p_count);
+
 	Space3DSW();
 	~Space3DSW();
 };
@@ -139,6 +139,37 @@ void Step3DSW::_check_suspend(Body3DSW *p_island, real_t p_delta) {
 	}
 }
 
+struct _ConstraintOrder3DSW {
+	_FORCE_INLINE_ bool operator()(const Constraint3DSW *p_a, const Constraint3DSW *p_b) const {
+		if (p_a->get_body_count() != p_b->get_body_count()) {
+			return p_a->get_body_count() < p_b->get_body_count();
+		}
+		for (int i = 0; i < p_a->get_body_count(); i++) {
+			RID rid_a = p_a->get_body_ptr()[i]->get_self();
+			RID rid_b = p_b->get_body_ptr()[i]->get_self();
+			if (rid_a != rid_b) {
+				return rid_a < rid_b;
+			}
+		}
+		return p_a->get_order_key() < p_b->get_order_key();
+	}
+};
+
+Constraint3DSW *Step3DSW::_sort_island(Constraint3DSW *p_island) {
+	island_sort_buffer.clear();
+	for (Constraint3DSW *c = p_island; c; c = c->get_island_next()) {
+		island_sort_buffer.push_back(c);
+	}
+
+	island_sort_buffer.sort_custom<_ConstraintOrder3DSW>();
+
+	for (uint32_t i = 0; i < island_sort_buffer.size(); i++) {
+		island_sort_buffer[i]->set_island_next(i + 1 < island_sort_buffer.size() ? island_sort_buffer[i + 1] : nullptr);
+	}
+
+	return island_sort_buffer[0];
+}
+
 void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 	p_space->lock(); // can't access space during this
 
@@ -198,6 +229,24 @@ void Step3DSW::step(Space3DSW *p_space, real_t p_delta, int p_iterations) {
 
 	p_space->set_island_count(island_count);
 
+	if (p_space->is_deterministic()) {
+		// Solving order changes the results, don't let it depend on memory addresses.
+		Constraint3DSW *prev = nullptr;
+		Constraint3DSW *ci = constraint_island_list;
+		while (ci) {
+			Constraint3DSW *next = ci->get_island_list_next();
+			Constraint3DSW *sorted = _sort_island(ci);
+			sorted->set_island_list_next(next);
+			if (prev) {
+				prev->set_island_list_next(sorted);
+			} else {
+				constraint_island_list = sorted;
+			}
+			prev = sorted;
+			ci = next;
+		}
+	}
+
 	const SelfList<Area3DSW>::List &aml = p_space->get_moved_area_list();
 
 	while (aml.first()) {
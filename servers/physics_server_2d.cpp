@@ -517,6 +517,47 @@ bool PhysicsServer2D::_body_test_motion(RID p_body, const Transform2D &p_from, c
 	return body_test_motion(p_body, p_from, p_motion, p_infinite_inertia, p_margin, r);
 }
 
+Array PhysicsServer2D::_body_test_motions(const Array &p_bodies, const Array &p_from, const PackedVector2Array &p_motions, bool p_infinite_inertia, float p_margin, const Array &p_results) {
+	ERR_FAIL_COND_V(p_from.size() != p_bodies.size(), Array());
+	ERR_FAIL_COND_V(p_motions.size() != p_bodies.size(), Array());
+	ERR_FAIL_COND_V(!p_results.empty() && p_results.size() != p_bodies.size(), Array());
+
+	Vector<MotionQuery> queries;
+	queries.resize(p_bodies.size());
+	MotionQuery *qw = queries.ptrw();
+
+	for (int i = 0; i < queries.size(); i++) {
+		qw[i].body = p_bodies[i];
+		qw[i].from = p_from[i];
+		qw[i].motion = p_motions[i];
+		qw[i].infinite_inertia = p_infinite_inertia;
+		qw[i].margin = p_margin;
+		qw[i].exclude_raycast_shapes = true;
+		if (!p_results.empty()) {
+			Ref<PhysicsTestMotionResult2D> result = p_results[i];
+			if (result.is_valid()) {
+				qw[i].result = result->get_result_ptr();
+			}
+		}
+	}
+
+	body_test_motions(qw, queries.size());
+
+	Array ret;
+	ret.resize(queries.size());
+	for (int i = 0; i < queries.size(); i++) {
+		ret[i] = queries[i].collided;
+	}
+	return ret;
+}
+
+void PhysicsServer2D::body_test_motions(MotionQuery *p_queries, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		MotionQuery &q = p_queries[i];
+		q.collided = body_test_motion(q.body, q.from, q.motion, q.infinite_inertia, q.margin, q.result, q.exclude_raycast_shapes);
+	}
+}
+
 void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("line_shape_create"), &PhysicsServer2D::line_shape_create);
 	ClassDB::bind_method(D_METHOD("ray_shape_create"), &PhysicsServer2D::ray_shape_create);
@@ -538,6 +579,10 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_set_deterministic", "space", "enable"), &PhysicsServer2D::space_set_deterministic);
+	ClassDB::bind_method(D_METHOD("space_is_deterministic", "space"), &PhysicsServer2D::space_is_deterministic);
+	ClassDB::bind_method(D_METHOD("space_get_snapshot", "space"), &PhysicsServer2D::space_get_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore_snapshot", "space", "snapshot"), &PhysicsServer2D::space_restore_snapshot);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
@@ -642,6 +687,7 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_set_force_integration_callback", "body", "receiver", "method", "userdata"), &PhysicsServer2D::body_set_force_integration_callback, DEFVAL(Variant()));
 
 	ClassDB::bind_method(D_METHOD("body_test_motion", "body", "from", "motion", "infinite_inertia", "margin", "result"), &PhysicsServer2D::_body_test_motion, DEFVAL(0.08), DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("body_test_motions", "bodies", "from", "motions", "infinite_inertia", "margin", "results"), &PhysicsServer2D::_body_test_motions, DEFVAL(0.08), DEFVAL(Array()));
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &PhysicsServer2D::body_get_direct_state);
 
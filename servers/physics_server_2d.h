@@ -228,6 +228,7 @@ class PhysicsServer2D : public Object {
 	static PhysicsServer2D *singleton;
 
 	virtual bool _body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, float p_margin = 0.08, const Ref<PhysicsTestMotionResult2D> &p_result = Ref<PhysicsTestMotionResult2D>());
+	Array _body_test_motions(const Array &p_bodies, const Array &p_from, const PackedVector2Array &p_motions, bool p_infinite_inertia, float p_margin = 0.08, const Array &p_results = Array());
 
 protected:
 	static void _bind_methods();
@@ -290,6 +291,13 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) = 0;
 
+	virtual void space_set_deterministic(RID p_space, bool p_enable) = 0;
+	virtual bool space_is_deterministic(RID p_space) const = 0;
+
+	// snapshots are only valid within the running process, and only outside of the step
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const = 0;
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) = 0;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) = 0;
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
@@ -506,6 +514,20 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, float p_margin = 0.001, MotionResult *r_result = nullptr, bool p_exclude_raycast_shapes = true) = 0;
 
+	struct MotionQuery {
+		RID body;
+		Transform2D from;
+		Vector2 motion;
+		bool infinite_inertia = false;
+		real_t margin = 0.001;
+		bool exclude_raycast_shapes = true;
+		MotionResult *result = nullptr;
+		bool collided = false;
+	};
+
+	// Runs several motion tests at once, servers may spread them over threads.
+	virtual void body_test_motions(MotionQuery *p_queries, int p_count);
+
 	struct SeparationResult {
 		float collision_depth;
 		Vector2 collision_point;
@@ -390,6 +390,13 @@ void PhysicsShapeQueryResult3D::_bind_methods() {
 
 ///////////////////////////////////////
 
+void PhysicsServer3D::body_test_motions(MotionQuery *p_queries, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		MotionQuery &q = p_queries[i];
+		q.collided = body_test_motion(q.body, q.from, q.motion, q.infinite_inertia, q.result, q.exclude_raycast_shapes);
+	}
+}
+
 void PhysicsServer3D::_bind_methods() {
 #ifndef _3D_DISABLED
 
@@ -405,6 +412,10 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_set_deterministic", "space", "enable"), &PhysicsServer3D::space_set_deterministic);
+	ClassDB::bind_method(D_METHOD("space_is_deterministic", "space"), &PhysicsServer3D::space_is_deterministic);
+	ClassDB::bind_method(D_METHOD("space_get_snapshot", "space"), &PhysicsServer3D::space_get_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore_snapshot", "space", "snapshot"), &PhysicsServer3D::space_restore_snapshot);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -275,6 +275,13 @@ public:
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) = 0;
 
+	virtual void space_set_deterministic(RID p_space, bool p_enable) = 0;
+	virtual bool space_is_deterministic(RID p_space) const = 0;
+
+	// snapshots are only valid within the running process, and only outside of the step
+	virtual Vector<uint8_t> space_get_snapshot(RID p_space) const = 0;
+	virtual Error space_restore_snapshot(RID p_space, const Vector<uint8_t> &p_snapshot) = 0;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) = 0;
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
@@ -493,6 +500,19 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, MotionResult *r_result = nullptr, bool p_exclude_raycast_shapes = true) = 0;
 
+	struct MotionQuery {
+		RID body;
+		Transform from;
+		Vector3 motion;
+		bool infinite_inertia = false;
+		bool exclude_raycast_shapes = true;
+		MotionResult *result = nullptr;
+		bool collided = false;
+	};
+
+	// Runs several motion tests at once, servers may spread them over threads.
+	virtual void body_test_motions(MotionQuery *p_queries, int p_count);
+
 	struct SeparationResult {
 		float collision_depth;
 		Vector3 collision_point;
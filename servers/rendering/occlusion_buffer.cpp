@@ -0,0 +1,310 @@
+/*************************************************************************/
+/*  occlusion_buffer.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "occlusion_buffer.h"
+
+#include "core/oa_hash_map.h"
+
+#define OCCLUSION_BUFFER_CLEAR_DEPTH 1e20
+
+void OcclusionBuffer::begin(const CameraMatrix &p_projection, const Transform &p_cam_transform) {
+	view_projection = p_projection * CameraMatrix(p_cam_transform.affine_inverse());
+
+	// keep the aspect of the view, works for both perspective and orthogonal projections
+	width = BUFFER_WIDTH;
+	height = CLAMP(int(width * Math::abs(p_projection.matrix[0][0] / p_projection.matrix[1][1])), 1, BUFFER_WIDTH * 4);
+
+	if (mips.size() == 0 || mips[0].width != width || mips[0].height != height) {
+		mips.clear();
+		int w = width;
+		int h = height;
+		while (true) {
+			Mip mip;
+			mip.width = w;
+			mip.height = h;
+			mip.depth.resize(w * h);
+			mips.push_back(mip);
+			if (w == 1 && h == 1) {
+				break;
+			}
+			w = MAX(1, (w + 1) >> 1);
+			h = MAX(1, (h + 1) >> 1);
+		}
+	}
+
+	float *depth = mips[0].depth.ptr();
+	for (int i = 0; i < width * height; i++) {
+		depth[i] = OCCLUSION_BUFFER_CLEAR_DEPTH;
+	}
+}
+
+void OcclusionBuffer::build_edge_neighbors(const int *p_indices, int p_index_count, LocalVector<int> &r_neighbors) {
+	r_neighbors.resize(p_index_count);
+
+	OAHashMap<uint64_t, int> edges; // edge to the index that starts it, -1 once the edge has two triangles
+	for (int i = 0; i < p_index_count; i++) {
+		int triangle = i - i % 3;
+		int a = p_indices[i];
+		int b = p_indices[triangle + (i + 1) % 3];
+		uint64_t key = a < b ? (uint64_t(a) << 32) | uint32_t(b) : (uint64_t(b) << 32) | uint32_t(a);
+
+		r_neighbors[i] = -1;
+
+		int *other = edges.lookup_ptr(key);
+		if (!other) {
+			edges.insert(key, i);
+		} else if (*other != -1) {
+			int other_triangle = *other - *other % 3;
+			r_neighbors[i] = p_indices[other_triangle + (*other + 2) % 3];
+			r_neighbors[*other] = p_indices[triangle + (i + 2) % 3];
+			*other = -1;
+		} else {
+			// More than two triangles on this edge, treat it as open everywhere.
+			for (int j = 0; j < i; j++) {
+				int t = j - j % 3;
+				int ja = p_indices[j];
+				int jb = p_indices[t + (j + 1) % 3];
+				if ((ja == a && jb == b) || (ja == b && jb == a)) {
+					r_neighbors[j] = -1;
+				}
+			}
+		}
+	}
+}
+
+bool OcclusionBuffer::_is_inner_edge(const int *p_triangle, int p_edge, int p_neighbor) const {
+	// An edge is inside the occluder's silhouette when the neighbouring triangle
+	// lies on the other side of it on screen, otherwise the mesh folds there.
+	if (p_neighbor < 0 || _is_behind_near(clip_vertices[p_neighbor])) {
+		return false;
+	}
+
+	const Vector3 &a = screen_vertices[p_triangle[p_edge]];
+	const Vector3 &b = screen_vertices[p_triangle[(p_edge + 1) % 3]];
+	const Vector3 &c = screen_vertices[p_triangle[(p_edge + 2) % 3]];
+	const Vector3 &d = screen_vertices[p_neighbor];
+
+	real_t side_c = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	real_t side_d = (b.x - a.x) * (d.y - a.y) - (b.y - a.y) * (d.x - a.x);
+	return side_c * side_d < 0;
+}
+
+void OcclusionBuffer::_rasterize_triangle(const Vector3 *p_vertices[3], const bool p_inner[3]) {
+	// Edge i is the one opposite to vertex i.
+	Vector3 v[3] = { *p_vertices[0], *p_vertices[1], *p_vertices[2] };
+	bool inner[3] = { p_inner[0], p_inner[1], p_inner[2] };
+
+	real_t area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[1].y - v[0].y) * (v[2].x - v[0].x);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+	if (area < 0) {
+		// occluders are double sided
+		SWAP(v[1], v[2]);
+		SWAP(inner[1], inner[2]);
+		area = -area;
+	}
+
+	int min_x = MAX(0, int(Math::floor(MIN(v[0].x, MIN(v[1].x, v[2].x)))));
+	int min_y = MAX(0, int(Math::floor(MIN(v[0].y, MIN(v[1].y, v[2].y)))));
+	int max_x = MIN(width - 1, int(Math::floor(MAX(v[0].x, MAX(v[1].x, v[2].x)))));
+	int max_y = MIN(height - 1, int(Math::floor(MAX(v[0].y, MAX(v[1].y, v[2].y)))));
+
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	// Edge functions, each one is the barycentric weight (times area) of the opposite vertex.
+	real_t e_dx[3], e_dy[3], e_row[3];
+	real_t inv_area = 1.0 / area;
+	real_t z_dx = 0;
+	real_t z_dy = 0;
+	real_t z_row = 0;
+
+	Vector2 start(min_x + 0.5, min_y + 0.5); // sample at pixel centers
+
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = v[(i + 1) % 3];
+		const Vector3 &b = v[(i + 2) % 3];
+		e_dx[i] = a.y - b.y;
+		e_dy[i] = b.x - a.x;
+		e_row[i] = (b.x - a.x) * (start.y - a.y) - (b.y - a.y) * (start.x - a.x);
+
+		z_dx += e_dx[i] * v[i].z * inv_area;
+		z_dy += e_dy[i] * v[i].z * inv_area;
+		z_row += e_row[i] * v[i].z * inv_area;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		if (!inner[i]) {
+			// Move silhouette edges in by half a pixel along each axis, the
+			// edge function at the center then tells if the whole pixel is in.
+			e_row[i] -= (Math::abs(e_dx[i]) + Math::abs(e_dy[i])) * 0.5;
+		}
+	}
+	// Depth is planar on screen, so the farthest point of a pixel is one of its corners.
+	z_row += (Math::abs(z_dx) + Math::abs(z_dy)) * 0.5;
+
+	float *depth = mips[0].depth.ptr();
+
+	for (int y = min_y; y <= max_y; y++) {
+		real_t e0 = e_row[0];
+		real_t e1 = e_row[1];
+		real_t e2 = e_row[2];
+		real_t z = z_row;
+		float *row = &depth[y * width];
+
+		for (int x = min_x; x <= max_x; x++) {
+			if (e0 >= 0 && e1 >= 0 && e2 >= 0 && z < row[x]) {
+				row[x] = z;
+			}
+			e0 += e_dx[0];
+			e1 += e_dx[1];
+			e2 += e_dx[2];
+			z += z_dx;
+		}
+
+		e_row[0] += e_dy[0];
+		e_row[1] += e_dy[1];
+		e_row[2] += e_dy[2];
+		z_row += z_dy;
+	}
+}
+
+void OcclusionBuffer::rasterize(const Transform &p_xform, const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count, const int *p_edge_neighbors) {
+	ERR_FAIL_COND(mips.size() == 0);
+
+	CameraMatrix mvp = view_projection * CameraMatrix(p_xform);
+
+	clip_vertices.resize(p_vertex_count);
+	screen_vertices.resize(p_vertex_count);
+	for (int i = 0; i < p_vertex_count; i++) {
+		clip_vertices[i] = mvp.xform4(Plane(p_vertices[i], 1.0));
+		if (!_is_behind_near(clip_vertices[i])) {
+			screen_vertices[i] = _to_screen(clip_vertices[i]);
+		}
+	}
+
+	for (int i = 0; i + 2 < p_index_count; i += 3) {
+		const int *triangle = &p_indices[i];
+
+		// Clipping is not worth it here, a skipped triangle only makes culling less aggressive.
+		if (_is_behind_near(clip_vertices[triangle[0]]) || _is_behind_near(clip_vertices[triangle[1]]) || _is_behind_near(clip_vertices[triangle[2]])) {
+			continue;
+		}
+
+		const Vector3 *vertices[3] = { &screen_vertices[triangle[0]], &screen_vertices[triangle[1]], &screen_vertices[triangle[2]] };
+		bool inner[3];
+		for (int j = 0; j < 3; j++) {
+			// The edge starting at vertex j is opposite to vertex j + 2.
+			inner[(j + 2) % 3] = p_edge_neighbors && _is_inner_edge(triangle, j, p_edge_neighbors[i + j]);
+		}
+
+		_rasterize_triangle(vertices, inner);
+	}
+}
+
+void OcclusionBuffer::finish() {
+	for (uint32_t i = 1; i < mips.size(); i++) {
+		const Mip &src = mips[i - 1];
+		Mip &dst = mips[i];
+
+		for (int y = 0; y < dst.height; y++) {
+			const float *row0 = &src.depth[MIN(y * 2, src.height - 1) * src.width];
+			const float *row1 = &src.depth[MIN(y * 2 + 1, src.height - 1) * src.width];
+			float *dst_row = &dst.depth[y * dst.width];
+
+			for (int x = 0; x < dst.width; x++) {
+				int x0 = MIN(x * 2, src.width - 1);
+				int x1 = MIN(x * 2 + 1, src.width - 1);
+				dst_row[x] = MAX(MAX(row0[x0], row0[x1]), MAX(row1[x0], row1[x1]));
+			}
+		}
+	}
+}
+
+bool OcclusionBuffer::is_occluded(const AABB &p_aabb) const {
+	if (mips.size() == 0) {
+		return false;
+	}
+
+	real_t min_x = 1e20, min_y = 1e20, min_z = 1e20;
+	real_t max_x = -1e20, max_y = -1e20;
+
+	for (int i = 0; i < 8; i++) {
+		Vector3 corner = p_aabb.position + p_aabb.size * Vector3(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+		Plane clip = _to_clip(corner);
+		if (_is_behind_near(clip)) {
+			return false; // crosses the near plane, consider it visible
+		}
+
+		real_t inv_w = 1.0 / clip.d;
+		real_t x = (clip.normal.x * inv_w * 0.5 + 0.5) * width;
+		real_t y = (0.5 - clip.normal.y * inv_w * 0.5) * height;
+
+		min_x = MIN(min_x, x);
+		max_x = MAX(max_x, x);
+		min_y = MIN(min_y, y);
+		max_y = MAX(max_y, y);
+		min_z = MIN(min_z, clip.normal.z * inv_w);
+	}
+
+	if (max_x < 0 || max_y < 0 || min_x >= width || min_y >= height) {
+		return false; // outside the buffer, leave it to frustum culling
+	}
+
+	int x0 = MAX(0, int(Math::floor(min_x)));
+	int y0 = MAX(0, int(Math::floor(min_y)));
+	int x1 = MIN(width - 1, int(Math::floor(max_x)));
+	int y1 = MIN(height - 1, int(Math::floor(max_y)));
+
+	// go down the mip chain until the box covers at most 4x4 texels
+	uint32_t level = 0;
+	while ((x1 - x0 > 3 || y1 - y0 > 3) && level + 1 < mips.size()) {
+		x0 >>= 1;
+		y0 >>= 1;
+		x1 >>= 1;
+		y1 >>= 1;
+		level++;
+	}
+
+	const Mip &mip = mips[level];
+
+	for (int y = y0; y <= y1; y++) {
+		const float *row = &mip.depth[y * mip.width];
+		for (int x = x0; x <= x1; x++) {
+			if (min_z <= row[x]) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
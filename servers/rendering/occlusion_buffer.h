@@ -0,0 +1,99 @@
+/*************************************************************************/
+/*  occlusion_buffer.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef OCCLUSION_BUFFER_H
+#define OCCLUSION_BUFFER_H
+
+#include "core/local_vector.h"
+#include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
+#include "core/math/transform.h"
+
+// Small depth buffer rasterized on the CPU from occluder meshes, used to
+// discard geometry hidden behind them before it reaches the render lists.
+// Depth is stored as NDC z (smaller is closer). After finish() a max-depth
+// mip chain is available, so each query only reads a handful of texels.
+//
+// Rasterization is conservative: along the silhouette of an occluder a texel
+// is only written when the occluder covers all of it, and the depth written is
+// the farthest one inside the texel. Edges shared by two triangles that lie on
+// opposite sides of it on screen are sampled normally, so meshes don't leak
+// through their inner edges.
+
+class OcclusionBuffer {
+public:
+	enum {
+		BUFFER_WIDTH = 256
+	};
+
+private:
+	struct Mip {
+		int width = 0;
+		int height = 0;
+		LocalVector<float> depth;
+	};
+
+	CameraMatrix view_projection;
+	int width = 0;
+	int height = 0;
+	LocalVector<Mip> mips; // mip 0 is the rasterized buffer, the rest store the max depth of each 2x2 block
+	LocalVector<Plane> clip_vertices; // per occluder vertex scratch (x, y, z, w)
+	LocalVector<Vector3> screen_vertices; // per occluder vertex scratch (pixel x, pixel y, NDC z)
+
+	void _rasterize_triangle(const Vector3 *p_vertices[3], const bool p_inner[3]);
+	bool _is_inner_edge(const int *p_triangle, int p_edge, int p_neighbor) const;
+
+	_FORCE_INLINE_ Plane _to_clip(const Vector3 &p_vertex) const {
+		return view_projection.xform4(Plane(p_vertex, 1.0));
+	}
+
+	_FORCE_INLINE_ static bool _is_behind_near(const Plane &p_clip) {
+		return p_clip.d <= CMP_EPSILON || p_clip.normal.z < -p_clip.d;
+	}
+
+	_FORCE_INLINE_ Vector3 _to_screen(const Plane &p_clip) const {
+		real_t inv_w = 1.0 / p_clip.d;
+		return Vector3((p_clip.normal.x * inv_w * 0.5 + 0.5) * width, (0.5 - p_clip.normal.y * inv_w * 0.5) * height, p_clip.normal.z * inv_w);
+	}
+
+public:
+	// For each edge of each triangle (the edge starting at that index), the
+	// vertex opposite to it in the triangle sharing the edge, or -1 for open or
+	// non-manifold edges. Pass the result to rasterize().
+	static void build_edge_neighbors(const int *p_indices, int p_index_count, LocalVector<int> &r_neighbors);
+
+	void begin(const CameraMatrix &p_projection, const Transform &p_cam_transform);
+	void rasterize(const Transform &p_xform, const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count, const int *p_edge_neighbors = nullptr);
+	void finish();
+
+	bool is_occluded(const AABB &p_aabb) const;
+};
+
+#endif // OCCLUSION_BUFFER_H
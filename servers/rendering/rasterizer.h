@@ -37,6 +37,8 @@
 #include "core/pair.h"
 #include "core/self_list.h"
 
+class ThreadWorkPool;
+
 class RasterizerScene {
 public:
 	/* SHADOW ATLAS API */
@@ -159,6 +161,7 @@ public:
 		bool redraw_if_visible : 4;
 
 		float depth; //used for sorting
+		float lod_threshold; //largest mesh LOD error allowed, in mesh space
 
 		SelfList<InstanceBase> dependency_item;
 
@@ -239,6 +242,7 @@ public:
 			lightmap_slice_index = 0;
 			lightmap = nullptr;
 			lightmap_cull_index = 0;
+			lod_threshold = 0;
 		}
 
 		virtual ~InstanceBase() {
@@ -337,6 +341,7 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) = 0;
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) = 0;
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) = 0;
+	virtual void texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata) = 0;
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) = 0;
 
@@ -1351,6 +1356,9 @@ public:
 
 	virtual bool is_low_end() const = 0;
 
+	// Worker threads the servers can share for their own jobs, nullptr runs them on the calling thread.
+	virtual ThreadWorkPool *get_thread_work_pool() { return nullptr; }
+
 	virtual ~Rasterizer() {}
 };
 
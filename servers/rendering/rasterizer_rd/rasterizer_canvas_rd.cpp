@@ -457,6 +457,25 @@ void RasterizerCanvasRD::free_polygon(PolygonID p_polygon) {
 	polygon_buffers.polygons.erase(p_polygon);
 }
 
+Size2i RasterizerCanvasRD::_get_texture_binding_size(TextureBindingID p_binding, uint32_t &flags) {
+	TextureBinding **texture_binding_ptr = bindings.texture_bindings.getptr(p_binding);
+	ERR_FAIL_COND_V(!texture_binding_ptr, Size2i());
+	TextureBinding *texture_binding = *texture_binding_ptr;
+
+	if (texture_binding->key.normalmap.is_valid()) {
+		flags |= FLAGS_DEFAULT_NORMAL_MAP_USED;
+	}
+	if (texture_binding->key.specular.is_valid()) {
+		flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
+	}
+
+	if (texture_binding->key.texture.is_valid()) {
+		return storage->texture_2d_get_size(texture_binding->key.texture);
+	} else {
+		return Size2i(1, 1);
+	}
+}
+
 Size2i RasterizerCanvasRD::_bind_texture_binding(TextureBindingID p_binding, RD::DrawListID p_draw_list, uint32_t &flags) {
 	TextureBinding **texture_binding_ptr = bindings.texture_bindings.getptr(p_binding);
 	ERR_FAIL_COND_V(!texture_binding_ptr, Size2i());
@@ -483,6 +502,24 @@ Size2i RasterizerCanvasRD::_bind_texture_binding(TextureBindingID p_binding, RD:
 	}
 }
 
+void RasterizerCanvasRD::_request_texture_streaming(TextureBindingID p_binding, const Transform2D &p_xform, const Rect2 &p_rect, const Rect2 &p_source) {
+	TextureBinding **texture_binding_ptr = bindings.texture_bindings.getptr(p_binding);
+	if (!texture_binding_ptr || (*texture_binding_ptr)->key.texture.is_null()) {
+		return;
+	}
+	RID texture = (*texture_binding_ptr)->key.texture;
+
+	//size the whole texture takes on screen, a region only covers part of it
+	Vector2 size = p_rect.size.abs();
+	if (p_source.size.x != 0 && p_source.size.y != 0) {
+		Size2i tex_size = storage->texture_2d_get_size(texture);
+		size *= Vector2(tex_size) / p_source.size.abs();
+	}
+
+	float screen_size = MAX(p_xform.basis_xform(Vector2(size.x, 0)).length(), p_xform.basis_xform(Vector2(0, size.y)).length());
+	storage->texture_request_streaming(texture, MAX(uint32_t(MIN(screen_size, 16384.0f)), 1u));
+}
+
 ////////////////////
 void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants) {
 	//create an empty push constant
@@ -503,8 +540,8 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -525,6 +562,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 	Light *light_cache[DEFAULT_MAX_LIGHTS_PER_ITEM];
 	uint16_t light_count = 0;
 	PipelineLightMode light_mode;
+	RID item_uniform_set;
 
 	{
 		Light *light = p_lights;
@@ -558,7 +596,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 	}
 
 	{
-		RID &canvas_item_state = light_count ? state_data->state_uniform_set_with_light : state_data->state_uniform_set;
+		RID &canvas_item_state = light_count ? state_data->state_uniform_set_with_light : state.item_uniform_set;
 
 		bool invalid_uniform = canvas_item_state.is_valid() && !RD::get_singleton()->uniform_set_is_valid(canvas_item_state);
 
@@ -566,7 +604,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 			//re create canvas state
 			Vector<RD::Uniform> uniforms;
 
-			if (state_data->state_uniform_set_with_light.is_valid() && !invalid_uniform) {
+			if (canvas_item_state.is_valid() && !invalid_uniform) {
 				RD::get_singleton()->free(canvas_item_state);
 			}
 
@@ -608,6 +646,14 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 				uniforms.push_back(u);
 			}
 
+			{
+				RD::Uniform u;
+				u.type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+				u.binding = 8;
+				u.ids.push_back(state.batch_buffer);
+				uniforms.push_back(u);
+			}
+
 			//validate and update lighs if they are being used
 
 			if (light_count > 0) {
@@ -675,6 +721,11 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 			}
 		}
 
+		if (batch.item_uniform_set != canvas_item_state) {
+			_flush_batch(p_draw_list);
+		}
+
+		item_uniform_set = canvas_item_state;
 		RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, canvas_item_state, 2);
 	}
 
@@ -684,108 +735,66 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 	bool reclip = false;
 
+	//streamed textures are requested at the size they are drawn at on the render target
+	bool stream_textures = storage->texture_streaming_is_active();
+	Transform2D draw_transform = p_item->final_transform;
+
 	const Item::Command *c = p_item->commands;
 	while (c) {
 		push_constant.flags = base_flags; //reset on each command for sanity
 		push_constant.specular_shininess = 0xFFFFFFFF;
 
+		if (c->type != Item::Command::TYPE_RECT && c->type != Item::Command::TYPE_TRANSFORM) {
+			//anything else is drawn on its own, so pending rects go first
+			_flush_batch(p_draw_list);
+		}
+
 		switch (c->type) {
 			case Item::Command::TYPE_RECT: {
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
 
-				//bind pipeline
-				{
-					RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
-					RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
-				}
-
-				//bind textures
+				//rect data was already uploaded in _update_batch_instances(), only draw state is handled here
 
-				Size2 texpixel_size;
-				{
-					texpixel_size = _bind_texture_binding(rect->texture_binding.binding_id, p_draw_list, push_constant.flags);
-					texpixel_size.x = 1.0 / texpixel_size.x;
-					texpixel_size.y = 1.0 / texpixel_size.y;
+				if (stream_textures) {
+					_request_texture_streaming(rect->texture_binding.binding_id, draw_transform, rect->rect, (rect->flags & CANVAS_RECT_REGION) ? rect->source : Rect2());
 				}
 
-				if (rect->specular_shininess.a < 0.999) {
-					push_constant.flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
-				}
-
-				_update_specular_shininess(rect->specular_shininess, &push_constant.specular_shininess);
-
-				Rect2 src_rect;
-				Rect2 dst_rect;
-
-				if (texpixel_size != Vector2()) {
-					push_constant.color_texture_pixel_size[0] = texpixel_size.x;
-					push_constant.color_texture_pixel_size[1] = texpixel_size.y;
-
-					src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
-
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
-
-					if (rect->flags & CANVAS_RECT_FLIP_H) {
-						src_rect.size.x *= -1;
-					}
-
-					if (rect->flags & CANVAS_RECT_FLIP_V) {
-						src_rect.size.y *= -1;
-					}
+				RID pipeline = pipeline_variants->variants[light_mode][PIPELINE_VARIANT_QUAD].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
 
-					if (rect->flags & CANVAS_RECT_TRANSPOSE) {
-						dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
-					}
-
-					if (rect->flags & CANVAS_RECT_CLIP_UV) {
-						push_constant.flags |= FLAGS_CLIP_RECT_UV;
-					}
-
-				} else {
-					dst_rect = Rect2(rect->rect.position, rect->rect.size);
-
-					if (dst_rect.size.width < 0) {
-						dst_rect.position.x += dst_rect.size.width;
-						dst_rect.size.width *= -1;
-					}
-					if (dst_rect.size.height < 0) {
-						dst_rect.position.y += dst_rect.size.height;
-						dst_rect.size.height *= -1;
-					}
-
-					src_rect = Rect2(0, 0, 1, 1);
+				Size2 texpixel_size = _get_texture_binding_size(rect->texture_binding.binding_id, push_constant.flags);
+				texpixel_size.x = 1.0 / texpixel_size.x;
+				texpixel_size.y = 1.0 / texpixel_size.y;
+				if (texpixel_size == Vector2()) {
 					texpixel_size = Vector2(1, 1);
 				}
 
-				push_constant.modulation[0] = rect->modulate.r * base_color.r;
-				push_constant.modulation[1] = rect->modulate.g * base_color.g;
-				push_constant.modulation[2] = rect->modulate.b * base_color.b;
-				push_constant.modulation[3] = rect->modulate.a * base_color.a;
+				push_constant.color_texture_pixel_size[0] = texpixel_size.x;
+				push_constant.color_texture_pixel_size[1] = texpixel_size.y;
 
-				push_constant.src_rect[0] = src_rect.position.x;
-				push_constant.src_rect[1] = src_rect.position.y;
-				push_constant.src_rect[2] = src_rect.size.width;
-				push_constant.src_rect[3] = src_rect.size.height;
+				bool can_batch = batch.count > 0 && batch.pipeline == pipeline && batch.texture_binding == rect->texture_binding.binding_id && batch.push_constant.flags == push_constant.flags;
+				for (int j = 0; j < 4 && can_batch; j++) {
+					can_batch = batch.push_constant.lights[j] == push_constant.lights[j];
+				}
+				for (int j = 0; j < 2 && can_batch; j++) {
+					can_batch = batch.push_constant.color_texture_pixel_size[j] == push_constant.color_texture_pixel_size[j];
+				}
 
-				push_constant.dst_rect[0] = dst_rect.position.x;
-				push_constant.dst_rect[1] = dst_rect.position.y;
-				push_constant.dst_rect[2] = dst_rect.size.width;
-				push_constant.dst_rect[3] = dst_rect.size.height;
+				if (!can_batch) {
+					_flush_batch(p_draw_list);
 
-				push_constant.color_texture_pixel_size[0] = texpixel_size.x;
-				push_constant.color_texture_pixel_size[1] = texpixel_size.y;
+					RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+					uint32_t bind_flags = 0;
+					_bind_texture_binding(rect->texture_binding.binding_id, p_draw_list, bind_flags);
+
+					batch.pipeline = pipeline;
+					batch.item_uniform_set = item_uniform_set;
+					batch.texture_binding = rect->texture_binding.binding_id;
+					batch.push_constant = push_constant;
+					batch.push_constant.batch_offset = batch.instance_index;
+				}
 
-				RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
-				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
-				RD::get_singleton()->draw_list_draw(p_draw_list, true);
+				batch.count++;
+				batch.instance_index++;
 
 			} break;
 
@@ -800,6 +809,10 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 				//bind textures
 
+				if (stream_textures) {
+					_request_texture_streaming(np->texture_binding.binding_id, draw_transform, np->rect, np->source);
+				}
+
 				Size2 texpixel_size;
 				{
 					texpixel_size = _bind_texture_binding(np->texture_binding.binding_id, p_draw_list, push_constant.flags);
@@ -884,6 +897,11 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 				//bind textures
 
+				if (stream_textures) {
+					//assume the UVs span the item once
+					_request_texture_streaming(polygon->texture_binding.binding_id, Transform2D(), p_item->global_rect_cache);
+				}
+
 				Size2 texpixel_size;
 				{
 					texpixel_size = _bind_texture_binding(polygon->texture_binding.binding_id, p_draw_list, push_constant.flags);
@@ -932,6 +950,10 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 
 				//bind textures
 
+				if (stream_textures) {
+					_request_texture_streaming(primitive->texture_binding.binding_id, Transform2D(), p_item->global_rect_cache);
+				}
+
 				{
 					_bind_texture_binding(primitive->texture_binding.binding_id, p_draw_list, push_constant.flags);
 				}
@@ -1267,6 +1289,7 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 			case Item::Command::TYPE_TRANSFORM: {
 				const Item::CommandTransform *transform = static_cast<const Item::CommandTransform *>(c);
 				_update_transform_2d_to_mat2x3(base_transform * transform->xform, push_constant.world);
+				draw_transform = p_item->final_transform * transform->xform;
 
 			} break;
 			case Item::Command::TYPE_CLIP_IGNORE: {
@@ -1295,6 +1318,133 @@ void RasterizerCanvasRD::_render_item(RD::DrawListID p_draw_list, const Item *p_
 	}
 }
 
+void RasterizerCanvasRD::_update_batch_instances(int p_item_count, const Transform2D &p_canvas_transform_inverse) {
+	//rects are drawn instanced, so their data must be in the batch buffer before the draw list begins.
+	//they are stored in the same order _render_item() will consume them.
+
+	state.batch_instances.clear();
+
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+
+		Transform2D base_transform = p_canvas_transform_inverse * ci->final_transform;
+		Transform2D world = base_transform;
+		Color base_color = ci->final_modulate;
+
+		const Item::Command *c = ci->commands;
+		while (c) {
+			switch (c->type) {
+				case Item::Command::TYPE_RECT: {
+					const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+
+					State::BatchInstance instance;
+					_update_transform_2d_to_mat2x3(world, instance.world);
+					instance.flags = 0;
+					instance.specular_shininess = 0xFFFFFFFF;
+
+					uint32_t texture_flags = 0;
+					Size2 texpixel_size = _get_texture_binding_size(rect->texture_binding.binding_id, texture_flags);
+					texpixel_size.x = 1.0 / texpixel_size.x;
+					texpixel_size.y = 1.0 / texpixel_size.y;
+
+					if (rect->specular_shininess.a < 0.999) {
+						instance.flags |= FLAGS_DEFAULT_SPECULAR_MAP_USED;
+					}
+
+					_update_specular_shininess(rect->specular_shininess, &instance.specular_shininess);
+
+					Rect2 src_rect;
+					Rect2 dst_rect(rect->rect.position, rect->rect.size);
+
+					if (dst_rect.size.width < 0) {
+						dst_rect.position.x += dst_rect.size.width;
+						dst_rect.size.width *= -1;
+					}
+					if (dst_rect.size.height < 0) {
+						dst_rect.position.y += dst_rect.size.height;
+						dst_rect.size.height *= -1;
+					}
+
+					if (texpixel_size != Vector2()) {
+						src_rect = (rect->flags & CANVAS_RECT_REGION) ? Rect2(rect->source.position * texpixel_size, rect->source.size * texpixel_size) : Rect2(0, 0, 1, 1);
+
+						if (rect->flags & CANVAS_RECT_FLIP_H) {
+							src_rect.size.x *= -1;
+						}
+
+						if (rect->flags & CANVAS_RECT_FLIP_V) {
+							src_rect.size.y *= -1;
+						}
+
+						if (rect->flags & CANVAS_RECT_TRANSPOSE) {
+							dst_rect.size.x *= -1; // Encoding in the dst_rect.z uniform
+						}
+
+						if (rect->flags & CANVAS_RECT_CLIP_UV) {
+							instance.flags |= FLAGS_CLIP_RECT_UV;
+						}
+
+					} else {
+						src_rect = Rect2(0, 0, 1, 1);
+					}
+
+					instance.modulation[0] = rect->modulate.r * base_color.r;
+					instance.modulation[1] = rect->modulate.g * base_color.g;
+					instance.modulation[2] = rect->modulate.b * base_color.b;
+					instance.modulation[3] = rect->modulate.a * base_color.a;
+
+					instance.src_rect[0] = src_rect.position.x;
+					instance.src_rect[1] = src_rect.position.y;
+					instance.src_rect[2] = src_rect.size.width;
+					instance.src_rect[3] = src_rect.size.height;
+
+					instance.dst_rect[0] = dst_rect.position.x;
+					instance.dst_rect[1] = dst_rect.position.y;
+					instance.dst_rect[2] = dst_rect.size.width;
+					instance.dst_rect[3] = dst_rect.size.height;
+
+					state.batch_instances.push_back(instance);
+
+				} break;
+				case Item::Command::TYPE_TRANSFORM: {
+					const Item::CommandTransform *transform = static_cast<const Item::CommandTransform *>(c);
+					world = base_transform * transform->xform;
+
+				} break;
+				default: {
+				}
+			}
+
+			c = c->next;
+		}
+	}
+
+	if (state.batch_instances.size() == 0) {
+		return;
+	}
+
+	if (state.batch_instances.size() > state.batch_buffer_size) {
+		//grow, uniform sets using the old buffer are invalidated and get recreated on demand
+		RD::get_singleton()->free(state.batch_buffer);
+		state.batch_buffer_size = next_power_of_2(state.batch_instances.size());
+		state.batch_buffer = RD::get_singleton()->storage_buffer_create(sizeof(State::BatchInstance) * state.batch_buffer_size);
+	}
+
+	RD::get_singleton()->buffer_update(state.batch_buffer, 0, sizeof(State::BatchInstance) * state.batch_instances.size(), state.batch_instances.ptr(), true);
+}
+
+void RasterizerCanvasRD::_flush_batch(RD::DrawListID p_draw_list) {
+	if (batch.count == 0) {
+		return;
+	}
+
+	RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &batch.push_constant, sizeof(PushConstant));
+	RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+	RD::get_singleton()->draw_list_draw(p_draw_list, true, batch.count);
+
+	batch.count = 0;
+}
+
 void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, RID p_screen_uniform_set) {
 	Item *current_clip = nullptr;
 
@@ -1315,6 +1465,11 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	_update_batch_instances(p_item_count, canvas_transform_inverse);
+	batch.instance_index = 0;
+	batch.count = 0;
+	batch.item_uniform_set = RID();
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	if (p_screen_uniform_set.is_valid()) {
@@ -1328,6 +1483,7 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 		Item *ci = items[i];
 
 		if (current_clip != ci->final_clip_owner) {
+			_flush_batch(draw_list);
 			current_clip = ci->final_clip_owner;
 
 			//setup clip
@@ -1340,6 +1496,7 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 		}
 
 		if (ci->material != prev_material) {
+			_flush_batch(draw_list);
 			MaterialData *material_data = nullptr;
 			if (ci->material.is_valid()) {
 				material_data = (MaterialData *)storage->material_get_data(ci->material, RasterizerStorageRD::SHADER_TYPE_2D);
@@ -1364,6 +1521,7 @@ void RasterizerCanvasRD::_render_items(RID p_to_render_target, int p_item_count,
 		prev_material = ci->material;
 	}
 
+	_flush_batch(draw_list);
 	RD::get_singleton()->draw_list_end();
 }
 
@@ -2208,14 +2366,14 @@ RasterizerCanvasRD::RasterizerCanvasRD(RasterizerStorageRD *p_storage) {
 		state.light_uniforms = memnew_arr(LightUniform, state.max_lights_per_render);
 		Vector<String> variants;
 		//non light variants
-		variants.push_back(""); //none by default is first variant
+		variants.push_back("#define USE_BATCHING\n"); //rects by default is first variant, drawn instanced in batches
 		variants.push_back("#define USE_NINEPATCH\n"); //ninepatch is the second variant
 		variants.push_back("#define USE_PRIMITIVE\n"); //primitive is the third
 		variants.push_back("#define USE_PRIMITIVE\n#define USE_POINT_SIZE\n"); //points need point size
 		variants.push_back("#define USE_ATTRIBUTES\n"); // attributes for vertex arrays
 		variants.push_back("#define USE_ATTRIBUTES\n#define USE_POINT_SIZE\n"); //attributes with point size
 		//light variants
-		variants.push_back("#define USE_LIGHTING\n"); //none by default is first variant
+		variants.push_back("#define USE_LIGHTING\n#define USE_BATCHING\n"); //rects by default is first variant, drawn instanced in batches
 		variants.push_back("#define USE_LIGHTING\n#define USE_NINEPATCH\n"); //ninepatch is the second variant
 		variants.push_back("#define USE_LIGHTING\n#define USE_PRIMITIVE\n"); //primitive is the third
 		variants.push_back("#define USE_LIGHTING\n#define USE_PRIMITIVE\n#define USE_POINT_SIZE\n"); //points need point size
@@ -2392,6 +2550,12 @@ RasterizerCanvasRD::RasterizerCanvasRD(RasterizerStorageRD *p_storage) {
 
 		{ //state allocate
 			state.canvas_state_buffer = RD::get_singleton()->uniform_buffer_create(sizeof(State::Buffer));
+
+			state.batch_buffer_size = 256;
+			state.batch_buffer = RD::get_singleton()->storage_buffer_create(sizeof(State::BatchInstance) * state.batch_buffer_size);
+			batch.count = 0;
+			batch.instance_index = 0;
+			batch.texture_binding = 0;
 			state.lights_uniform_buffer = RD::get_singleton()->uniform_buffer_create(sizeof(LightUniform) * state.max_lights_per_render);
 
 			RD::SamplerState shadow_sampler_state;
@@ -2479,6 +2643,7 @@ RasterizerCanvasRD::~RasterizerCanvasRD() {
 
 		memdelete_arr(state.light_uniforms);
 		RD::get_singleton()->free(state.lights_uniform_buffer);
+		RD::get_singleton()->free(state.batch_buffer); //also frees item_uniform_set, which depends on it
 		RD::get_singleton()->free(shader.default_skeleton_uniform_buffer);
 		RD::get_singleton()->free(shader.default_skeleton_texture_buffer);
 	}
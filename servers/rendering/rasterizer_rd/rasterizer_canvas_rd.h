@@ -31,6 +31,7 @@
 #ifndef RASTERIZER_CANVAS_RD_H
 #define RASTERIZER_CANVAS_RD_H
 
+#include "core/local_vector.h"
 #include "servers/rendering/rasterizer.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_storage_rd.h"
 #include "servers/rendering/rasterizer_rd/render_pipeline_vertex_format_cache_rd.h"
@@ -375,7 +376,6 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		LightCache light_cache[DEFAULT_MAX_LIGHTS_PER_ITEM];
 		uint32_t light_cache_count;
 		RID state_uniform_set_with_light;
-		RID state_uniform_set;
 		ItemStateData() {
 			for (int i = 0; i < DEFAULT_MAX_LIGHTS_PER_ITEM; i++) {
 				light_cache[i].light_version = 0;
@@ -388,9 +388,6 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 			if (state_uniform_set_with_light.is_valid() && RD::get_singleton()->uniform_set_is_valid(state_uniform_set_with_light)) {
 				RD::get_singleton()->free(state_uniform_set_with_light);
 			}
-			if (state_uniform_set.is_valid() && RD::get_singleton()->uniform_set_is_valid(state_uniform_set)) {
-				RD::get_singleton()->free(state_uniform_set);
-			}
 		}
 	};
 
@@ -409,12 +406,27 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 			//uint32_t pad[3];
 		};
 
+		//per rect data, rects are drawn instanced in batches
+		struct BatchInstance {
+			float world[6];
+			uint32_t flags;
+			uint32_t specular_shininess;
+			float modulation[4];
+			float dst_rect[4];
+			float src_rect[4];
+		};
+
 		LightUniform *light_uniforms;
 
 		RID lights_uniform_buffer;
 		RID canvas_state_buffer;
 		RID shadow_sampler;
 
+		LocalVector<BatchInstance> batch_instances;
+		RID batch_buffer;
+		uint32_t batch_buffer_size;
+		RID item_uniform_set; //shared by all items without lights, so they can batch together
+
 		uint32_t max_lights_per_render;
 		uint32_t max_lights_per_item;
 
@@ -432,7 +444,8 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 				float ninepatch_margins[4];
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t batch_offset;
+				uint32_t pad;
 			};
 			//primitive
 			struct {
@@ -445,6 +458,16 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 		uint32_t lights[4];
 	};
 
+	//rects waiting to be drawn together, consecutive in state.batch_instances
+	struct Batch {
+		RID pipeline;
+		RID item_uniform_set;
+		TextureBindingID texture_binding;
+		PushConstant push_constant;
+		uint32_t instance_index;
+		uint32_t count;
+	} batch;
+
 	struct SkeletonUniform {
 		float skeleton_transform[16];
 		float skeleton_inverse[16];
@@ -452,7 +475,11 @@ class RasterizerCanvasRD : public RasterizerCanvas {
 
 	Item *items[MAX_RENDER_ITEMS];
 
+	Size2i _get_texture_binding_size(TextureBindingID p_binding, uint32_t &flags);
 	Size2i _bind_texture_binding(TextureBindingID p_binding, RenderingDevice::DrawListID p_draw_list, uint32_t &flags);
+	void _request_texture_streaming(TextureBindingID p_binding, const Transform2D &p_xform, const Rect2 &p_rect, const Rect2 &p_source = Rect2());
+	void _update_batch_instances(int p_item_count, const Transform2D &p_canvas_transform_inverse);
+	void _flush_batch(RenderingDevice::DrawListID p_draw_list);
 	void _render_item(RenderingDevice::DrawListID p_draw_list, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, RID p_screen_uniform_set);
 
@@ -177,6 +177,10 @@ RasterizerRD::RasterizerRD() {
 	thread_work_pool.init();
 	time = 0;
 
+	if (GLOBAL_GET("rendering/vulkan/shader_cache/enabled")) {
+		ShaderRD::set_shader_cache_dir(OS::get_singleton()->get_user_data_dir().plus_file("shader_cache"));
+	}
+
 	storage = memnew(RasterizerStorageRD);
 	canvas = memnew(RasterizerCanvasRD(storage));
 	scene = memnew(RasterizerSceneHighEndRD(storage));
@@ -89,6 +89,8 @@ public:
 
 	virtual bool is_low_end() const { return false; }
 
+	virtual ThreadWorkPool *get_thread_work_pool() { return &thread_work_pool; }
+
 	static ThreadWorkPool thread_work_pool;
 
 	static RasterizerRD *singleton;
@@ -29,7 +29,9 @@
 /*************************************************************************/
 
 #include "rasterizer_scene_high_end_rd.h"
+#include "core/engine.h"
 #include "core/project_settings.h"
+#include "servers/rendering/rasterizer_rd/rasterizer_rd.h"
 #include "servers/rendering/rendering_device.h"
 #include "servers/rendering/rendering_server_raster.h"
 
@@ -102,6 +104,7 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	code = p_code;
 	valid = false;
+	compiling = false;
 	ubo_size = 0;
 	uniforms.clear();
 	uses_screen_texture = false;
@@ -112,9 +115,9 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	ShaderCompilerRD::GeneratedCode gen_code;
 
-	int blend_mode = BLEND_MODE_MIX;
+	blend_mode = BLEND_MODE_MIX;
 	int depth_testi = DEPTH_TEST_ENABLED;
-	int cull = CULL_BACK;
+	cull_mode = CULL_BACK;
 
 	uses_point_size = false;
 	uses_alpha = false;
@@ -123,7 +126,7 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 	uses_discard = false;
 	uses_roughness = false;
 	uses_normal = false;
-	bool wireframe = false;
+	wireframe = false;
 
 	unshaded = false;
 	uses_vertex = false;
@@ -151,9 +154,9 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 
 	actions.render_mode_values["depth_test_disabled"] = Pair<int *, int>(&depth_testi, DEPTH_TEST_DISABLED);
 
-	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&cull, CULL_DISABLED);
-	actions.render_mode_values["cull_front"] = Pair<int *, int>(&cull, CULL_FRONT);
-	actions.render_mode_values["cull_back"] = Pair<int *, int>(&cull, CULL_BACK);
+	actions.render_mode_values["cull_disabled"] = Pair<int *, int>(&cull_mode, CULL_DISABLED);
+	actions.render_mode_values["cull_front"] = Pair<int *, int>(&cull_mode, CULL_FRONT);
+	actions.render_mode_values["cull_back"] = Pair<int *, int>(&cull_mode, CULL_BACK);
 
 	actions.render_mode_flags["unshaded"] = &unshaded;
 	actions.render_mode_flags["wireframe"] = &wireframe;
@@ -209,12 +212,33 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 	print_line("\n**light_code:\n" + gen_code.light);
 #endif
 	scene_singleton->shader.scene_shader.version_set_code(version, gen_code.uniforms, gen_code.vertex_global, gen_code.vertex, gen_code.fragment_global, gen_code.light, gen_code.fragment, gen_code.defines);
-	ERR_FAIL_COND(!scene_singleton->shader.scene_shader.version_is_valid(version));
 
 	ubo_size = gen_code.uniform_total_size;
 	ubo_offsets = gen_code.uniform_offsets;
 	texture_uniforms = gen_code.texture_uniforms;
 
+	if (scene_singleton->shader.async_compile) {
+		//don't stall the frame, pipelines are set up once is_compiling() finds the variants built
+		for (int i = 0; i < CULL_VARIANT_MAX; i++) {
+			for (int j = 0; j < RS::PRIMITIVE_MAX; j++) {
+				for (int k = 0; k < SHADER_VERSION_MAX; k++) {
+					pipelines[i][j][k].clear();
+				}
+			}
+		}
+		scene_singleton->shader.scene_shader.version_compile_async(version);
+		compiling = true;
+		return;
+	}
+
+	ERR_FAIL_COND(!scene_singleton->shader.scene_shader.version_is_valid(version));
+
+	_setup_pipelines();
+}
+
+void RasterizerSceneHighEndRD::ShaderData::_setup_pipelines() {
+	RasterizerSceneHighEndRD *scene_singleton = (RasterizerSceneHighEndRD *)RasterizerSceneHighEndRD::singleton;
+
 	//blend modes
 
 	RD::PipelineColorBlendState::Attachment blend_attachment;
@@ -288,7 +312,7 @@ void RasterizerSceneHighEndRD::ShaderData::set_code(const String &p_code) {
 			{ RD::POLYGON_CULL_DISABLED, RD::POLYGON_CULL_DISABLED, RD::POLYGON_CULL_DISABLED }
 		};
 
-		RD::PolygonCullMode cull_mode_rd = cull_mode_rd_table[i][cull];
+		RD::PolygonCullMode cull_mode_rd = cull_mode_rd_table[i][cull_mode];
 
 		for (int j = 0; j < RS::PRIMITIVE_MAX; j++) {
 			RD::RenderPrimitive primitive_rd_table[RS::PRIMITIVE_MAX] = {
@@ -424,6 +448,22 @@ Variant RasterizerSceneHighEndRD::ShaderData::get_default_parameter(const String
 	return Variant();
 }
 
+bool RasterizerSceneHighEndRD::ShaderData::is_compiling() {
+	if (!compiling) {
+		return false;
+	}
+
+	RasterizerSceneHighEndRD *scene_singleton = (RasterizerSceneHighEndRD *)RasterizerSceneHighEndRD::singleton;
+	if (scene_singleton->shader.scene_shader.version_is_compiling(version)) {
+		return true;
+	}
+
+	compiling = false;
+	ERR_FAIL_COND_V(!scene_singleton->shader.scene_shader.version_is_valid(version), false);
+	_setup_pipelines();
+	return false;
+}
+
 RasterizerSceneHighEndRD::ShaderData::ShaderData() {
 	valid = false;
 	uses_screen_texture = false;
@@ -528,6 +568,10 @@ void RasterizerSceneHighEndRD::MaterialData::update_parameters(const Map<StringN
 		}
 	}
 
+	if (!shader_data->valid) {
+		return; //still compiling, the set is created when the shader is ready
+	}
+
 	uniform_set = RD::get_singleton()->uniform_set_create(uniforms, scene_singleton->shader.scene_shader.version_get_shader(shader_data->version, 0), MATERIAL_UNIFORM_SET);
 }
 
@@ -929,39 +973,15 @@ void RasterizerSceneHighEndRD::_fill_instances(RenderList::Element **p_elements,
 
 /// RENDERING ///
 
-void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, bool p_force_wireframe, const Vector2 &p_uv_offset) {
-	RD::DrawListID draw_list = p_draw_list;
-	RD::FramebufferFormatID framebuffer_format = p_framebuffer_Format;
-
-	//global scope bindings
-	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, render_base_uniform_set, SCENE_UNIFORM_SET);
-	if (p_radiance_uniform_set.is_valid()) {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_radiance_uniform_set, RADIANCE_UNIFORM_SET);
-	} else {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_radiance_uniform_set, RADIANCE_UNIFORM_SET);
-	}
-	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, view_dependant_uniform_set, VIEW_DEPENDANT_UNIFORM_SET);
-	if (p_render_buffers_uniform_set.is_valid()) {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
-	} else {
-		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
-	}
-	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_vec4_xform_uniform_set, TRANSFORMS_UNIFORM_SET);
-
-	MaterialData *prev_material = nullptr;
+void RasterizerSceneHighEndRD::_render_list_resolve(RenderingDevice::FramebufferFormatID p_framebuffer_format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_force_wireframe) {
+	RD::FramebufferFormatID framebuffer_format = p_framebuffer_format;
 
-	RID prev_vertex_array_rd;
-	RID prev_index_array_rd;
-	RID prev_pipeline_rd;
-	RID prev_xforms_uniform_set;
-
-	PushConstant push_constant;
-	zeromem(&push_constant, sizeof(PushConstant));
-	push_constant.bake_uv2_offset[0] = p_uv_offset.x;
-	push_constant.bake_uv2_offset[1] = p_uv_offset.y;
+	draw_elements.resize(p_element_count);
 
 	for (int i = 0; i < p_element_count; i++) {
 		const RenderList::Element *e = p_elements[i];
+		DrawElement &de = draw_elements[i];
+		de.pipeline = RID(); //invalid pipeline means the element is skipped
 
 		MaterialData *material = e->material;
 		ShaderData *shader = material->shader_data;
@@ -1059,12 +1079,14 @@ void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_l
 
 		switch (e->instance->base_type) {
 			case RS::INSTANCE_MESH: {
-				storage->mesh_surface_get_arrays_and_format(e->instance->base, e->surface_index, pipeline->get_vertex_input_mask(), vertex_array_rd, index_array_rd, vertex_format);
+				storage->mesh_surface_get_arrays_and_format(e->instance->base, e->surface_index, pipeline->get_vertex_input_mask(), e->instance->lod_threshold, vertex_array_rd, index_array_rd, vertex_format);
+				de.instances = 1;
 			} break;
 			case RS::INSTANCE_MULTIMESH: {
 				RID mesh = storage->multimesh_get_mesh(e->instance->base);
 				ERR_CONTINUE(!mesh.is_valid()); //should be a bug
-				storage->mesh_surface_get_arrays_and_format(mesh, e->surface_index, pipeline->get_vertex_input_mask(), vertex_array_rd, index_array_rd, vertex_format);
+				storage->mesh_surface_get_arrays_and_format(mesh, e->surface_index, pipeline->get_vertex_input_mask(), e->instance->lod_threshold, vertex_array_rd, index_array_rd, vertex_format);
+				de.instances = storage->multimesh_get_instances_to_draw(e->instance->base);
 			} break;
 			case RS::INSTANCE_IMMEDIATE: {
 				ERR_CONTINUE(true); //should be a bug
@@ -1077,61 +1099,126 @@ void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_l
 			}
 		}
 
-		if (prev_vertex_array_rd != vertex_array_rd) {
-			RD::get_singleton()->draw_list_bind_vertex_array(draw_list, vertex_array_rd);
-			prev_vertex_array_rd = vertex_array_rd;
+		de.pipeline = pipeline->get_render_pipeline(vertex_format, framebuffer_format, p_force_wireframe);
+		de.vertex_array = vertex_array_rd;
+		de.index_array = index_array_rd;
+		de.xforms_uniform_set = xforms_uniform_set;
+		de.material_uniform_set = material->uniform_set;
+	}
+}
+
+void RasterizerSceneHighEndRD::_render_list_record(RenderingDevice::DrawListID p_draw_list, int p_from, int p_to, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, const Vector2 &p_uv_offset) {
+	RD::DrawListID draw_list = p_draw_list;
+
+	//global scope bindings
+	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, render_base_uniform_set, SCENE_UNIFORM_SET);
+	if (p_radiance_uniform_set.is_valid()) {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_radiance_uniform_set, RADIANCE_UNIFORM_SET);
+	} else {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_radiance_uniform_set, RADIANCE_UNIFORM_SET);
+	}
+	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, view_dependant_uniform_set, VIEW_DEPENDANT_UNIFORM_SET);
+	if (p_render_buffers_uniform_set.is_valid()) {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, p_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
+	} else {
+		RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_render_buffers_uniform_set, RENDER_BUFFERS_UNIFORM_SET);
+	}
+	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, default_vec4_xform_uniform_set, TRANSFORMS_UNIFORM_SET);
+
+	RID prev_material_uniform_set;
+	RID prev_vertex_array_rd;
+	RID prev_index_array_rd;
+	RID prev_pipeline_rd;
+	RID prev_xforms_uniform_set;
+
+	PushConstant push_constant;
+	zeromem(&push_constant, sizeof(PushConstant));
+	push_constant.bake_uv2_offset[0] = p_uv_offset.x;
+	push_constant.bake_uv2_offset[1] = p_uv_offset.y;
+
+	for (int i = p_from; i < p_to; i++) {
+		const DrawElement &de = draw_elements[i];
+
+		if (!de.pipeline.is_valid()) {
+			continue;
 		}
 
-		if (prev_index_array_rd != index_array_rd) {
-			if (index_array_rd.is_valid()) {
-				RD::get_singleton()->draw_list_bind_index_array(draw_list, index_array_rd);
-			}
-			prev_index_array_rd = index_array_rd;
+		if (prev_vertex_array_rd != de.vertex_array) {
+			RD::get_singleton()->draw_list_bind_vertex_array(draw_list, de.vertex_array);
+			prev_vertex_array_rd = de.vertex_array;
 		}
 
-		RID pipeline_rd = pipeline->get_render_pipeline(vertex_format, framebuffer_format, p_force_wireframe);
+		if (prev_index_array_rd != de.index_array) {
+			if (de.index_array.is_valid()) {
+				RD::get_singleton()->draw_list_bind_index_array(draw_list, de.index_array);
+			}
+			prev_index_array_rd = de.index_array;
+		}
 
-		if (pipeline_rd != prev_pipeline_rd) {
+		if (de.pipeline != prev_pipeline_rd) {
 			// checking with prev shader does not make so much sense, as
 			// the pipeline may still be different.
-			RD::get_singleton()->draw_list_bind_render_pipeline(draw_list, pipeline_rd);
-			prev_pipeline_rd = pipeline_rd;
+			RD::get_singleton()->draw_list_bind_render_pipeline(draw_list, de.pipeline);
+			prev_pipeline_rd = de.pipeline;
 		}
 
-		if (xforms_uniform_set.is_valid() && prev_xforms_uniform_set != xforms_uniform_set) {
-			RD::get_singleton()->draw_list_bind_uniform_set(draw_list, xforms_uniform_set, TRANSFORMS_UNIFORM_SET);
-			prev_xforms_uniform_set = xforms_uniform_set;
+		if (de.xforms_uniform_set.is_valid() && prev_xforms_uniform_set != de.xforms_uniform_set) {
+			RD::get_singleton()->draw_list_bind_uniform_set(draw_list, de.xforms_uniform_set, TRANSFORMS_UNIFORM_SET);
+			prev_xforms_uniform_set = de.xforms_uniform_set;
 		}
 
-		if (material != prev_material) {
-			//update uniform set
-			if (material->uniform_set.is_valid()) {
-				RD::get_singleton()->draw_list_bind_uniform_set(draw_list, material->uniform_set, MATERIAL_UNIFORM_SET);
-			}
-
-			prev_material = material;
+		if (de.material_uniform_set.is_valid() && de.material_uniform_set != prev_material_uniform_set) {
+			RD::get_singleton()->draw_list_bind_uniform_set(draw_list, de.material_uniform_set, MATERIAL_UNIFORM_SET);
+			prev_material_uniform_set = de.material_uniform_set;
 		}
 
 		push_constant.index = i;
 		RD::get_singleton()->draw_list_set_push_constant(draw_list, &push_constant, sizeof(PushConstant));
 
-		switch (e->instance->base_type) {
-			case RS::INSTANCE_MESH: {
-				RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid());
-			} break;
-			case RS::INSTANCE_MULTIMESH: {
-				uint32_t instances = storage->multimesh_get_instances_to_draw(e->instance->base);
-				RD::get_singleton()->draw_list_draw(draw_list, index_array_rd.is_valid(), instances);
-			} break;
-			case RS::INSTANCE_IMMEDIATE: {
-			} break;
-			case RS::INSTANCE_PARTICLES: {
-			} break;
-			default: {
-				ERR_CONTINUE(true); //should be a bug
-			}
+		RD::get_singleton()->draw_list_draw(draw_list, de.index_array.is_valid(), de.instances);
+	}
+}
+
+void RasterizerSceneHighEndRD::_render_list_split_job(uint32_t p_split, RenderListSplitData *p_data) {
+	int from = p_data->element_count * p_split / p_data->split_count;
+	int to = p_data->element_count * (p_split + 1) / p_data->split_count;
+	_render_list_record(p_data->split_ids[p_split], from, to, p_data->radiance_uniform_set, p_data->render_buffers_uniform_set, Vector2());
+}
+
+void RasterizerSceneHighEndRD::_render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, bool p_force_wireframe, const Vector2 &p_uv_offset) {
+	_render_list_resolve(p_framebuffer_Format, p_elements, p_element_count, p_reverse_cull, p_pass_mode, p_force_wireframe);
+	_render_list_record(p_draw_list, 0, p_element_count, p_radiance_uniform_set, p_render_buffers_uniform_set, p_uv_offset);
+}
+
+void RasterizerSceneHighEndRD::_render_list_draw(RID p_framebuffer, RD::InitialAction p_initial_color_action, RD::FinalAction p_final_color_action, RD::InitialAction p_initial_depth_action, RD::FinalAction p_final_depth_action, const Vector<Color> &p_clear_color_values, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, bool p_force_wireframe) {
+	RD::FramebufferFormatID framebuffer_format = RD::get_singleton()->framebuffer_get_format(p_framebuffer);
+
+	//pipelines, vertex arrays and uniform sets may be created on demand, so resolve them all here first
+	_render_list_resolve(framebuffer_format, p_elements, p_element_count, p_reverse_cull, p_pass_mode, p_force_wireframe);
+
+	uint32_t split_count = CLAMP(uint32_t(p_element_count) / RENDER_LIST_SPLIT_MIN_ELEMENTS, 1u, render_list_max_splits);
+
+	if (split_count > 1) {
+		RD::DrawListID split_ids[RENDER_LIST_MAX_SPLITS];
+		Error err = RD::get_singleton()->draw_list_begin_split(p_framebuffer, split_count, split_ids, p_initial_color_action, p_final_color_action, p_initial_depth_action, p_final_depth_action, p_clear_color_values, 1.0, 0);
+		if (err == OK) {
+			RenderListSplitData data;
+			data.split_ids = split_ids;
+			data.split_count = split_count;
+			data.element_count = p_element_count;
+			data.radiance_uniform_set = p_radiance_uniform_set;
+			data.render_buffers_uniform_set = p_render_buffers_uniform_set;
+
+			RasterizerRD::thread_work_pool.do_work(split_count, this, &RasterizerSceneHighEndRD::_render_list_split_job, &data);
+
+			RD::get_singleton()->draw_list_end();
+			return;
 		}
 	}
+
+	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(p_framebuffer, p_initial_color_action, p_final_color_action, p_initial_depth_action, p_final_depth_action, p_clear_color_values, 1.0, 0);
+	_render_list_record(draw_list, 0, p_element_count, p_radiance_uniform_set, p_render_buffers_uniform_set, Vector2());
+	RD::get_singleton()->draw_list_end();
 }
 
 void RasterizerSceneHighEndRD::_setup_environment(RID p_environment, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, RID p_reflection_probe, bool p_no_fog, const Size2 &p_screen_pixel_size, RID p_shadow_atlas, bool p_flip_y, const Color &p_default_bg_color, float p_znear, float p_zfar, bool p_opaque_render_buffers, bool p_pancake_shadows) {
@@ -1264,7 +1351,7 @@ void RasterizerSceneHighEndRD::_setup_environment(RID p_environment, const Camer
 	RD::get_singleton()->buffer_update(scene_state.uniform_buffer, 0, sizeof(SceneState::UBO), &scene_state.ubo, true);
 }
 
-void RasterizerSceneHighEndRD::_add_geometry(InstanceBase *p_instance, uint32_t p_surface, RID p_material, PassMode p_pass_mode, uint32_t p_geometry_index) {
+void RasterizerSceneHighEndRD::_add_geometry(LocalVector<FillElement> &r_elements, InstanceBase *p_instance, uint32_t p_surface, RID p_material, RID p_mesh, PassMode p_pass_mode, uint32_t p_texture_stream_size) {
 	RID m_src;
 
 	m_src = p_instance->material_override.is_valid() ? p_instance->material_override : p_material;
@@ -1293,39 +1380,29 @@ void RasterizerSceneHighEndRD::_add_geometry(InstanceBase *p_instance, uint32_t
 
 	ERR_FAIL_COND(!material);
 
-	_add_geometry_with_material(p_instance, p_surface, material, m_src, p_pass_mode, p_geometry_index);
+	if (p_texture_stream_size) {
+		material->request_texture_streaming(p_texture_stream_size);
+	}
+	_add_geometry_with_material(r_elements, p_instance, p_surface, material, m_src, p_mesh, p_pass_mode);
 
 	while (material->next_pass.is_valid()) {
 		material = (MaterialData *)storage->material_get_data(material->next_pass, RasterizerStorageRD::SHADER_TYPE_3D);
 		if (!material || !material->shader_data->valid) {
 			break;
 		}
-		_add_geometry_with_material(p_instance, p_surface, material, material->next_pass, p_pass_mode, p_geometry_index);
+		if (p_texture_stream_size) {
+			material->request_texture_streaming(p_texture_stream_size);
+		}
+		_add_geometry_with_material(r_elements, p_instance, p_surface, material, material->next_pass, p_mesh, p_pass_mode);
 	}
 }
 
-void RasterizerSceneHighEndRD::_add_geometry_with_material(InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, PassMode p_pass_mode, uint32_t p_geometry_index) {
+void RasterizerSceneHighEndRD::_add_geometry_with_material(LocalVector<FillElement> &r_elements, InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, RID p_mesh, PassMode p_pass_mode) {
 	bool has_read_screen_alpha = p_material->shader_data->uses_screen_texture || p_material->shader_data->uses_depth_texture || p_material->shader_data->uses_normal_texture;
 	bool has_base_alpha = (p_material->shader_data->uses_alpha || has_read_screen_alpha);
 	bool has_blend_alpha = p_material->shader_data->uses_blend_alpha;
 	bool has_alpha = has_base_alpha || has_blend_alpha;
 
-	if (p_material->shader_data->uses_sss) {
-		scene_state.used_sss = true;
-	}
-
-	if (p_material->shader_data->uses_screen_texture) {
-		scene_state.used_screen_texture = true;
-	}
-
-	if (p_material->shader_data->uses_depth_texture) {
-		scene_state.used_depth_texture = true;
-	}
-
-	if (p_material->shader_data->uses_normal_texture) {
-		scene_state.used_normal_texture = true;
-	}
-
 	if (p_pass_mode != PASS_MODE_COLOR && p_pass_mode != PASS_MODE_COLOR_SPECULAR) {
 		if (has_blend_alpha || has_read_screen_alpha || (has_base_alpha && !p_material->shader_data->uses_depth_pre_pass) || p_material->shader_data->depth_draw == ShaderData::DEPTH_DRAW_DISABLED || p_material->shader_data->depth_test == ShaderData::DEPTH_TEST_DISABLED || p_instance->cast_shadows == RS::SHADOW_CASTING_SETTING_OFF) {
 			//conditions in which no depth pass should be processed
@@ -1346,57 +1423,42 @@ void RasterizerSceneHighEndRD::_add_geometry_with_material(InstanceBase *p_insta
 		has_alpha = false;
 	}
 
-	RenderList::Element *e = (has_alpha || p_material->shader_data->depth_test == ShaderData::DEPTH_TEST_DISABLED) ? render_list.add_alpha_element() : render_list.add_element();
-
-	if (!e) {
-		return;
-	}
+	FillElement fe;
+	fe.alpha = has_alpha || p_material->shader_data->depth_test == ShaderData::DEPTH_TEST_DISABLED;
+	fe.material_rid = p_material_rid;
+	fe.mesh = p_mesh;
 
+	RenderList::Element *e = &fe.element;
 	e->instance = p_instance;
 	e->material = p_material;
 	e->surface_index = p_surface;
 	e->sort_key = 0;
-
-	if (e->material->last_pass != render_pass) {
-		if (!RD::get_singleton()->uniform_set_is_valid(e->material->uniform_set)) {
-			//uniform set no longer valid, probably a texture changed
-			storage->material_force_update_textures(p_material_rid, RasterizerStorageRD::SHADER_TYPE_3D);
-		}
-		e->material->last_pass = render_pass;
-		e->material->index = scene_state.current_material_index++;
-		if (e->material->shader_data->last_pass != render_pass) {
-			e->material->shader_data->last_pass = scene_state.current_material_index++;
-			e->material->shader_data->index = scene_state.current_shader_index++;
-		}
-	}
-	e->geometry_index = p_geometry_index;
-	e->material_index = e->material->index;
-	e->uses_instancing = e->instance->base_type == RS::INSTANCE_MULTIMESH;
-	e->uses_lightmap = e->instance->lightmap != nullptr || !e->instance->lightmap_sh.empty();
-	e->uses_vct = e->instance->gi_probe_instances.size();
-	e->shader_index = e->shader_index;
-	e->depth_layer = e->instance->depth_layer;
+	e->uses_instancing = p_instance->base_type == RS::INSTANCE_MULTIMESH;
+	e->uses_lightmap = p_instance->lightmap != nullptr || !p_instance->lightmap_sh.empty();
+	e->uses_vct = p_instance->gi_probe_instances.size();
+	e->depth_layer = p_instance->depth_layer;
 	e->priority = p_material->priority;
 
-	if (p_material->shader_data->uses_time) {
-		RenderingServerRaster::redraw_request();
-	}
+	r_elements.push_back(fe);
 }
 
-void RasterizerSceneHighEndRD::_fill_render_list(InstanceBase **p_cull_result, int p_cull_count, PassMode p_pass_mode, bool p_no_gi) {
-	scene_state.current_shader_index = 0;
-	scene_state.current_material_index = 0;
-	scene_state.used_sss = false;
-	scene_state.used_screen_texture = false;
-	scene_state.used_normal_texture = false;
-	scene_state.used_depth_texture = false;
-
-	uint32_t geometry_index = 0;
+void RasterizerSceneHighEndRD::_fill_render_list_chunk(uint32_t p_chunk, FillRenderListData *p_data) {
+	LocalVector<FillElement> &elements = fill_chunks[p_chunk];
+	int from = p_chunk * FILL_CHUNK_SIZE;
+	int to = MIN(from + FILL_CHUNK_SIZE, p_data->cull_count);
 
-	//fill list
+	for (int i = from; i < to; i++) {
+		InstanceBase *inst = p_data->cull_result[i];
 
-	for (int i = 0; i < p_cull_count; i++) {
-		InstanceBase *inst = p_cull_result[i];
+		//screen size of the instance bounds, used as the texel density its textures are streamed at
+		uint32_t texture_stream_size = 0;
+		if (p_data->texture_stream_scale > 0) {
+			float size = inst->transformed_aabb.get_longest_axis_size() * p_data->texture_stream_scale;
+			if (!p_data->texture_stream_orthogonal) {
+				size /= MAX(inst->depth, 0.01);
+			}
+			texture_stream_size = MAX(uint32_t(MIN(size, 16384.0f)), 1u);
+		}
 
 		//add geometry for drawing
 		switch (inst->base_type) {
@@ -1413,9 +1475,7 @@ void RasterizerSceneHighEndRD::_fill_render_list(InstanceBase **p_cull_result, i
 
 				for (uint32_t j = 0; j < surface_count; j++) {
 					RID material = inst_materials[j].is_valid() ? inst_materials[j] : materials[j];
-
-					uint32_t surface_index = storage->mesh_surface_get_render_pass_index(inst->base, j, render_pass, &geometry_index);
-					_add_geometry(inst, j, material, p_pass_mode, surface_index);
+					_add_geometry(elements, inst, j, material, inst->base, p_data->pass_mode, texture_stream_size);
 				}
 
 				//mesh->last_pass=frame;
@@ -1442,8 +1502,7 @@ void RasterizerSceneHighEndRD::_fill_render_list(InstanceBase **p_cull_result, i
 				}
 
 				for (uint32_t j = 0; j < surface_count; j++) {
-					uint32_t surface_index = storage->mesh_surface_get_multimesh_render_pass_index(mesh, j, render_pass, &geometry_index);
-					_add_geometry(inst, j, materials[j], p_pass_mode, surface_index);
+					_add_geometry(elements, inst, j, materials[j], mesh, p_data->pass_mode, texture_stream_size);
 				}
 
 			} break;
@@ -1487,6 +1546,102 @@ void RasterizerSceneHighEndRD::_fill_render_list(InstanceBase **p_cull_result, i
 	}
 }
 
+void RasterizerSceneHighEndRD::_fill_render_list(InstanceBase **p_cull_result, int p_cull_count, PassMode p_pass_mode, bool p_no_gi, float p_texture_stream_scale, bool p_texture_stream_orthogonal) {
+	scene_state.current_shader_index = 0;
+	scene_state.current_material_index = 0;
+	scene_state.used_sss = false;
+	scene_state.used_screen_texture = false;
+	scene_state.used_normal_texture = false;
+	scene_state.used_depth_texture = false;
+
+	//resolve surfaces and materials, in parallel for large lists
+
+	FillRenderListData data;
+	data.cull_result = p_cull_result;
+	data.cull_count = p_cull_count;
+	data.pass_mode = p_pass_mode;
+	data.texture_stream_scale = p_texture_stream_scale;
+	data.texture_stream_orthogonal = p_texture_stream_orthogonal;
+
+	uint32_t chunk_count = (p_cull_count + FILL_CHUNK_SIZE - 1) / FILL_CHUNK_SIZE;
+	if (fill_chunks.size() < chunk_count) {
+		fill_chunks.resize(chunk_count);
+	}
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		fill_chunks[i].clear();
+	}
+
+	if (chunk_count > 1) {
+		RasterizerRD::thread_work_pool.do_work(chunk_count, this, &RasterizerSceneHighEndRD::_fill_render_list_chunk, &data);
+	} else if (chunk_count == 1) {
+		_fill_render_list_chunk(0, &data);
+	}
+
+	//fill list in cull order, assigning the per pass indices used for sorting
+
+	uint32_t geometry_index = 0;
+
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		const LocalVector<FillElement> &elements = fill_chunks[i];
+
+		for (uint32_t j = 0; j < elements.size(); j++) {
+			const FillElement &fe = elements[j];
+
+			RenderList::Element *e = fe.alpha ? render_list.add_alpha_element() : render_list.add_element();
+
+			if (!e) {
+				continue;
+			}
+
+			*e = fe.element;
+
+			MaterialData *material = e->material;
+			ShaderData *shader = material->shader_data;
+
+			if (shader->uses_sss) {
+				scene_state.used_sss = true;
+			}
+
+			if (shader->uses_screen_texture) {
+				scene_state.used_screen_texture = true;
+			}
+
+			if (shader->uses_depth_texture) {
+				scene_state.used_depth_texture = true;
+			}
+
+			if (shader->uses_normal_texture) {
+				scene_state.used_normal_texture = true;
+			}
+
+			if (material->last_pass != render_pass) {
+				if (!RD::get_singleton()->uniform_set_is_valid(material->uniform_set)) {
+					//uniform set no longer valid, probably a texture changed
+					storage->material_force_update_textures(fe.material_rid, RasterizerStorageRD::SHADER_TYPE_3D);
+				}
+				material->last_pass = render_pass;
+				material->index = scene_state.current_material_index++;
+				if (shader->last_pass != render_pass) {
+					shader->last_pass = render_pass;
+					shader->index = scene_state.current_shader_index++;
+				}
+			}
+
+			if (e->uses_instancing) {
+				e->geometry_index = storage->mesh_surface_get_multimesh_render_pass_index(fe.mesh, e->surface_index, render_pass, &geometry_index);
+			} else {
+				e->geometry_index = storage->mesh_surface_get_render_pass_index(fe.mesh, e->surface_index, render_pass, &geometry_index);
+			}
+			e->material_index = material->index;
+			e->shader_index = shader->index;
+
+			if (shader->uses_time) {
+				RenderingServerRaster::redraw_request();
+			}
+		}
+	}
+}
+
 void RasterizerSceneHighEndRD::_setup_reflections(RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, const Transform &p_camera_inverse_transform, RID p_environment) {
 	for (int i = 0; i < p_reflection_probe_cull_count; i++) {
 		RID rpi = p_reflection_probe_cull_result[i];
@@ -2234,8 +2389,17 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 
 	_update_render_base_uniform_set(); //may have changed due to the above (light buffer enlarged, as an example)
 
+	float texture_stream_scale = 0;
+	if (render_buffer && vp_he.y > 0) {
+		//only views with render buffers request texture streaming, probes use whatever is resident
+		texture_stream_scale = render_buffer->height * 0.5 / vp_he.y;
+		if (!p_cam_ortogonal) {
+			texture_stream_scale *= p_cam_projection.get_z_near();
+		}
+	}
+
 	render_list.clear();
-	_fill_render_list(p_cull_result, p_cull_count, PASS_MODE_COLOR, render_buffer == nullptr);
+	_fill_render_list(p_cull_result, p_cull_count, PASS_MODE_COLOR, render_buffer == nullptr, texture_stream_scale, p_cam_ortogonal);
 
 	bool using_sss = render_buffer && scene_state.used_sss && sub_surface_scattering_get_quality() != RS::SUB_SURFACE_SCATTERING_QUALITY_DISABLED;
 
@@ -2324,9 +2488,7 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 		RENDER_TIMESTAMP("Render Depth Pre-Pass");
 
 		bool finish_depth = using_ssao;
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(depth_framebuffer, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, finish_depth ? RD::FINAL_ACTION_READ : RD::FINAL_ACTION_CONTINUE, depth_pass_clear);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(depth_framebuffer), render_list.elements, render_list.element_count, false, depth_pass_mode, render_buffer == nullptr, radiance_uniform_set, RID(), get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME);
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(depth_framebuffer, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, finish_depth ? RD::FINAL_ACTION_READ : RD::FINAL_ACTION_CONTINUE, depth_pass_clear, render_list.elements, render_list.element_count, false, depth_pass_mode, radiance_uniform_set, RID(), get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME);
 
 		if (render_buffer && render_buffer->msaa != RS::VIEWPORT_MSAA_DISABLED) {
 			if (finish_depth) {
@@ -2379,13 +2541,11 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 		}
 
 		RID framebuffer = using_separate_specular ? opaque_specular_framebuffer : opaque_framebuffer;
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, keep_color ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CLEAR, will_continue_color ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, depth_pre_pass ? (using_ssao ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CONTINUE) : RD::INITIAL_ACTION_CLEAR, will_continue_depth ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, c, 1.0, 0);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(framebuffer), render_list.elements, render_list.element_count, false, using_separate_specular ? PASS_MODE_COLOR_SPECULAR : PASS_MODE_COLOR, render_buffer == nullptr, radiance_uniform_set, render_buffers_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME);
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(framebuffer, keep_color ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CLEAR, will_continue_color ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, depth_pre_pass ? (using_ssao ? RD::INITIAL_ACTION_KEEP : RD::INITIAL_ACTION_CONTINUE) : RD::INITIAL_ACTION_CLEAR, will_continue_depth ? RD::FINAL_ACTION_CONTINUE : RD::FINAL_ACTION_READ, c, render_list.elements, render_list.element_count, false, using_separate_specular ? PASS_MODE_COLOR_SPECULAR : PASS_MODE_COLOR, radiance_uniform_set, render_buffers_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME);
 
 		if (will_continue_color && using_separate_specular) {
 			// close the specular framebuffer, as it's no longer used
-			draw_list = RD::get_singleton()->draw_list_begin(render_buffer->specular_only_fb, RD::INITIAL_ACTION_CONTINUE, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CONTINUE, RD::FINAL_ACTION_CONTINUE);
+			RD::get_singleton()->draw_list_begin(render_buffer->specular_only_fb, RD::INITIAL_ACTION_CONTINUE, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CONTINUE, RD::FINAL_ACTION_CONTINUE);
 			RD::get_singleton()->draw_list_end();
 		}
 	}
@@ -2454,9 +2614,7 @@ void RasterizerSceneHighEndRD::_render_scene(RID p_render_buffer, const Transfor
 	_fill_instances(&render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, false);
 
 	{
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(alpha_framebuffer, can_continue_color ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, can_continue_depth ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(alpha_framebuffer), &render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, false, PASS_MODE_COLOR, render_buffer == nullptr, radiance_uniform_set, render_buffers_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME);
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(alpha_framebuffer, can_continue_color ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, can_continue_depth ? RD::INITIAL_ACTION_CONTINUE : RD::INITIAL_ACTION_KEEP, RD::FINAL_ACTION_READ, Vector<Color>(), &render_list.elements[render_list.max_elements - render_list.alpha_element_count], render_list.alpha_element_count, false, PASS_MODE_COLOR, radiance_uniform_set, render_buffers_uniform_set, get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_WIREFRAME);
 	}
 
 	if (render_buffer && render_buffer->msaa != RS::VIEWPORT_MSAA_DISABLED) {
@@ -2491,9 +2649,7 @@ void RasterizerSceneHighEndRD::_render_shadow(RID p_framebuffer, InstanceBase **
 
 	{
 		//regular forward for now
-		RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(p_framebuffer, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ);
-		_render_list(draw_list, RD::get_singleton()->framebuffer_get_format(p_framebuffer), render_list.elements, render_list.element_count, p_use_dp_flip, pass_mode, true, RID(), RID());
-		RD::get_singleton()->draw_list_end();
+		_render_list_draw(p_framebuffer, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, RD::INITIAL_ACTION_CLEAR, RD::FINAL_ACTION_READ, Vector<Color>(), render_list.elements, render_list.element_count, p_use_dp_flip, pass_mode, RID(), RID());
 	}
 }
 
@@ -3201,6 +3357,7 @@ RasterizerSceneHighEndRD::RasterizerSceneHighEndRD(RasterizerStorageRD *p_storag
 	render_list.max_elements = GLOBAL_DEF_RST("rendering/limits/rendering/max_renderable_elements", (int)128000);
 	render_list.init();
 	render_pass = 0;
+	render_list_max_splits = CLAMP(OS::get_singleton()->get_processor_count(), 1, (int)RENDER_LIST_MAX_SPLITS);
 
 	{
 		scene_state.max_instances = render_list.max_elements;
@@ -3233,6 +3390,10 @@ RasterizerSceneHighEndRD::RasterizerSceneHighEndRD(RasterizerStorageRD *p_storag
 		storage->material_set_shader(wireframe_material, wireframe_material_shader);
 	}
 
+	//the materials above are the fallback while others build, so only enable this now
+	//editor previews are rendered once, they can't wait for a background build
+	shader.async_compile = GLOBAL_GET("rendering/quality/shading/async_compilation") && !Engine::get_singleton()->is_editor_hint();
+
 	{
 		default_vec4_xform_buffer = RD::get_singleton()->storage_buffer_create(256);
 		Vector<RD::Uniform> uniforms;
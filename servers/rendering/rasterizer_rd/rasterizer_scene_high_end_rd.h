@@ -31,6 +31,9 @@
 #ifndef RASTERIZER_SCENE_HIGHEND_RD_H
 #define RASTERIZER_SCENE_HIGHEND_RD_H
 
+#include "core/hashfuncs.h"
+#include "core/local_vector.h"
+#include "core/radix_sort.h"
 #include "servers/rendering/rasterizer_rd/light_cluster_builder.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_scene_rd.h"
 #include "servers/rendering/rasterizer_rd/rasterizer_storage_rd.h"
@@ -67,6 +70,7 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 	struct {
 		SceneHighEndShaderRD scene_shader;
 		ShaderCompilerRD compiler;
+		bool async_compile = false;
 	} shader;
 
 	RasterizerStorageRD *storage;
@@ -144,9 +148,16 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 		bool writes_modelview_or_projection;
 		bool uses_world_coordinates;
 
+		int blend_mode;
+		int cull_mode;
+		bool wireframe;
+		bool compiling = false; //variants are built in the background, the default material is used meanwhile
+
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		void _setup_pipelines();
+
 		virtual void set_code(const String &p_Code);
 		virtual void set_default_texture_param(const StringName &p_name, RID p_texture);
 		virtual void get_param_list(List<PropertyInfo> *p_param_list) const;
@@ -156,6 +167,7 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual Variant get_default_parameter(const StringName &p_parameter) const;
+		virtual bool is_compiling();
 		ShaderData();
 		virtual ~ShaderData();
 	};
@@ -485,6 +497,8 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 
 	/* Render List */
 
+public:
+	// Only depends on the instances it points to, so it's public to be tested on its own.
 	struct RenderList {
 		int max_elements;
 
@@ -515,64 +529,133 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 		int element_count;
 		int alpha_element_count;
 
+		// packed copy of the keys being sorted, so the sort itself never touches the elements
+		struct SortEntry {
+			uint64_t key;
+			uint32_t index;
+		};
+
+		SortEntry *sort_entries;
+		SortEntry *sort_temp;
+		Element **sort_elements;
+
+		// Sorting by key is a pure function of the key sequence, and the list is filled in cull order,
+		// so when the visible set and materials did not change since the last frame, the previous order is reused.
+		enum {
+			SORT_CACHE_MAX = 8
+		};
+
+		struct SortCache {
+			uint64_t hash = 0;
+			uint64_t last_used = 0;
+			LocalVector<uint64_t> keys;
+			LocalVector<uint32_t> order;
+		};
+
+		SortCache sort_cache[SORT_CACHE_MAX];
+		uint64_t sort_cache_pass;
+
 		void clear() {
 			element_count = 0;
 			alpha_element_count = 0;
 		}
 
-		//should eventually be replaced by radix
+		_FORCE_INLINE_ Element **_get_range(bool p_alpha, int &r_count) {
+			if (p_alpha) {
+				r_count = alpha_element_count;
+				return &elements[max_elements - alpha_element_count];
+			} else {
+				r_count = element_count;
+				return elements;
+			}
+		}
 
-		struct SortByKey {
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->sort_key < B->sort_key;
+		void _sort_entries(Element **p_elements, int p_count) {
+			SortEntry *sorted = RadixSort<SortEntry>().sort(sort_entries, sort_temp, p_count);
+			for (int i = 0; i < p_count; i++) {
+				p_elements[i] = &base_elements[sorted[i].index];
 			}
-		};
+		}
 
-		void sort_by_key(bool p_alpha) {
-			SortArray<Element *, SortByKey> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
+		void _apply_order(Element **p_elements, int p_count, const uint32_t *p_order) {
+			copymem(sort_elements, p_elements, sizeof(Element *) * p_count);
+			for (int i = 0; i < p_count; i++) {
+				p_elements[i] = sort_elements[p_order[i]];
 			}
 		}
 
-		struct SortByDepth {
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->instance->depth < B->instance->depth;
+		void sort_by_key(bool p_alpha) {
+			int count;
+			Element **src = _get_range(p_alpha, count);
+			if (count < 2) {
+				return;
 			}
-		};
 
-		void sort_by_depth(bool p_alpha) { //used for shadows
+			uint64_t hash = hash_djb2_one_64(count);
+			for (int i = 0; i < count; i++) {
+				sort_entries[i].key = src[i]->sort_key;
+				sort_entries[i].index = i;
+				hash = hash_djb2_one_64(sort_entries[i].key, hash);
+			}
 
-			SortArray<Element *, SortByDepth> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
+			sort_cache_pass++;
+
+			SortCache *cache = &sort_cache[0];
+			for (int i = 0; i < SORT_CACHE_MAX; i++) {
+				SortCache &c = sort_cache[i];
+				if (c.hash == hash && int(c.keys.size()) == count) {
+					bool match = true;
+					for (int j = 0; j < count; j++) {
+						if (c.keys[j] != sort_entries[j].key) {
+							match = false;
+							break;
+						}
+					}
+					if (match) {
+						c.last_used = sort_cache_pass;
+						_apply_order(src, count, c.order.ptr());
+						return;
+					}
+				}
+				if (c.last_used < cache->last_used) {
+					cache = &c; //least recently used
+				}
 			}
+
+			cache->hash = hash;
+			cache->last_used = sort_cache_pass;
+			cache->keys.resize(count);
+			cache->order.resize(count);
+			for (int i = 0; i < count; i++) {
+				cache->keys[i] = sort_entries[i].key;
+			}
+
+			SortEntry *sorted = RadixSort<SortEntry>().sort(sort_entries, sort_temp, count);
+			for (int i = 0; i < count; i++) {
+				cache->order[i] = sorted[i].index;
+			}
+			_apply_order(src, count, cache->order.ptr());
 		}
 
-		struct SortByReverseDepthAndPriority {
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				uint32_t layer_A = uint32_t(A->priority);
-				uint32_t layer_B = uint32_t(B->priority);
-				if (layer_A == layer_B) {
-					return A->instance->depth > B->instance->depth;
-				} else {
-					return layer_A < layer_B;
-				}
+		void sort_by_depth(bool p_alpha) { //used for shadows
+			int count;
+			Element **src = _get_range(p_alpha, count);
+			for (int i = 0; i < count; i++) {
+				sort_entries[i].key = RadixSort<SortEntry>::float_to_key(src[i]->instance->depth);
+				sort_entries[i].index = src[i] - base_elements;
 			}
-		};
+			_sort_entries(src, count);
+		}
 
 		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
-
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
-			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
-			} else {
-				sorter.sort(elements, element_count);
+			int count;
+			Element **src = _get_range(p_alpha, count);
+			for (int i = 0; i < count; i++) {
+				uint32_t depth_key = ~RadixSort<SortEntry>::float_to_key(src[i]->instance->depth);
+				sort_entries[i].key = (uint64_t(src[i]->priority) << 32) | depth_key;
+				sort_entries[i].index = src[i] - base_elements;
 			}
+			_sort_entries(src, count);
 		}
 
 		_FORCE_INLINE_ Element *add_element() {
@@ -598,6 +681,9 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 			alpha_element_count = 0;
 			elements = memnew_arr(Element *, max_elements);
 			base_elements = memnew_arr(Element, max_elements);
+			sort_entries = memnew_arr(SortEntry, max_elements);
+			sort_temp = memnew_arr(SortEntry, max_elements);
+			sort_elements = memnew_arr(Element *, max_elements);
 			for (int i = 0; i < max_elements; i++) {
 				elements[i] = &base_elements[i]; // assign elements
 			}
@@ -605,14 +691,19 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 
 		RenderList() {
 			max_elements = 0;
+			sort_cache_pass = 0;
 		}
 
 		~RenderList() {
 			memdelete_arr(elements);
 			memdelete_arr(base_elements);
+			memdelete_arr(sort_entries);
+			memdelete_arr(sort_temp);
+			memdelete_arr(sort_elements);
 		}
 	};
 
+private:
 	RenderList render_list;
 
 	static RasterizerSceneHighEndRD *singleton;
@@ -645,6 +736,56 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 		PASS_MODE_DEPTH_MATERIAL,
 	};
 
+	// The render list is built in two steps: materials and surfaces are resolved per chunk of the cull
+	// result in parallel, then the chunks are appended in order and given their per-pass indices.
+	enum {
+		FILL_CHUNK_SIZE = 256
+	};
+
+	struct FillElement {
+		RenderList::Element element;
+		RID material_rid;
+		RID mesh;
+		bool alpha;
+	};
+
+	struct FillRenderListData {
+		InstanceBase **cull_result;
+		int cull_count;
+		PassMode pass_mode;
+		float texture_stream_scale; //pixels per unit at distance one (at any distance if orthogonal), zero to not request streaming
+		bool texture_stream_orthogonal;
+	};
+
+	LocalVector<LocalVector<FillElement>> fill_chunks;
+
+	// Draw state of each render list element, resolved on the render thread so recording only reads
+	// resources that already exist and can be split into secondary draw lists recorded in parallel.
+	enum {
+		RENDER_LIST_SPLIT_MIN_ELEMENTS = 256,
+		RENDER_LIST_MAX_SPLITS = 16
+	};
+
+	struct DrawElement {
+		RID pipeline;
+		RID vertex_array;
+		RID index_array;
+		RID xforms_uniform_set;
+		RID material_uniform_set;
+		uint32_t instances;
+	};
+
+	struct RenderListSplitData {
+		RD::DrawListID *split_ids;
+		uint32_t split_count;
+		int element_count;
+		RID radiance_uniform_set;
+		RID render_buffers_uniform_set;
+	};
+
+	LocalVector<DrawElement> draw_elements;
+	uint32_t render_list_max_splits;
+
 	void _setup_environment(RID p_environment, const CameraMatrix &p_cam_projection, const Transform &p_cam_transform, RID p_reflection_probe, bool p_no_fog, const Size2 &p_screen_pixel_size, RID p_shadow_atlas, bool p_flip_y, const Color &p_default_bg_color, float p_znear, float p_zfar, bool p_opaque_render_buffers = false, bool p_pancake_shadows = false);
 	void _setup_lights(RID *p_light_cull_result, int p_light_cull_count, const Transform &p_camera_inverse_transform, RID p_shadow_atlas, bool p_using_shadows);
 	void _setup_decals(const RID *p_decal_instances, int p_decal_count, const Transform &p_camera_inverse_xform);
@@ -653,11 +794,16 @@ class RasterizerSceneHighEndRD : public RasterizerSceneRD {
 	void _setup_lightmaps(InstanceBase **p_lightmap_cull_result, int p_lightmap_cull_count, const Transform &p_cam_transform);
 
 	void _fill_instances(RenderList::Element **p_elements, int p_element_count, bool p_for_depth);
+	void _render_list_resolve(RenderingDevice::FramebufferFormatID p_framebuffer_format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_force_wireframe);
+	void _render_list_record(RenderingDevice::DrawListID p_draw_list, int p_from, int p_to, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, const Vector2 &p_uv_offset);
+	void _render_list_split_job(uint32_t p_split, RenderListSplitData *p_data);
 	void _render_list(RenderingDevice::DrawListID p_draw_list, RenderingDevice::FramebufferFormatID p_framebuffer_Format, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, bool p_no_gi, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, bool p_force_wireframe = false, const Vector2 &p_uv_offset = Vector2());
-	_FORCE_INLINE_ void _add_geometry(InstanceBase *p_instance, uint32_t p_surface, RID p_material, PassMode p_pass_mode, uint32_t p_geometry_index);
-	_FORCE_INLINE_ void _add_geometry_with_material(InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, PassMode p_pass_mode, uint32_t p_geometry_index);
+	void _render_list_draw(RID p_framebuffer, RD::InitialAction p_initial_color_action, RD::FinalAction p_final_color_action, RD::InitialAction p_initial_depth_action, RD::FinalAction p_final_depth_action, const Vector<Color> &p_clear_color_values, RenderList::Element **p_elements, int p_element_count, bool p_reverse_cull, PassMode p_pass_mode, RID p_radiance_uniform_set, RID p_render_buffers_uniform_set, bool p_force_wireframe = false);
+	_FORCE_INLINE_ void _add_geometry(LocalVector<FillElement> &r_elements, InstanceBase *p_instance, uint32_t p_surface, RID p_material, RID p_mesh, PassMode p_pass_mode, uint32_t p_texture_stream_size);
+	_FORCE_INLINE_ void _add_geometry_with_material(LocalVector<FillElement> &r_elements, InstanceBase *p_instance, uint32_t p_surface, MaterialData *p_material, RID p_material_rid, RID p_mesh, PassMode p_pass_mode);
+	void _fill_render_list_chunk(uint32_t p_chunk, FillRenderListData *p_data);
 
-	void _fill_render_list(InstanceBase **p_cull_result, int p_cull_count, PassMode p_pass_mode, bool p_no_gi);
+	void _fill_render_list(InstanceBase **p_cull_result, int p_cull_count, PassMode p_pass_mode, bool p_no_gi, float p_texture_stream_scale = 0, bool p_texture_stream_orthogonal = false);
 
 protected:
 	virtual void _render_scene(RID p_render_buffer, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_ortogonal, InstanceBase **p_cull_result, int p_cull_count, RID *p_light_cull_result, int p_light_cull_count, RID *p_reflection_probe_cull_result, int p_reflection_probe_cull_count, RID *p_gi_probe_cull_result, int p_gi_probe_cull_count, RID *p_decal_cull_result, int p_decal_cull_count, InstanceBase **p_lightmap_cull_result, int p_lightmap_cull_count, RID p_environment, RID p_camera_effects, RID p_shadow_atlas, RID p_reflection_atlas, RID p_reflection_probe, int p_reflection_probe_pass, const Color &p_default_bg_color);
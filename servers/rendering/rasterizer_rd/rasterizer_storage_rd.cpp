@@ -975,6 +975,43 @@ void RasterizerStorageRD::texture_set_detect_roughness_callback(RID p_texture, R
 	tex->detect_roughness_callback = p_callback;
 }
 
+void RasterizerStorageRD::texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata) {
+	Texture *tex = texture_owner.getornull(p_texture);
+	ERR_FAIL_COND(!tex);
+	tex->stream_callback_ud = p_userdata;
+	tex->stream_callback = p_callback;
+	tex->stream_request_size = 0;
+
+	if (p_callback) {
+		texture_stream_set.insert(p_texture);
+	} else {
+		texture_stream_set.erase(p_texture);
+	}
+}
+
+void RasterizerStorageRD::_update_texture_streaming() {
+	//dispatch the sizes requested while drawing the last frame
+	List<RID> to_erase;
+
+	for (Set<RID>::Element *E = texture_stream_set.front(); E; E = E->next()) {
+		Texture *tex = texture_owner.getornull(E->get());
+		if (!tex || !tex->stream_callback) {
+			to_erase.push_back(E->get()); //freed or replaced
+			continue;
+		}
+
+		if (tex->stream_request_size) {
+			tex->stream_callback(tex->stream_callback_ud, tex->stream_request_size);
+			tex->stream_request_size = 0;
+		}
+	}
+
+	while (to_erase.front()) {
+		texture_stream_set.erase(to_erase.front()->get());
+		to_erase.pop_front();
+	}
+}
+
 void RasterizerStorageRD::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 }
 
@@ -1055,6 +1092,10 @@ void RasterizerStorageRD::shader_set_code(RID p_shader, const String &p_code) {
 
 	if (shader->data) {
 		shader->data->set_code(p_code);
+		if (shader->data->is_compiling()) {
+			compiling_shaders.insert(p_shader);
+			compiling_shader_count.store(compiling_shaders.size());
+		}
 	}
 
 	for (Set<Material *>::Element *E = shader->owners.front(); E; E = E->next()) {
@@ -1064,6 +1105,30 @@ void RasterizerStorageRD::shader_set_code(RID p_shader, const String &p_code) {
 	}
 }
 
+void RasterizerStorageRD::_update_compiling_shaders() {
+	Set<RID>::Element *E = compiling_shaders.front();
+	while (E) {
+		Set<RID>::Element *N = E->next();
+
+		Shader *shader = shader_owner.getornull(E->get());
+		if (!shader || !shader->data || !shader->data->is_compiling()) {
+			if (shader) {
+				//materials could not create their uniform sets until now
+				for (Set<Material *>::Element *F = shader->owners.front(); F; F = F->next()) {
+					Material *material = F->get();
+					material->instance_dependency.instance_notify_changed(false, true);
+					_material_queue_update(material, true, true);
+				}
+			}
+			compiling_shaders.erase(E);
+		}
+
+		E = N;
+	}
+
+	compiling_shader_count.store(compiling_shaders.size());
+}
+
 String RasterizerStorageRD::shader_get_code(RID p_shader) const {
 	Shader *shader = shader_owner.getornull(p_shader);
 	ERR_FAIL_COND_V(!shader, String());
@@ -1831,8 +1896,20 @@ RasterizerStorageRD::MaterialData::~MaterialData() {
 	}
 }
 
+void RasterizerStorageRD::MaterialData::request_texture_streaming(uint32_t p_size) const {
+	if (stream_textures.empty()) {
+		return;
+	}
+
+	RasterizerStorageRD *singleton = (RasterizerStorageRD *)RasterizerStorage::base_singleton;
+	for (int i = 0; i < stream_textures.size(); i++) {
+		singleton->texture_request_streaming(stream_textures[i], p_size);
+	}
+}
+
 void RasterizerStorageRD::MaterialData::update_textures(const Map<StringName, Variant> &p_parameters, const Map<StringName, RID> &p_default_textures, const Vector<ShaderCompilerRD::GeneratedCode::Texture> &p_texture_uniforms, RID *p_textures, bool p_use_linear_color) {
 	RasterizerStorageRD *singleton = (RasterizerStorageRD *)RasterizerStorage::base_singleton;
+	stream_textures.clear();
 #ifdef TOOLS_ENABLED
 	Texture *roughness_detect_texture = nullptr;
 	RS::TextureDetectRoughnessChannel roughness_channel = RS::TEXTURE_DETECT_ROUGNHESS_R;
@@ -1914,6 +1991,9 @@ void RasterizerStorageRD::MaterialData::update_textures(const Map<StringName, Va
 
 			if (tex) {
 				rd_texture = (srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
+				if (tex->stream_callback) {
+					stream_textures.push_back(texture);
+				}
 #ifdef TOOLS_ENABLED
 				if (tex->detect_3d_callback && p_use_linear_color) {
 					tex->detect_3d_callback(tex->detect_3d_callback_ud);
@@ -2153,7 +2233,7 @@ void RasterizerStorageRD::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_
 
 	mesh->instance_dependency.instance_notify_changed(true, true);
 
-	mesh->material_cache.clear();
+	mesh->material_cache.push_back(s->material);
 }
 
 int RasterizerStorageRD::mesh_get_blend_shape_count(RID p_mesh) const {
@@ -2194,7 +2274,7 @@ void RasterizerStorageRD::mesh_surface_set_material(RID p_mesh, int p_surface, R
 	mesh->surfaces[p_surface]->material = p_material;
 
 	mesh->instance_dependency.instance_notify_changed(false, true);
-	mesh->material_cache.clear();
+	mesh->material_cache.write[p_surface] = p_material;
 }
 
 RID RasterizerStorageRD::mesh_surface_get_material(RID p_mesh, int p_surface) const {
@@ -5597,7 +5677,9 @@ void RasterizerStorageRD::_update_global_variables() {
 }
 
 void RasterizerStorageRD::update_dirty_resources() {
+	_update_texture_streaming();
 	_update_global_variables(); //must do before materials, so it can queue them for update
+	_update_compiling_shaders(); //same
 	_update_queued_materials();
 	_update_dirty_multimeshes();
 	_update_dirty_skeletons();
@@ -5673,6 +5755,8 @@ bool RasterizerStorageRD::free(RID p_rid) {
 		if (shader->data) {
 			memdelete(shader->data);
 		}
+		compiling_shaders.erase(p_rid);
+		compiling_shader_count.store(compiling_shaders.size());
 		shader_owner.free(p_rid);
 
 	} else if (material_owner.owns(p_rid)) {
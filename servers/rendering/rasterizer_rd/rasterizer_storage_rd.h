@@ -38,6 +38,8 @@
 #include "servers/rendering/rasterizer_rd/shaders/giprobe_sdf.glsl.gen.h"
 #include "servers/rendering/rendering_device.h"
 
+#include <atomic>
+
 class RasterizerStorageRD : public RasterizerStorage {
 public:
 	enum ShaderType {
@@ -58,6 +60,7 @@ public:
 		virtual bool is_animated() const = 0;
 		virtual bool casts_shadows() const = 0;
 		virtual Variant get_default_parameter(const StringName &p_parameter) const = 0;
+		virtual bool is_compiling() { return false; } //true while built in the background, finishes setup once done
 		virtual ~ShaderData() {}
 	};
 
@@ -72,9 +75,13 @@ public:
 		virtual void update_parameters(const Map<StringName, Variant> &p_parameters, bool p_uniform_dirty, bool p_textures_dirty) = 0;
 		virtual ~MaterialData();
 
+		//report the on-screen size (in pixels) the material was drawn at to its streamed textures, thread safe
+		void request_texture_streaming(uint32_t p_size) const;
+
 	private:
 		friend class RasterizerStorageRD;
 		RID self;
+		Vector<RID> stream_textures;
 		List<RID>::Element *global_buffer_E = nullptr;
 		List<RID>::Element *global_texture_E = nullptr;
 		uint64_t global_textures_pass = 0;
@@ -157,6 +164,10 @@ private:
 
 		RS::TextureDetectRoughnessCallback detect_roughness_callback = nullptr;
 		void *detect_roughness_callback_ud = nullptr;
+
+		RS::TextureStreamCallback stream_callback = nullptr;
+		void *stream_callback_ud = nullptr;
+		uint32_t stream_request_size = 0; //largest size requested this frame, written from render list threads
 	};
 
 	struct TextureToRDFormat {
@@ -179,6 +190,9 @@ private:
 	//textures can be created from threads, so this RID_Owner is thread safe
 	mutable RID_Owner<Texture, true> texture_owner;
 
+	Set<RID> texture_stream_set;
+	void _update_texture_streaming();
+
 	Ref<Image> _validate_texture_format(const Ref<Image> &p_image, TextureToRDFormat &r_format);
 
 	RID default_rd_textures[DEFAULT_RD_TEXTURE_MAX];
@@ -243,6 +257,10 @@ private:
 	ShaderDataRequestFunction shader_data_request_func[SHADER_TYPE_MAX];
 	mutable RID_Owner<Shader> shader_owner;
 
+	Set<RID> compiling_shaders;
+	std::atomic<uint32_t> compiling_shader_count = { 0 }; // size of compiling_shaders, read from other threads for render info
+	void _update_compiling_shaders();
+
 	/* Material */
 
 	struct Material {
@@ -695,6 +713,7 @@ public:
 	virtual void texture_set_detect_3d_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata);
+	virtual void texture_set_stream_callback(RID p_texture, RS::TextureStreamCallback p_callback, void *p_userdata);
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info);
 
@@ -743,6 +762,18 @@ public:
 		return Size2i(tex->width_2d, tex->height_2d);
 	}
 
+	_FORCE_INLINE_ bool texture_streaming_is_active() const {
+		return !texture_stream_set.empty();
+	}
+
+	//p_size is the largest on-screen size (in pixels) the whole texture is drawn at, safe to call from render threads
+	_FORCE_INLINE_ void texture_request_streaming(RID p_texture, uint32_t p_size) {
+		Texture *tex = texture_owner.getornull(p_texture);
+		if (tex && tex->stream_callback) {
+			atomic_exchange_if_greater(&tex->stream_request_size, p_size);
+		}
+	}
+
 	_FORCE_INLINE_ RID texture_rd_get_default(DefaultRDTexture p_texture) {
 		return default_rd_textures[p_texture];
 	}
@@ -829,14 +860,8 @@ public:
 		if (r_surface_count == 0) {
 			return nullptr;
 		}
-		if (mesh->material_cache.empty()) {
-			mesh->material_cache.resize(mesh->surface_count);
-			for (uint32_t i = 0; i < r_surface_count; i++) {
-				mesh->material_cache.write[i] = mesh->surfaces[i]->material;
-			}
-		}
 
-		return mesh->material_cache.ptr();
+		return mesh->material_cache.ptr(); //kept in sync with the surfaces, so this is safe to call from render list threads
 	}
 
 	_FORCE_INLINE_ RS::PrimitiveType mesh_surface_get_primitive(RID p_mesh, uint32_t p_surface_index) {
@@ -847,7 +872,7 @@ public:
 		return mesh->surfaces[p_surface_index]->primitive;
 	}
 
-	_FORCE_INLINE_ void mesh_surface_get_arrays_and_format(RID p_mesh, uint32_t p_surface_index, uint32_t p_input_mask, RID &r_vertex_array_rd, RID &r_index_array_rd, RD::VertexFormatID &r_vertex_format) {
+	_FORCE_INLINE_ void mesh_surface_get_arrays_and_format(RID p_mesh, uint32_t p_surface_index, uint32_t p_input_mask, float p_lod_threshold, RID &r_vertex_array_rd, RID &r_index_array_rd, RD::VertexFormatID &r_vertex_format) {
 		Mesh *mesh = mesh_owner.getornull(p_mesh);
 		ERR_FAIL_COND(!mesh);
 		ERR_FAIL_UNSIGNED_INDEX(p_surface_index, mesh->surface_count);
@@ -856,6 +881,15 @@ public:
 
 		r_index_array_rd = s->index_array;
 
+		//use the coarsest LOD whose error is below the threshold
+		float lod_error = -1.0;
+		for (uint32_t i = 0; i < s->lod_count; i++) {
+			if (s->lods[i].edge_length <= p_lod_threshold && s->lods[i].edge_length >= lod_error) {
+				lod_error = s->lods[i].edge_length;
+				r_index_array_rd = s->lods[i].index_array;
+			}
+		}
+
 		s->version_lock.lock();
 
 		//there will never be more than, at much, 3 or 4 versions, so iterating is the fastest way
@@ -1425,7 +1459,7 @@ public:
 	void render_info_end_capture() {}
 	int get_captured_render_info(RS::RenderInfo p_info) { return 0; }
 
-	int get_render_info(RS::RenderInfo p_info) { return 0; }
+	int get_render_info(RS::RenderInfo p_info) { return p_info == RS::INFO_SHADER_COMPILATIONS_PENDING ? int(compiling_shader_count.load()) : 0; }
 	String get_video_adapter_name() const { return String(); }
 	String get_video_adapter_vendor() const { return String(); }
 
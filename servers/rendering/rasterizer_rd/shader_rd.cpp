@@ -30,10 +30,20 @@
 
 #include "shader_rd.h"
 
+#include "core/crypto/crypto_core.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
 #include "core/string_builder.h"
+#include "core/version.h"
 #include "rasterizer_rd.h"
 #include "servers/rendering/rendering_device.h"
 
+#define SHADER_CACHE_MAGIC 0x56535047 //GPSV
+#define SHADER_CACHE_VERSION 1
+
+String ShaderRD::shader_cache_dir;
+String ShaderRD::shader_cache_device;
+
 void ShaderRD::setup(const char *p_vertex_code, const char *p_fragment_code, const char *p_compute_code, const char *p_name) {
 	name = p_name;
 	//split vertex and shader code (thank you, shader compiler programmers from you know what company).
@@ -181,12 +191,14 @@ RID ShaderRD::version_create() {
 	Version version;
 	version.dirty = true;
 	version.valid = false;
-	version.initialize_needed = true;
 	version.variants = nullptr;
+	version.compile_job = nullptr;
 	return version_owner.make_rid(version);
 }
 
 void ShaderRD::_clear_version(Version *p_version) {
+	_cancel_compile(p_version);
+
 	//clear versions if they exist
 	if (p_version->variants) {
 		for (int i = 0; i < variant_defines.size(); i++) {
@@ -198,6 +210,76 @@ void ShaderRD::_clear_version(Version *p_version) {
 	}
 }
 
+String ShaderRD::_get_cache_path(RD::ShaderStage p_stage, const CharString &p_source) {
+	// Content addressed: anything that can change the resulting SPIR-V goes into the key.
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+	uint32_t header[2] = { SHADER_CACHE_VERSION, uint32_t(p_stage) };
+	ctx.update((const uint8_t *)header, sizeof(header));
+	CharString device = shader_cache_device.utf8();
+	ctx.update((const uint8_t *)device.get_data(), device.length());
+	ctx.update((const uint8_t *)p_source.get_data(), p_source.length());
+	unsigned char hash[32];
+	ctx.finish(hash);
+
+	return shader_cache_dir.plus_file(String::hex_encode_buffer(hash, 32) + ".spv");
+}
+
+Vector<uint8_t> ShaderRD::_load_from_cache(const String &p_path) {
+	Vector<uint8_t> spirv;
+
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	if (!f) {
+		return spirv;
+	}
+
+	uint32_t magic = f->get_32();
+	uint32_t version = f->get_32();
+	uint32_t size = f->get_32();
+
+	// Reject anything stale or truncated, it will simply be compiled again.
+	if (magic == SHADER_CACHE_MAGIC && version == SHADER_CACHE_VERSION && size > 0 && (size % 4) == 0 && f->get_len() == size + 12) {
+		spirv.resize(size);
+		if (f->get_buffer(spirv.ptrw(), size) != int(size) || *(const uint32_t *)spirv.ptr() != 0x07230203) { //SPIR-V magic number
+			spirv.clear();
+		}
+	}
+
+	memdelete(f);
+	return spirv;
+}
+
+void ShaderRD::_save_to_cache(const String &p_path, const Vector<uint8_t> &p_spirv) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(!f, "Can't write shader cache file: " + p_path + ".");
+
+	f->store_32(SHADER_CACHE_MAGIC);
+	f->store_32(SHADER_CACHE_VERSION);
+	f->store_32(p_spirv.size());
+	f->store_buffer(p_spirv.ptr(), p_spirv.size());
+	memdelete(f);
+}
+
+Vector<uint8_t> ShaderRD::_compile_stage(RD::ShaderStage p_stage, const String &p_source, String *r_error) {
+	if (shader_cache_dir == String()) {
+		return RD::get_singleton()->shader_compile_from_source(p_stage, p_source, RD::SHADER_LANGUAGE_GLSL, r_error);
+	}
+
+	String path = _get_cache_path(p_stage, p_source.utf8());
+
+	Vector<uint8_t> spirv = _load_from_cache(path);
+	if (spirv.size()) {
+		return spirv;
+	}
+
+	spirv = RD::get_singleton()->shader_compile_from_source(p_stage, p_source, RD::SHADER_LANGUAGE_GLSL, r_error);
+	if (spirv.size()) {
+		_save_to_cache(path, spirv);
+	}
+
+	return spirv;
+}
+
 void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 	Vector<RD::ShaderStageData> stages;
 
@@ -236,7 +318,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		current_source = builder.as_string();
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_VERTEX, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spir_v = _compile_stage(RD::SHADER_STAGE_VERTEX, current_source, &error);
 		if (stage.spir_v.size() == 0) {
 			build_ok = false;
 		} else {
@@ -280,7 +362,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		current_source = builder.as_string();
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_FRAGMENT, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spir_v = _compile_stage(RD::SHADER_STAGE_FRAGMENT, current_source, &error);
 		if (stage.spir_v.size() == 0) {
 			build_ok = false;
 		} else {
@@ -320,7 +402,7 @@ void ShaderRD::_compile_variant(uint32_t p_variant, Version *p_version) {
 
 		current_source = builder.as_string();
 		RD::ShaderStageData stage;
-		stage.spir_v = RD::get_singleton()->shader_compile_from_source(RD::SHADER_STAGE_COMPUTE, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spir_v = _compile_stage(RD::SHADER_STAGE_COMPUTE, current_source, &error);
 		if (stage.spir_v.size() == 0) {
 			build_ok = false;
 		} else {
@@ -363,6 +445,10 @@ void ShaderRD::_compile_version(Version *p_version) {
 	}
 #endif
 
+	_validate_version(p_version);
+}
+
+void ShaderRD::_validate_version(Version *p_version) {
 	bool all_valid = true;
 	for (int i = 0; i < variant_defines.size(); i++) {
 		if (p_version->variants[i].is_null()) {
@@ -403,11 +489,8 @@ void ShaderRD::version_set_code(RID p_version, const String &p_uniforms, const S
 		version->custom_defines.push_back(p_custom_defines[i].utf8());
 	}
 
+	_cancel_compile(version); //whatever is being built is stale now
 	version->dirty = true;
-	if (version->initialize_needed) {
-		_compile_version(version);
-		version->initialize_needed = false;
-	}
 }
 
 void ShaderRD::version_set_compute_code(RID p_version, const String &p_uniforms, const String &p_compute_globals, const String &p_compute_code, const Vector<String> &p_custom_defines) {
@@ -424,11 +507,8 @@ void ShaderRD::version_set_compute_code(RID p_version, const String &p_uniforms,
 		version->custom_defines.push_back(p_custom_defines[i].utf8());
 	}
 
+	_cancel_compile(version); //whatever is being built is stale now
 	version->dirty = true;
-	if (version->initialize_needed) {
-		_compile_version(version);
-		version->initialize_needed = false;
-	}
 }
 
 bool ShaderRD::version_is_valid(RID p_version) {
@@ -439,9 +519,122 @@ bool ShaderRD::version_is_valid(RID p_version) {
 		_compile_version(version);
 	}
 
+	if (version->compile_job && _check_compile(version)) {
+		return false;
+	}
+
 	return version->valid;
 }
 
+void ShaderRD::_compile_thread_func(void *p_self) {
+	ShaderRD *self = (ShaderRD *)p_self;
+
+	while (true) {
+		self->compile_semaphore.wait();
+
+		CompileJob *job = nullptr;
+		{
+			MutexLock lock(self->compile_mutex);
+			if (self->compile_exit) {
+				break;
+			}
+			if (self->compile_queue.size()) {
+				job = self->compile_queue.front()->get();
+				self->compile_queue.pop_front();
+			}
+		}
+
+		if (!job) {
+			continue;
+		}
+
+		self->compile_work_pool.do_work(self->variant_defines.size(), self, &ShaderRD::_compile_variant, job->version);
+		self->_validate_version(job->version);
+
+		MutexLock lock(self->compile_mutex);
+		job->done = true;
+		if (job->cancelled) {
+			self->_free_compile_job(job); //nobody is waiting for it anymore
+		}
+	}
+}
+
+void ShaderRD::_free_compile_job(CompileJob *p_job) {
+	if (p_job->version->variants) {
+		for (int i = 0; i < variant_defines.size(); i++) {
+			if (p_job->version->variants[i].is_valid()) {
+				RD::get_singleton()->free(p_job->version->variants[i]);
+			}
+		}
+		memdelete_arr(p_job->version->variants);
+	}
+	memdelete(p_job->version);
+	memdelete(p_job);
+}
+
+void ShaderRD::_cancel_compile(Version *p_version) {
+	CompileJob *job = p_version->compile_job;
+	if (!job) {
+		return;
+	}
+	p_version->compile_job = nullptr;
+
+	MutexLock lock(compile_mutex);
+	if (job->done || compile_queue.erase(job)) {
+		_free_compile_job(job);
+	} else {
+		job->cancelled = true; //being built right now, the thread frees it once done
+	}
+}
+
+bool ShaderRD::_check_compile(Version *p_version) {
+	CompileJob *job = p_version->compile_job;
+	{
+		MutexLock lock(compile_mutex);
+		if (!job->done) {
+			return true;
+		}
+	}
+
+	//take over what the job built
+	p_version->variants = job->version->variants;
+	p_version->valid = job->version->valid;
+	job->version->variants = nullptr;
+	p_version->compile_job = nullptr;
+	_free_compile_job(job);
+
+	return false;
+}
+
+void ShaderRD::version_compile_async(RID p_version) {
+	Version *version = version_owner.getornull(p_version);
+	ERR_FAIL_COND(!version);
+
+	_clear_version(version);
+	version->valid = false;
+	version->dirty = false;
+
+	CompileJob *job = memnew(CompileJob);
+	job->version = memnew(Version(*version));
+	job->version->variants = memnew_arr(RID, variant_defines.size());
+	version->compile_job = job;
+
+	MutexLock lock(compile_mutex);
+	if (!compile_thread) {
+		compile_work_pool.init(MAX(1, OS::get_singleton()->get_processor_count() / 2)); //leave room for the game while building
+		compile_thread = Thread::create(_compile_thread_func, this);
+	}
+	compile_queue.push_back(job);
+	compile_semaphore.post();
+}
+
+bool ShaderRD::version_is_compiling(RID p_version) {
+	Version *version = version_owner.getornull(p_version);
+	ERR_FAIL_COND_V(!version, false);
+
+	return version->compile_job && _check_compile(version);
+}
+
 bool ShaderRD::version_free(RID p_version) {
 	if (version_owner.owns(p_version)) {
 		Version *version = version_owner.getornull(p_version);
@@ -463,7 +656,29 @@ void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String
 	}
 }
 
+void ShaderRD::set_shader_cache_dir(const String &p_dir) {
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	Error err = da->make_dir_recursive(p_dir);
+	memdelete(da);
+	ERR_FAIL_COND_MSG(err != OK, "Can't create shader cache directory: " + p_dir + ".");
+
+	shader_cache_dir = p_dir;
+	// The compiler ships with the engine, so a new build invalidates the cache too.
+	shader_cache_device = RD::get_singleton()->get_device_identifier() + " " + VERSION_FULL_BUILD;
+}
+
 ShaderRD::~ShaderRD() {
+	if (compile_thread) {
+		{
+			MutexLock lock(compile_mutex);
+			compile_exit = true;
+		}
+		compile_semaphore.post();
+		Thread::wait_to_finish(compile_thread);
+		memdelete(compile_thread);
+		compile_work_pool.finish();
+	}
+
 	List<RID> remaining;
 	version_owner.get_owned_list(&remaining);
 	if (remaining.size()) {
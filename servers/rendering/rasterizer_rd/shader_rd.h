@@ -33,9 +33,14 @@
 
 #include "core/hash_map.h"
 #include "core/map.h"
+#include "core/list.h"
 #include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/rid_owner.h"
+#include "core/thread_work_pool.h"
 #include "core/variant.h"
+#include "servers/rendering/rendering_device.h"
 
 #include <stdio.h>
 /**
@@ -47,6 +52,8 @@ class ShaderRD {
 	CharString general_defines;
 	Vector<CharString> variant_defines;
 
+	struct CompileJob;
+
 	struct Version {
 		CharString uniforms;
 		CharString vertex_globals;
@@ -62,16 +69,38 @@ class ShaderRD {
 
 		bool valid;
 		bool dirty;
-		bool initialize_needed;
+		CompileJob *compile_job; //not null while being built in the background
 	};
 
 	Mutex variant_set_mutex;
 
 	void _compile_variant(uint32_t p_variant, Version *p_version);
+	void _validate_version(Version *p_version);
+	Vector<uint8_t> _compile_stage(RD::ShaderStage p_stage, const String &p_source, String *r_error);
 
 	void _clear_version(Version *p_version);
 	void _compile_version(Version *p_version);
 
+	//background compilation, each job builds a private copy of the version so the original can keep changing
+
+	struct CompileJob {
+		Version *version = nullptr;
+		bool done = false;
+		bool cancelled = false;
+	};
+
+	Thread *compile_thread = nullptr;
+	Semaphore compile_semaphore;
+	Mutex compile_mutex;
+	List<CompileJob *> compile_queue;
+	bool compile_exit = false;
+	ThreadWorkPool compile_work_pool;
+
+	static void _compile_thread_func(void *p_self);
+	void _free_compile_job(CompileJob *p_job);
+	void _cancel_compile(Version *p_version);
+	bool _check_compile(Version *p_version);
+
 	RID_Owner<Version> version_owner;
 
 	CharString fragment_codev; //for version and extensions
@@ -97,6 +126,13 @@ class ShaderRD {
 
 	const char *name;
 
+	static String shader_cache_dir;
+	static String shader_cache_device;
+
+	static String _get_cache_path(RD::ShaderStage p_stage, const CharString &p_source);
+	static Vector<uint8_t> _load_from_cache(const String &p_path);
+	static void _save_to_cache(const String &p_path, const Vector<uint8_t> &p_spirv);
+
 protected:
 	ShaderRD() {}
 	void setup(const char *p_vertex_code, const char *p_fragment_code, const char *p_compute_code, const char *p_name);
@@ -117,6 +153,10 @@ public:
 			_compile_version(version);
 		}
 
+		if (version->compile_job && _check_compile(version)) {
+			return RID(); //still compiling in the background
+		}
+
 		if (!version->valid) {
 			return RID();
 		}
@@ -126,9 +166,14 @@ public:
 
 	bool version_is_valid(RID p_version);
 
+	void version_compile_async(RID p_version);
+	bool version_is_compiling(RID p_version);
+
 	bool version_free(RID p_version);
 
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
+
+	static void set_shader_cache_dir(const String &p_dir);
 	virtual ~ShaderRD();
 };
 
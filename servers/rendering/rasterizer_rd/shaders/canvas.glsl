@@ -25,6 +25,12 @@ layout(location = 3) out vec2 pixel_size_interp;
 
 #endif
 
+#ifdef USE_BATCHING
+
+layout(location = 3) flat out uint batch_index_interp;
+
+#endif
+
 #ifdef USE_MATERIAL_UNIFORMS
 layout(set = 1, binding = 1, std140) uniform MaterialUniforms{
 	/* clang-format off */
@@ -38,6 +44,12 @@ VERTEX_SHADER_GLOBALS
 /* clang-format on */
 
 void main() {
+#ifdef USE_BATCHING
+	uint batch_index = draw_data_batch.batch_offset + uint(gl_InstanceIndex);
+	load_batch_instance(batch_index);
+	batch_index_interp = batch_index;
+#endif
+
 	vec4 instance_custom = vec4(0.0);
 #ifdef USE_PRIMITIVE
 
@@ -223,6 +235,12 @@ layout(location = 3) in vec2 pixel_size_interp;
 
 #endif
 
+#ifdef USE_BATCHING
+
+layout(location = 3) flat in uint batch_index_interp;
+
+#endif
+
 layout(location = 0) out vec4 frag_color;
 
 #ifdef USE_MATERIAL_UNIFORMS
@@ -303,6 +321,10 @@ float map_ninepatch_axis(float pixel, float draw_size, float tex_pixel_size, flo
 #endif
 
 void main() {
+#ifdef USE_BATCHING
+	load_batch_instance(batch_index_interp);
+#endif
+
 	vec4 color = color_interp;
 	vec2 uv = uv_interp;
 	vec2 vertex = vertex_interp;
@@ -45,13 +45,18 @@ layout(push_constant, binding = 0, std430) uniform DrawData {
 	vec4 ninepatch_margins;
 	vec4 dst_rect; //for built-in rect and UV
 	vec4 src_rect;
-	vec2 pad;
+	uint batch_offset; //first instance in batch_instances, when batching
+	uint pad;
 
 #endif
 	vec2 color_texture_pixel_size;
 	uint lights[4];
 }
+#ifdef USE_BATCHING
+draw_data_batch; //combined with the batch instance into draw_data, see load_batch_instance()
+#else
 draw_data;
+#endif
 
 // The values passed per draw primitives are cached within it
 
@@ -137,6 +142,24 @@ layout(set = 2, binding = 7, std430) restrict readonly buffer GlobalVariableData
 }
 global_variables;
 
+//rects drawn in batches read their per rect data from here, indexed by instance
+
+struct BatchInstance {
+	vec2 world_x;
+	vec2 world_y;
+	vec2 world_ofs;
+	uint flags;
+	uint specular_shininess;
+	vec4 modulation;
+	vec4 dst_rect;
+	vec4 src_rect;
+};
+
+layout(set = 2, binding = 8, std430) restrict readonly buffer BatchInstanceData {
+	BatchInstance data[];
+}
+batch_instances;
+
 /* SET3: Render Target Data */
 
 #ifdef SCREEN_TEXTURE_USED
@@ -144,3 +167,37 @@ global_variables;
 layout(set = 3, binding = 0) uniform texture2D screen_texture;
 
 #endif
+
+#ifdef USE_BATCHING
+
+struct DrawData {
+	vec2 world_x;
+	vec2 world_y;
+	vec2 world_ofs;
+	uint flags;
+	uint specular_shininess;
+	vec4 modulation;
+	vec4 ninepatch_margins;
+	vec4 dst_rect;
+	vec4 src_rect;
+	vec2 color_texture_pixel_size;
+	uint lights[4];
+};
+
+DrawData draw_data;
+
+void load_batch_instance(uint p_index) {
+	draw_data.world_x = batch_instances.data[p_index].world_x;
+	draw_data.world_y = batch_instances.data[p_index].world_y;
+	draw_data.world_ofs = batch_instances.data[p_index].world_ofs;
+	draw_data.flags = draw_data_batch.flags | batch_instances.data[p_index].flags;
+	draw_data.specular_shininess = batch_instances.data[p_index].specular_shininess;
+	draw_data.modulation = batch_instances.data[p_index].modulation;
+	draw_data.ninepatch_margins = vec4(0.0);
+	draw_data.dst_rect = batch_instances.data[p_index].dst_rect;
+	draw_data.src_rect = batch_instances.data[p_index].src_rect;
+	draw_data.color_texture_pixel_size = draw_data_batch.color_texture_pixel_size;
+	draw_data.lights = draw_data_batch.lights;
+}
+
+#endif
@@ -1045,6 +1045,8 @@ public:
 
 	virtual uint64_t get_memory_usage() const = 0;
 
+	virtual String get_device_identifier() const = 0; //vendor, device and driver version, used to key caches
+
 	virtual RenderingDevice *create_local_device() = 0;
 
 	static RenderingDevice *get_singleton();
@@ -38,8 +38,9 @@ static const int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
 void RenderingServerCanvas::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RasterizerCanvas::Light *p_lights) {
 	RENDER_TIMESTAMP("Cull CanvasItem Tree");
 
-	memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
-	memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
+	//z buckets are kept clear between trees, only the used range is walked and cleared again
+	z_used_min = z_range;
+	z_used_max = -1;
 
 	for (int i = 0; i < p_child_item_count; i++) {
 		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr);
@@ -51,7 +52,7 @@ void RenderingServerCanvas::_render_canvas_item_tree(RID p_to_render_target, Can
 	RasterizerCanvas::Item *list = nullptr;
 	RasterizerCanvas::Item *list_end = nullptr;
 
-	for (int i = 0; i < z_range; i++) {
+	for (int i = z_used_min; i <= z_used_max; i++) {
 		if (!z_list[i]) {
 			continue;
 		}
@@ -64,6 +65,11 @@ void RenderingServerCanvas::_render_canvas_item_tree(RID p_to_render_target, Can
 		}
 	}
 
+	if (z_used_min <= z_used_max) {
+		memset(z_list + z_used_min, 0, (z_used_max - z_used_min + 1) * sizeof(RasterizerCanvas::Item *));
+		memset(z_last_list + z_used_min, 0, (z_used_max - z_used_min + 1) * sizeof(RasterizerCanvas::Item *));
+	}
+
 	RENDER_TIMESTAMP("Render Canvas Items");
 
 	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_transform);
@@ -97,6 +103,63 @@ void _mark_ysort_dirty(RenderingServerCanvas::Item *ysort_owner, RID_PtrOwner<Re
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+void _mark_bounds_dirty(RenderingServerCanvas::Item *p_canvas_item, RID_PtrOwner<RenderingServerCanvas::Item> &canvas_item_owner) {
+	p_canvas_item->bounds_dirty = true;
+
+	//parents already dirty have all their own parents dirty too, so the walk can stop there
+	RenderingServerCanvas::Item *parent = canvas_item_owner.owns(p_canvas_item->parent) ? canvas_item_owner.getornull(p_canvas_item->parent) : nullptr;
+	while (parent) {
+		if (parent->sort_y) {
+			parent->ysort_dirty = true; //child positions may have changed
+		}
+		if (parent->bounds_dirty) {
+			break;
+		}
+		parent->bounds_dirty = true;
+		parent = canvas_item_owner.owns(parent->parent) ? canvas_item_owner.getornull(parent->parent) : nullptr;
+	}
+}
+
+void _update_bounds(RenderingServerCanvas::Item *p_canvas_item) {
+	RenderingServerCanvas::Item *ci = p_canvas_item;
+
+	ci->bounds_dirty = false;
+	ci->bounds_empty = ci->commands == nullptr && !ci->custom_rect;
+	ci->bounds_cull_disabled = ci->vp_render || ci->copy_back_buffer || ci->update_when_visible;
+
+	if (!ci->bounds_empty) {
+		ci->bounds = ci->get_rect();
+	}
+
+	int child_item_count = ci->child_items.size();
+	RenderingServerCanvas::Item **child_items = ci->child_items.ptrw();
+	for (int i = 0; i < child_item_count; i++) {
+		RenderingServerCanvas::Item *child = child_items[i];
+		//hidden children are cleaned too, so a dirty item always has a dirty parent
+		if (child->bounds_dirty) {
+			_update_bounds(child);
+		}
+
+		if (!child->visible) {
+			continue;
+		}
+
+		ci->bounds_cull_disabled = ci->bounds_cull_disabled || child->bounds_cull_disabled;
+
+		if (child->bounds_empty) {
+			continue;
+		}
+
+		Rect2 child_bounds = child->xform.xform(child->bounds);
+		if (ci->bounds_empty) {
+			ci->bounds = child_bounds;
+			ci->bounds_empty = false;
+		} else {
+			ci->bounds = ci->bounds.merge(child_bounds);
+		}
+	}
+}
+
 void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner) {
 	Item *ci = p_canvas_item;
 
@@ -104,13 +167,31 @@ void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transfo
 		return;
 	}
 
+	if (ci->bounds_dirty) {
+		_update_bounds(ci);
+	}
+
+	Transform2D xform = p_transform * ci->xform;
+
+	if (!ci->bounds_cull_disabled) {
+		//nothing in this subtree can be visible, skip it entirely
+		if (ci->bounds_empty) {
+			return;
+		}
+
+		Rect2 global_bounds = xform.xform(ci->bounds);
+		global_bounds.position += p_clip_rect.position;
+		if (!p_clip_rect.intersects(global_bounds, true)) {
+			return;
+		}
+	}
+
 	if (ci->children_order_dirty) {
 		ci->child_items.sort_custom<ItemIndexSort>();
 		ci->children_order_dirty = false;
 	}
 
 	Rect2 rect = ci->get_rect();
-	Transform2D xform = p_transform * ci->xform;
 	Rect2 global_rect = xform.xform(rect);
 	global_rect.position += p_clip_rect.position;
 
@@ -146,16 +227,24 @@ void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transfo
 		if (ci->ysort_children_count == -1) {
 			ci->ysort_children_count = 0;
 			_collect_ysort_children(ci, Transform2D(), p_material_owner, nullptr, ci->ysort_children_count);
+			ci->ysort_dirty = true;
 		}
 
-		child_item_count = ci->ysort_children_count;
-		child_items = (Item **)alloca(child_item_count * sizeof(Item *));
+		if (ci->ysort_dirty || ci->ysort_material_owner != p_material_owner) {
+			ci->ysort_children.resize(ci->ysort_children_count);
+
+			int i = 0;
+			_collect_ysort_children(ci, Transform2D(), p_material_owner, ci->ysort_children.ptrw(), i);
 
-		int i = 0;
-		_collect_ysort_children(ci, Transform2D(), p_material_owner, child_items, i);
+			SortArray<Item *, ItemPtrSort> sorter;
+			sorter.sort(ci->ysort_children.ptrw(), ci->ysort_children_count);
 
-		SortArray<Item *, ItemPtrSort> sorter;
-		sorter.sort(child_items, child_item_count);
+			ci->ysort_dirty = false;
+			ci->ysort_material_owner = p_material_owner;
+		}
+
+		child_item_count = ci->ysort_children.size();
+		child_items = ci->ysort_children.ptrw();
 	}
 
 	if (ci->z_relative) {
@@ -192,6 +281,8 @@ void RenderingServerCanvas::_cull_canvas_item(Item *p_canvas_item, const Transfo
 		ci->light_masked = false;
 
 		int zidx = p_z - RS::CANVAS_ITEM_Z_MIN;
+		z_used_min = MIN(z_used_min, zidx);
+		z_used_max = MAX(z_used_max, zidx);
 
 		if (z_last_list[zidx]) {
 			z_last_list[zidx]->next = ci;
@@ -346,6 +437,7 @@ void RenderingServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
+			_mark_bounds_dirty(item_owner, canvas_item_owner);
 		}
 
 		canvas_item->parent = RID();
@@ -373,6 +465,8 @@ void RenderingServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 	}
 
 	canvas_item->parent = p_parent;
+
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 }
 
 void RenderingServerCanvas::canvas_item_set_visible(RID p_item, bool p_visible) {
@@ -382,6 +476,7 @@ void RenderingServerCanvas::canvas_item_set_visible(RID p_item, bool p_visible)
 	canvas_item->visible = p_visible;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 }
 
 void RenderingServerCanvas::canvas_item_set_light_mask(RID p_item, int p_mask) {
@@ -396,6 +491,8 @@ void RenderingServerCanvas::canvas_item_set_transform(RID p_item, const Transfor
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->xform = p_transform;
+
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 }
 
 void RenderingServerCanvas::canvas_item_set_clip(RID p_item, bool p_clip) {
@@ -418,6 +515,8 @@ void RenderingServerCanvas::canvas_item_set_custom_rect(RID p_item, bool p_custo
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 }
 
 void RenderingServerCanvas::canvas_item_set_modulate(RID p_item, const Color &p_color) {
@@ -446,6 +545,8 @@ void RenderingServerCanvas::canvas_item_set_update_when_visible(RID p_item, bool
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 }
 
 void RenderingServerCanvas::canvas_item_set_default_texture_filter(RID p_item, RS::CanvasItemTextureFilter p_filter) {
@@ -463,6 +564,7 @@ void RenderingServerCanvas::canvas_item_set_default_texture_repeat(RID p_item, R
 void RenderingServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!line);
@@ -488,6 +590,7 @@ void RenderingServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Po
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!pline);
@@ -579,6 +682,7 @@ void RenderingServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<P
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!pline);
@@ -598,6 +702,7 @@ void RenderingServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<P
 void RenderingServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -608,6 +713,7 @@ void RenderingServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect
 void RenderingServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandPolygon *circle = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!circle);
@@ -645,6 +751,7 @@ void RenderingServerCanvas::canvas_item_add_circle(RID p_item, const Point2 &p_p
 void RenderingServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -676,6 +783,7 @@ void RenderingServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2
 void RenderingServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, bool p_clip_uv, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -716,6 +824,7 @@ void RenderingServerCanvas::canvas_item_add_texture_rect_region(RID p_item, cons
 void RenderingServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_COND(!style);
@@ -739,6 +848,7 @@ void RenderingServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<P
 
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!prim);
@@ -766,6 +876,7 @@ void RenderingServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<P
 void RenderingServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -788,6 +899,7 @@ void RenderingServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Poi
 void RenderingServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -810,6 +922,7 @@ void RenderingServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vec
 void RenderingServerCanvas::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_COND(!tr);
@@ -819,6 +932,7 @@ void RenderingServerCanvas::canvas_item_add_set_transform(RID p_item, const Tran
 void RenderingServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
 	ERR_FAIL_COND(!m);
@@ -832,6 +946,7 @@ void RenderingServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh,
 void RenderingServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_COND(!part);
@@ -846,6 +961,7 @@ void RenderingServerCanvas::canvas_item_add_particles(RID p_item, RID p_particle
 void RenderingServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture, RID p_normal_map, RID p_specular_map, const Color &p_specular_color_shininess, RenderingServer::CanvasItemTextureFilter p_filter, RenderingServer::CanvasItemTextureRepeat p_repeat) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_COND(!mm);
@@ -857,6 +973,7 @@ void RenderingServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RI
 void RenderingServerCanvas::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.getornull(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_COND(!ci);
@@ -911,6 +1028,8 @@ void RenderingServerCanvas::canvas_item_set_copy_to_backbuffer(RID p_item, bool
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 }
 
 void RenderingServerCanvas::canvas_item_clear(RID p_item) {
@@ -918,6 +1037,8 @@ void RenderingServerCanvas::canvas_item_clear(RID p_item) {
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->clear();
+
+	_mark_bounds_dirty(canvas_item, canvas_item_owner);
 }
 
 void RenderingServerCanvas::canvas_item_set_draw_index(RID p_item, int p_index) {
@@ -929,6 +1050,12 @@ void RenderingServerCanvas::canvas_item_set_draw_index(RID p_item, int p_index)
 	if (canvas_item_owner.owns(canvas_item->parent)) {
 		Item *canvas_item_parent = canvas_item_owner.getornull(canvas_item->parent);
 		canvas_item_parent->children_order_dirty = true;
+
+		//y-sorted parents collect their children in draw order, so they have to sort them again
+		for (Item *ysort_owner = canvas_item_parent; ysort_owner && ysort_owner->sort_y;) {
+			ysort_owner->ysort_dirty = true;
+			ysort_owner = canvas_item_owner.owns(ysort_owner->parent) ? canvas_item_owner.getornull(ysort_owner->parent) : nullptr;
+		}
 		return;
 	}
 
@@ -951,6 +1078,8 @@ void RenderingServerCanvas::canvas_item_set_use_parent_material(RID p_item, bool
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->use_parent_material = p_enable;
+
+	_mark_ysort_dirty(canvas_item, canvas_item_owner); //material owners are assigned when collecting y-sorted children
 }
 
 RID RenderingServerCanvas::canvas_light_create() {
@@ -1316,6 +1445,7 @@ bool RenderingServerCanvas::free(RID p_rid) {
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
 				}
+				_mark_bounds_dirty(item_owner, canvas_item_owner);
 			}
 		}
 
@@ -1390,6 +1520,10 @@ bool RenderingServerCanvas::free(RID p_rid) {
 RenderingServerCanvas::RenderingServerCanvas() {
 	z_list = (RasterizerCanvas::Item **)memalloc(z_range * sizeof(RasterizerCanvas::Item *));
 	z_last_list = (RasterizerCanvas::Item **)memalloc(z_range * sizeof(RasterizerCanvas::Item *));
+	memset(z_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
+	memset(z_last_list, 0, z_range * sizeof(RasterizerCanvas::Item *));
+	z_used_min = z_range;
+	z_used_max = -1;
 
 	disable_scale = false;
 }
@@ -54,6 +54,17 @@ public:
 		RS::CanvasItemTextureFilter texture_filter;
 		RS::CanvasItemTextureRepeat texture_repeat;
 
+		//bounds of this item and all its children, in local coordinates, used to cull whole subtrees
+		Rect2 bounds;
+		bool bounds_dirty;
+		bool bounds_empty;
+		bool bounds_cull_disabled;
+
+		//sorted children of y-sorted items, only collected and sorted again when something below changed
+		bool ysort_dirty;
+		Item *ysort_material_owner;
+		Vector<Item *> ysort_children;
+
 		Vector<Item *> child_items;
 
 		Item() {
@@ -71,6 +82,11 @@ public:
 			ysort_pos = Vector2();
 			texture_filter = RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT;
 			texture_repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
+			bounds_dirty = true;
+			bounds_empty = true;
+			bounds_cull_disabled = false;
+			ysort_dirty = true;
+			ysort_material_owner = nullptr;
 		}
 	};
 
@@ -162,6 +178,8 @@ private:
 
 	RasterizerCanvas::Item **z_list;
 	RasterizerCanvas::Item **z_last_list;
+	int z_used_min;
+	int z_used_max;
 
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RasterizerCanvas::Light *p_lights, RasterizerCanvas::Light *p_masked_lights, const Rect2 &p_clip_rect);
@@ -190,6 +190,7 @@ public:
 	BIND3(texture_set_detect_3d_callback, RID, TextureDetectCallback, void *)
 	BIND3(texture_set_detect_normal_callback, RID, TextureDetectCallback, void *)
 	BIND3(texture_set_detect_roughness_callback, RID, TextureDetectRoughnessCallback, void *)
+	BIND3(texture_set_stream_callback, RID, TextureStreamCallback, void *)
 
 	BIND2(texture_set_path, RID, const String &)
 	BIND1RC(String, texture_get_path, RID)
@@ -466,6 +467,11 @@ public:
 	BIND2(camera_set_camera_effects, RID, RID)
 	BIND2(camera_set_use_vertical_aspect, RID, bool)
 
+	/* OCCLUDER API */
+
+	BIND0R(RID, occluder_create)
+	BIND3(occluder_set_mesh, RID, const PackedVector3Array &, const PackedInt32Array &)
+
 #undef BINDBASE
 //from now on, calls forwarded to this singleton
 #define BINDBASE RSG::viewport
@@ -625,6 +631,7 @@ public:
 
 	BIND5(instance_geometry_set_draw_range, RID, float, float, float, float)
 	BIND2(instance_geometry_set_as_instance_lod, RID, RID)
+	BIND2(instance_geometry_set_lod_bias, RID, float)
 	BIND4(instance_geometry_set_lightmap, RID, RID, const Rect2 &, int)
 
 	BIND3(instance_geometry_set_shader_parameter, RID, const StringName &, const Variant &)
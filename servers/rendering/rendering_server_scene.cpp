@@ -31,6 +31,8 @@
 #include "rendering_server_scene.h"
 
 #include "core/os/os.h"
+#include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "rendering_server_globals.h"
 #include "rendering_server_raster.h"
 
@@ -102,9 +104,46 @@ void RenderingServerScene::camera_set_use_vertical_aspect(RID p_camera, bool p_e
 	camera->vaspect = p_enable;
 }
 
+/* OCCLUDER API */
+
+RID RenderingServerScene::occluder_create() {
+	Occluder *occluder = memnew(Occluder);
+	return occluder_owner.make_rid(occluder);
+}
+
+void RenderingServerScene::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	ERR_FAIL_COND(p_indices.size() % 3 != 0);
+
+	int vertex_count = p_vertices.size();
+	const int *indices = p_indices.ptr();
+	for (int i = 0; i < p_indices.size(); i++) {
+		ERR_FAIL_INDEX(indices[i], vertex_count);
+	}
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+	OcclusionBuffer::build_edge_neighbors(indices, p_indices.size(), occluder->edge_neighbors);
+
+	occluder->aabb = AABB();
+	const Vector3 *vertices = p_vertices.ptr();
+	for (int i = 0; i < vertex_count; i++) {
+		if (i == 0) {
+			occluder->aabb.position = vertices[i];
+		} else {
+			occluder->aabb.expand_to(vertices[i]);
+		}
+	}
+
+	for (Set<Instance *>::Element *E = occluder->users.front(); E; E = E->next()) {
+		_instance_queue_update(E->get(), true, false);
+	}
+}
+
 /* SCENARIO API */
 
-void *RenderingServerScene::_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int) {
+void *RenderingServerScene::_instance_pair(void *p_self, DynamicBVHElementID, Instance *p_A, int, DynamicBVHElementID, Instance *p_B, int) {
 	//RenderingServerScene *self = (RenderingServerScene*)p_self;
 	Instance *A = p_A;
 	Instance *B = p_B;
@@ -198,7 +237,7 @@ void *RenderingServerScene::_instance_pair(void *p_self, OctreeElementID, Instan
 	return nullptr;
 }
 
-void RenderingServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *udata) {
+void RenderingServerScene::_instance_unpair(void *p_self, DynamicBVHElementID, Instance *p_A, int, DynamicBVHElementID, Instance *p_B, int, void *udata) {
 	//RenderingServerScene *self = (RenderingServerScene*)p_self;
 	Instance *A = p_A;
 	Instance *B = p_B;
@@ -283,8 +322,8 @@ RID RenderingServerScene::scenario_create() {
 	RID scenario_rid = scenario_owner.make_rid(scenario);
 	scenario->self = scenario_rid;
 
-	scenario->octree.set_pair_callback(_instance_pair, this);
-	scenario->octree.set_unpair_callback(_instance_unpair, this);
+	scenario->bvh.set_pair_callback(_instance_pair, this);
+	scenario->bvh.set_unpair_callback(_instance_unpair, this);
 	scenario->reflection_probe_shadow_atlas = RSG::scene_render->shadow_atlas_create();
 	RSG::scene_render->shadow_atlas_set_size(scenario->reflection_probe_shadow_atlas, 1024); //make enough shadows for close distance, don't bother with rest
 	RSG::scene_render->shadow_atlas_set_quadrant_subdivision(scenario->reflection_probe_shadow_atlas, 0, 4);
@@ -361,9 +400,9 @@ void RenderingServerScene::instance_set_base(RID p_instance, RID p_base) {
 	if (instance->base_type != RS::INSTANCE_NONE) {
 		//free anything related to that base
 
-		if (scenario && instance->octree_id) {
-			scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (scenario && instance->bvh_id) {
+			scenario->bvh.erase(instance->bvh_id); //make dependencies generated by the bvh go away
+			instance->bvh_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -392,6 +431,17 @@ void RenderingServerScene::instance_set_base(RID p_instance, RID p_base) {
 				RSG::scene_render->free(decal->instance);
 
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = static_cast<InstanceOccluderData *>(instance->base_data);
+				if (instance->scenario && occluder_data->O) {
+					instance->scenario->occluders.erase(occluder_data->O);
+					occluder_data->O = nullptr;
+				}
+				Occluder *occluder = occluder_owner.getornull(instance->base);
+				if (occluder) {
+					occluder->users.erase(instance);
+				}
+			} break;
 			case RS::INSTANCE_LIGHTMAP: {
 				InstanceLightmapData *lightmap_data = static_cast<InstanceLightmapData *>(instance->base_data);
 				//erase dependencies, since no longer a lightmap
@@ -435,7 +485,11 @@ void RenderingServerScene::instance_set_base(RID p_instance, RID p_base) {
 	instance->base = RID();
 
 	if (p_base.is_valid()) {
-		instance->base_type = RSG::storage->get_base_type(p_base);
+		if (occluder_owner.owns(p_base)) {
+			instance->base_type = RS::INSTANCE_OCCLUDER;
+		} else {
+			instance->base_type = RSG::storage->get_base_type(p_base);
+		}
 		ERR_FAIL_COND(instance->base_type == RS::INSTANCE_NONE);
 
 		switch (instance->base_type) {
@@ -474,6 +528,16 @@ void RenderingServerScene::instance_set_base(RID p_instance, RID p_base) {
 
 				decal->instance = RSG::scene_render->decal_instance_create(p_base);
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = memnew(InstanceOccluderData);
+				instance->base_data = occluder_data;
+
+				if (scenario) {
+					occluder_data->O = scenario->occluders.push_back(instance);
+				}
+
+				occluder_owner.getornull(p_base)->users.insert(instance);
+			} break;
 			case RS::INSTANCE_LIGHTMAP: {
 				InstanceLightmapData *lightmap_data = memnew(InstanceLightmapData);
 				instance->base_data = lightmap_data;
@@ -498,7 +562,9 @@ void RenderingServerScene::instance_set_base(RID p_instance, RID p_base) {
 		instance->base = p_base;
 
 		//forcefully update the dependency now, so if for some reason it gets removed, we can immediately clear it
-		RSG::storage->base_update_dependency(p_base, instance);
+		if (instance->base_type != RS::INSTANCE_OCCLUDER) {
+			RSG::storage->base_update_dependency(p_base, instance);
+		}
 	}
 
 	_instance_queue_update(instance, true, true);
@@ -511,9 +577,9 @@ void RenderingServerScene::instance_set_scenario(RID p_instance, RID p_scenario)
 	if (instance->scenario) {
 		instance->scenario->instances.remove(&instance->scenario_item);
 
-		if (instance->octree_id) {
-			instance->scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
-			instance->octree_id = 0;
+		if (instance->bvh_id) {
+			instance->scenario->bvh.erase(instance->bvh_id); //make dependencies generated by the bvh go away
+			instance->bvh_id = 0;
 		}
 
 		switch (instance->base_type) {
@@ -534,6 +600,13 @@ void RenderingServerScene::instance_set_scenario(RID p_instance, RID p_scenario)
 				RSG::scene_render->reflection_probe_release_atlas_index(reflection_probe->instance);
 
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = static_cast<InstanceOccluderData *>(instance->base_data);
+				if (occluder_data->O) {
+					instance->scenario->occluders.erase(occluder_data->O);
+					occluder_data->O = nullptr;
+				}
+			} break;
 			case RS::INSTANCE_GI_PROBE: {
 				InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(instance->base_data);
 
@@ -575,6 +648,10 @@ void RenderingServerScene::instance_set_scenario(RID p_instance, RID p_scenario)
 					light->D = scenario->directional_lights.push_back(instance);
 				}
 			} break;
+			case RS::INSTANCE_OCCLUDER: {
+				InstanceOccluderData *occluder_data = static_cast<InstanceOccluderData *>(instance->base_data);
+				occluder_data->O = scenario->occluders.push_back(instance);
+			} break;
 			case RS::INSTANCE_GI_PROBE: {
 				InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(instance->base_data);
 				if (!gi_probe->update_element.in_list()) {
@@ -668,32 +745,32 @@ void RenderingServerScene::instance_set_visible(RID p_instance, bool p_visible)
 
 	switch (instance->base_type) {
 		case RS::INSTANCE_LIGHT: {
-			if (RSG::storage->light_get_type(instance->base) != RS::LIGHT_DIRECTIONAL && instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_LIGHT, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
+			if (RSG::storage->light_get_type(instance->base) != RS::LIGHT_DIRECTIONAL && instance->bvh_id && instance->scenario) {
+				instance->scenario->bvh.set_pairable(instance->bvh_id, p_visible, 1 << RS::INSTANCE_LIGHT, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case RS::INSTANCE_REFLECTION_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_REFLECTION_PROBE, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
+			if (instance->bvh_id && instance->scenario) {
+				instance->scenario->bvh.set_pairable(instance->bvh_id, p_visible, 1 << RS::INSTANCE_REFLECTION_PROBE, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case RS::INSTANCE_DECAL: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_DECAL, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
+			if (instance->bvh_id && instance->scenario) {
+				instance->scenario->bvh.set_pairable(instance->bvh_id, p_visible, 1 << RS::INSTANCE_DECAL, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case RS::INSTANCE_LIGHTMAP: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_LIGHTMAP, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
+			if (instance->bvh_id && instance->scenario) {
+				instance->scenario->bvh.set_pairable(instance->bvh_id, p_visible, 1 << RS::INSTANCE_LIGHTMAP, p_visible ? RS::INSTANCE_GEOMETRY_MASK : 0);
 			}
 
 		} break;
 		case RS::INSTANCE_GI_PROBE: {
-			if (instance->octree_id && instance->scenario) {
-				instance->scenario->octree.set_pairable(instance->octree_id, p_visible, 1 << RS::INSTANCE_GI_PROBE, p_visible ? (RS::INSTANCE_GEOMETRY_MASK | (1 << RS::INSTANCE_LIGHT)) : 0);
+			if (instance->bvh_id && instance->scenario) {
+				instance->scenario->bvh.set_pairable(instance->bvh_id, p_visible, 1 << RS::INSTANCE_GI_PROBE, p_visible ? (RS::INSTANCE_GEOMETRY_MASK | (1 << RS::INSTANCE_LIGHT)) : 0);
 			}
 
 		} break;
@@ -768,7 +845,7 @@ Vector<ObjectID> RenderingServerScene::instances_cull_aabb(const AABB &p_aabb, R
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_aabb(p_aabb, cull, 1024);
+	culled = scenario->bvh.cull_aabb(p_aabb, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 		Instance *instance = cull[i];
@@ -791,7 +868,7 @@ Vector<ObjectID> RenderingServerScene::instances_cull_ray(const Vector3 &p_from,
 
 	int culled = 0;
 	Instance *cull[1024];
-	culled = scenario->octree.cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
+	culled = scenario->bvh.cull_segment(p_from, p_from + p_to * 10000, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 		Instance *instance = cull[i];
@@ -815,7 +892,7 @@ Vector<ObjectID> RenderingServerScene::instances_cull_convex(const Vector<Plane>
 	int culled = 0;
 	Instance *cull[1024];
 
-	culled = scenario->octree.cull_convex(p_convex, cull, 1024);
+	culled = scenario->bvh.cull_convex(p_convex, cull, 1024);
 
 	for (int i = 0; i < culled; i++) {
 		Instance *instance = cull[i];
@@ -847,14 +924,14 @@ void RenderingServerScene::instance_geometry_set_flag(RID p_instance, RS::Instan
 				return;
 			}
 
-			if (instance->octree_id != 0) {
-				//remove from octree, it needs to be re-paired
-				instance->scenario->octree.erase(instance->octree_id);
-				instance->octree_id = 0;
+			if (instance->bvh_id != 0) {
+				//remove from bvh, it needs to be re-paired
+				instance->scenario->bvh.erase(instance->bvh_id);
+				instance->bvh_id = 0;
 				_instance_queue_update(instance, true, true);
 			}
 
-			//once out of octree, can be changed
+			//once out of bvh, can be changed
 			instance->dynamic_gi = p_enabled;
 
 		} break;
@@ -872,6 +949,9 @@ void RenderingServerScene::instance_geometry_set_cast_shadows_setting(RID p_inst
 	ERR_FAIL_COND(!instance);
 
 	instance->cast_shadows = p_shadow_casting_setting;
+	if (p_shadow_casting_setting == RS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+		instance->lod_threshold = 0; // drop any LOD picked while it was still drawn in views
+	}
 	_instance_queue_update(instance, false, true);
 }
 
@@ -889,6 +969,14 @@ void RenderingServerScene::instance_geometry_set_draw_range(RID p_instance, floa
 void RenderingServerScene::instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) {
 }
 
+void RenderingServerScene::instance_geometry_set_lod_bias(RID p_instance, float p_bias) {
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+	ERR_FAIL_COND(p_bias <= 0.0);
+
+	instance->lod_bias = p_bias;
+}
+
 void RenderingServerScene::instance_geometry_set_lightmap(RID p_instance, RID p_lightmap, const Rect2 &p_lightmap_uv_scale, int p_slice_index) {
 	Instance *instance = instance_owner.getornull(p_instance);
 	ERR_FAIL_COND(!instance);
@@ -1041,17 +1129,21 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 
 	p_instance->mirror = p_instance->transform.basis.determinant() < 0.0;
 
+	Vector3 scale = p_instance->transform.basis.get_scale_abs();
+	p_instance->lod_scale = MAX(scale.x, MAX(scale.y, scale.z));
+
 	AABB new_aabb;
 
 	new_aabb = p_instance->transform.xform(p_instance->aabb);
 
 	p_instance->transformed_aabb = new_aabb;
 
-	if (!p_instance->scenario) {
+	if (!p_instance->scenario || p_instance->base_type == RS::INSTANCE_OCCLUDER) {
+		// occluders are not culled through the bvh, they are iterated directly when rendering
 		return;
 	}
 
-	if (p_instance->octree_id == 0) {
+	if (p_instance->bvh_id == 0) {
 		uint32_t base_type = 1 << p_instance->base_type;
 		uint32_t pairable_mask = 0;
 		bool pairable = false;
@@ -1067,8 +1159,8 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 			pairable = true;
 		}
 
-		// not inside octree
-		p_instance->octree_id = p_instance->scenario->octree.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
+		// not inside bvh
+		p_instance->bvh_id = p_instance->scenario->bvh.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
 
 	} else {
 		/*
@@ -1076,7 +1168,7 @@ void RenderingServerScene::_update_instance(Instance *p_instance) {
 			return;
 		*/
 
-		p_instance->scenario->octree.move(p_instance->octree_id, new_aabb);
+		p_instance->scenario->bvh.move(p_instance->bvh_id, new_aabb);
 	}
 }
 
@@ -1141,6 +1233,10 @@ void RenderingServerScene::_update_instance_aabb(Instance *p_instance) {
 		case RenderingServer::INSTANCE_LIGHTMAP: {
 			new_aabb = RSG::storage->lightmap_get_aabb(p_instance->base);
 
+		} break;
+		case RenderingServer::INSTANCE_OCCLUDER: {
+			new_aabb = occluder_owner.getornull(p_instance->base)->aabb;
+
 		} break;
 		default: {
 		}
@@ -1232,7 +1328,7 @@ void RenderingServerScene::_update_instance_lightmap_captures(Instance *p_instan
 	}
 }
 
-bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario) {
+bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform light_transform = p_instance->transform;
@@ -1255,43 +1351,10 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 			real_t pancake_size = RSG::storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_SHADOW_PANCAKE_SIZE);
 
 			if (depth_range_mode == RS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
-				//optimize min/max
-				Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
-				int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
-				Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
-				//check distance max and min
-
-				bool found_items = false;
-				real_t z_max = -1e20;
-				real_t z_min = 1e20;
-
-				for (int i = 0; i < cull_count; i++) {
-					Instance *instance = instance_shadow_cull_result[i];
-					if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						continue;
-					}
-
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-
-					real_t max, min;
-					instance->transformed_aabb.project_range_in_plane(base, min, max);
-
-					if (max > z_max) {
-						z_max = max;
-					}
-
-					if (min < z_min) {
-						z_min = min;
-					}
-
-					found_items = true;
-				}
-
-				if (found_items) {
-					min_distance = MAX(min_distance, z_min);
-					max_distance = MIN(max_distance, z_max);
+				//optimize min/max, range was computed from the view cull in _prepare_scene
+				if (view_shadow_casters_found) {
+					min_distance = MAX(min_distance, view_shadow_casters_z_min);
+					max_distance = MIN(max_distance, view_shadow_casters_z_max);
 				}
 			}
 
@@ -1466,7 +1529,7 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 					}
 				}
 
-				//now that we now all ranges, we can proceed to make the light frustum planes, for culling octree
+				//now that we now all ranges, we can proceed to make the light frustum planes, for culling bvh
 
 				Vector<Plane> light_frustum_planes;
 				light_frustum_planes.resize(6);
@@ -1481,7 +1544,11 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 				light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
 				light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
 
-				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
+				Instance **cull_result;
+				int cull_count = _light_shadow_cull(light_frustum_planes, cull_result);
+				if (shadow_cull_queueing) {
+					continue;
+				}
 
 				// a pre pass will need to be needed to determine the actual z-near to be used
 
@@ -1490,10 +1557,10 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 				real_t cull_max = 0;
 				for (int j = 0; j < cull_count; j++) {
 					real_t min, max;
-					Instance *instance = instance_shadow_cull_result[j];
+					Instance *instance = cull_result[j];
 					if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 						cull_count--;
-						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+						SWAP(cull_result[j], cull_result[cull_count]);
 						j--;
 						continue;
 					}
@@ -1604,7 +1671,7 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 					RSG::scene_render->light_instance_set_shadow_transform(light->instance, ortho_camera, ortho_transform, z_max - z_min_cam, distances[i + 1], i, radius * 2.0 / texture_size, bias_scale * aspect_bias_scale * min_distance_bias_scale, z_max, uv_scale);
 				}
 
-				RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+				RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 			}
 
 		} break;
@@ -1628,14 +1695,18 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
+					Instance **cull_result;
+					int cull_count = _light_shadow_cull(planes, cull_result);
+					if (shadow_cull_queueing) {
+						continue;
+					}
 					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
 
 					for (int j = 0; j < cull_count; j++) {
-						Instance *instance = instance_shadow_cull_result[j];
+						Instance *instance = cull_result[j];
 						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+							SWAP(cull_result[j], cull_result[cull_count]);
 							j--;
 						} else {
 							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
@@ -1648,7 +1719,7 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 					}
 
 					RSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i, 0);
-					RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+					RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 				}
 			} else { //shadow cube
 
@@ -1681,14 +1752,18 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
+					Instance **cull_result;
+					int cull_count = _light_shadow_cull(planes, cull_result);
+					if (shadow_cull_queueing) {
+						continue;
+					}
 
 					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
 					for (int j = 0; j < cull_count; j++) {
-						Instance *instance = instance_shadow_cull_result[j];
+						Instance *instance = cull_result[j];
 						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+							SWAP(cull_result[j], cull_result[cull_count]);
 							j--;
 						} else {
 							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
@@ -1700,11 +1775,13 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 					}
 
 					RSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-					RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+					RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 				}
 
 				//restore the regular DP matrix
-				RSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0, 0);
+				if (!shadow_cull_queueing) {
+					RSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0, 0);
+				}
 			}
 
 		} break;
@@ -1718,14 +1795,18 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, RS::INSTANCE_GEOMETRY_MASK);
+			Instance **cull_result;
+			int cull_count = _light_shadow_cull(planes, cull_result);
+			if (shadow_cull_queueing) {
+				break;
+			}
 
 			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
 			for (int j = 0; j < cull_count; j++) {
-				Instance *instance = instance_shadow_cull_result[j];
+				Instance *instance = cull_result[j];
 				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
 					cull_count--;
-					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
+					SWAP(cull_result[j], cull_result[cull_count]);
 					j--;
 				} else {
 					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
@@ -1737,7 +1818,7 @@ bool RenderingServerScene::_light_instance_update_shadow(Instance *p_instance, c
 			}
 
 			RSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+			RSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)cull_result, cull_count);
 
 		} break;
 	}
@@ -1788,7 +1869,7 @@ void RenderingServerScene::render_camera(RID p_render_buffers, RID p_camera, RID
 		} break;
 	}
 
-	_prepare_scene(camera->transform, camera_matrix, ortho, camera->vaspect, camera->env, camera->effects, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+	_prepare_scene(camera->transform, camera_matrix, ortho, camera->vaspect, camera->env, camera->effects, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), mesh_lod_threshold / p_viewport_size.height);
 	_render_scene(p_render_buffers, camera->transform, camera_matrix, ortho, camera->env, camera->effects, p_scenario, p_shadow_atlas, RID(), -1);
 #endif
 }
@@ -1865,17 +1946,17 @@ void RenderingServerScene::render_camera(RID p_render_buffers, Ref<XRInterface>
 		mono_transform *= apply_z_shift;
 
 		// now prepare our scene with our adjusted transform projection matrix
-		_prepare_scene(mono_transform, combined_matrix, false, false, camera->env, camera->effects, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(mono_transform, combined_matrix, false, false, camera->env, camera->effects, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), mesh_lod_threshold / p_viewport_size.height);
 	} else if (p_eye == XRInterface::EYE_MONO) {
 		// For mono render, prepare as per usual
-		_prepare_scene(cam_transform, camera_matrix, false, false, camera->env, camera->effects, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(cam_transform, camera_matrix, false, false, camera->env, camera->effects, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), mesh_lod_threshold / p_viewport_size.height);
 	}
 
 	// And render our scene...
 	_render_scene(p_render_buffers, cam_transform, camera_matrix, false, camera->env, camera->effects, p_scenario, p_shadow_atlas, RID(), -1);
 };
 
-void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_force_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, bool p_using_shadows) {
+void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_force_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_lod_threshold, bool p_using_shadows) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
 	// - p_cam_projection is a wider frustrum that encompasses both eyes
@@ -1897,7 +1978,7 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 	float z_far = p_cam_projection.get_z_far();
 
 	/* STEP 2 - CULL */
-	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	instance_cull_count = scenario->bvh.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
 	light_cull_count = 0;
 
 	reflection_probe_cull_count = 0;
@@ -1909,23 +1990,107 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 
 	/*
 	print_line("OT: "+rtos( (OS::get_singleton()->get_ticks_usec()-t)/1000.0));
-	print_line("OTO: "+itos(p_scenario->octree.get_octant_count()));
-	print_line("OTE: "+itos(p_scenario->octree.get_elem_count()));
-	print_line("OTP: "+itos(p_scenario->octree.get_pair_count()));
+	print_line("OTE: "+itos(p_scenario->bvh.get_elem_count()));
+	print_line("OTP: "+itos(p_scenario->bvh.get_pair_count()));
 	*/
 
-	/* STEP 3 - PROCESS PORTALS, VALIDATE ROOMS */
-	//removed, will replace with culling
+	/* STEP 3 - RASTERIZE OCCLUDERS */
+
+	bool use_occlusion = false;
+
+	if (!scenario->occluders.empty()) {
+		RENDER_TIMESTAMP("Occlusion Buffer");
+
+		occlusion_buffer.begin(p_cam_projection, p_cam_transform);
+
+		for (List<Instance *>::Element *E = scenario->occluders.front(); E; E = E->next()) {
+			Instance *ins = E->get();
+			if (!ins->visible || (camera_layer_mask & ins->layer_mask) == 0) {
+				continue;
+			}
+
+			Occluder *occluder = occluder_owner.getornull(ins->base);
+			if (occluder->indices.empty()) {
+				continue;
+			}
+
+			bool in_frustum = true;
+			for (int j = 0; j < planes.size(); j++) {
+				if (planes[j].is_point_over(ins->transformed_aabb.get_support(planes[j].normal))) {
+					in_frustum = false;
+					break;
+				}
+			}
+			if (!in_frustum) {
+				continue;
+			}
+
+			occlusion_buffer.rasterize(ins->transform, occluder->vertices.ptr(), occluder->vertices.size(), occluder->indices.ptr(), occluder->indices.size(), occluder->edge_neighbors.ptr());
+			use_occlusion = true;
+		}
+
+		if (use_occlusion) {
+			occlusion_buffer.finish();
+		}
+	}
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 	uint64_t frame_number = RSG::rasterizer->get_frame_number();
 	float lightmap_probe_update_speed = RSG::storage->lightmap_get_probe_capture_update_speed() * RSG::rasterizer->get_frame_delta_time();
 
+	// directional lights with optimized depth range fit their splits to the shadow casters in view,
+	// find their range here rather than culling the view again for each light
+	bool compute_shadow_caster_range = false;
+	if (p_using_shadows && p_shadow_atlas.is_valid()) {
+		for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
+			if (E->get()->visible && RSG::storage->light_has_shadow(E->get()->base) && RSG::storage->light_directional_get_shadow_depth_range_mode(E->get()->base) == RS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
+				compute_shadow_caster_range = true;
+				break;
+			}
+		}
+	}
+
+	// view height at distance one (perspective) or the whole view height (orthogonal), for mesh LOD selection
+	real_t lod_view_height = 2.0 / p_cam_projection.matrix[1][1];
+
+	Plane shadow_caster_base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
+	view_shadow_casters_found = false;
+	view_shadow_casters_z_min = 1e20;
+	view_shadow_casters_z_max = -1e20;
+
 	for (int i = 0; i < instance_cull_count; i++) {
 		Instance *ins = instance_cull_result[i];
 
 		bool keep = false;
 
+		if (compute_shadow_caster_range && ins->visible && ((1 << ins->base_type) & RS::INSTANCE_GEOMETRY_MASK) && static_cast<InstanceGeometryData *>(ins->base_data)->can_cast_shadows) {
+			real_t max, min;
+			ins->transformed_aabb.project_range_in_plane(shadow_caster_base, min, max);
+
+			view_shadow_casters_z_max = MAX(view_shadow_casters_z_max, max);
+			view_shadow_casters_z_min = MIN(view_shadow_casters_z_min, min);
+			view_shadow_casters_found = true;
+		}
+
+		if ((1 << ins->base_type) & ((1 << RS::INSTANCE_MESH) | (1 << RS::INSTANCE_MULTIMESH))) {
+			if (ins->cast_shadows == RS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+				// never drawn in views, so the distance to the camera says nothing about the detail its shadow needs
+				ins->lod_threshold = 0;
+			} else {
+				// pick the mesh error that projects below the pixel threshold, measured at the closest point of the instance
+				real_t view_height = lod_view_height;
+				if (!p_cam_orthogonal) {
+					const AABB &aabb = ins->transformed_aabb;
+					Vector3 closest = p_cam_transform.origin;
+					closest.x = CLAMP(closest.x, aabb.position.x, aabb.position.x + aabb.size.x);
+					closest.y = CLAMP(closest.y, aabb.position.y, aabb.position.y + aabb.size.y);
+					closest.z = CLAMP(closest.z, aabb.position.z, aabb.position.z + aabb.size.z);
+					view_height *= p_cam_transform.origin.distance_to(closest);
+				}
+				ins->lod_threshold = view_height * p_screen_lod_threshold / (ins->lod_scale * ins->lod_bias);
+			}
+		}
+
 		if ((camera_layer_mask & ins->layer_mask) == 0) {
 			//failure
 		} else if (ins->base_type == RS::INSTANCE_LIGHT && ins->visible) {
@@ -1996,7 +2161,7 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 				lightmap_cull_count++;
 			}
 
-		} else if (((1 << ins->base_type) & RS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != RS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+		} else if (((1 << ins->base_type) & RS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != RS::SHADOW_CASTING_SETTING_SHADOWS_ONLY && !(use_occlusion && occlusion_buffer.is_occluded(ins->transformed_aabb))) {
 			keep = true;
 
 			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
@@ -2088,43 +2253,36 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 	RID *directional_light_ptr = &light_instance_cull_result[light_cull_count];
 	directional_light_count = 0;
 
-	// directional lights
-	{
-		Instance **lights_with_shadow = (Instance **)alloca(sizeof(Instance *) * scenario->directional_lights.size());
-		int directional_shadow_count = 0;
+	Instance **lights_with_shadow = (Instance **)alloca(sizeof(Instance *) * scenario->directional_lights.size());
+	int directional_shadow_count = 0;
 
-		for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
-			if (light_cull_count + directional_light_count >= MAX_LIGHTS_CULLED) {
-				break;
-			}
+	// directional lights
+	for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
+		if (light_cull_count + directional_light_count >= MAX_LIGHTS_CULLED) {
+			break;
+		}
 
-			if (!E->get()->visible) {
-				continue;
-			}
+		if (!E->get()->visible) {
+			continue;
+		}
 
-			InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+		InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
 
-			//check shadow..
+		//check shadow..
 
-			if (light) {
-				if (p_using_shadows && p_shadow_atlas.is_valid() && RSG::storage->light_has_shadow(E->get()->base)) {
-					lights_with_shadow[directional_shadow_count++] = E->get();
-				}
-				//add to list
-				directional_light_ptr[directional_light_count++] = light->instance;
+		if (light) {
+			if (p_using_shadows && p_shadow_atlas.is_valid() && RSG::storage->light_has_shadow(E->get()->base)) {
+				lights_with_shadow[directional_shadow_count++] = E->get();
 			}
+			//add to list
+			directional_light_ptr[directional_light_count++] = light->instance;
 		}
+	}
 
-		RSG::scene_render->set_directional_shadow_count(directional_shadow_count);
-
-		for (int i = 0; i < directional_shadow_count; i++) {
-			RENDER_TIMESTAMP(">Rendering Directional Light " + itos(i));
+	RSG::scene_render->set_directional_shadow_count(directional_shadow_count);
 
-			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_cam_vaspect, p_shadow_atlas, scenario);
-
-			RENDER_TIMESTAMP("<Rendering Directional Light " + itos(i));
-		}
-	}
+	Instance **lights_to_redraw = (Instance **)alloca(sizeof(Instance *) * MAX(light_cull_count, 1));
+	int redraw_count = 0;
 
 	if (p_using_shadows) { //setup shadow maps
 
@@ -2218,12 +2376,99 @@ void RenderingServerScene::_prepare_scene(const Transform p_cam_transform, const
 
 			if (redraw) {
 				//must redraw!
-				RENDER_TIMESTAMP(">Rendering Light " + itos(i));
-				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_cam_vaspect, p_shadow_atlas, scenario);
-				RENDER_TIMESTAMP("<Rendering Light " + itos(i));
+				lights_to_redraw[redraw_count++] = ins;
 			}
 		}
 	}
+
+	if (directional_shadow_count + redraw_count == 0) {
+		return;
+	}
+
+	/* STEP 6 - CULL SHADOWS */
+
+	// first pass only queues the culls of every split and face, so they can all run at once
+
+	RENDER_TIMESTAMP("Shadow Culling");
+
+	shadow_cull_queueing = true;
+	shadow_cull_job_count = 0;
+
+	for (int i = 0; i < directional_shadow_count; i++) {
+		_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_cam_vaspect, p_shadow_atlas);
+	}
+
+	for (int i = 0; i < redraw_count; i++) {
+		_light_instance_update_shadow(lights_to_redraw[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_cam_vaspect, p_shadow_atlas);
+	}
+
+	shadow_cull_queueing = false;
+
+	// Share the rasterizer's pool instead of keeping a second set of threads per core.
+	ThreadWorkPool *thread_work_pool = RSG::rasterizer->get_thread_work_pool();
+	if (shadow_cull_job_count > 1 && thread_work_pool) {
+		thread_work_pool->do_work(shadow_cull_job_count, this, &RenderingServerScene::_shadow_cull_job, scenario);
+	} else {
+		for (uint32_t i = 0; i < shadow_cull_job_count; i++) {
+			_shadow_cull_job(i, scenario);
+		}
+	}
+
+	/* STEP 7 - RENDER SHADOWS */
+
+	// second pass does the same calls in the same order, picking up the results
+
+	shadow_cull_job_index = 0;
+
+	for (int i = 0; i < directional_shadow_count; i++) {
+		RENDER_TIMESTAMP(">Rendering Directional Light " + itos(i));
+
+		_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_cam_vaspect, p_shadow_atlas);
+
+		RENDER_TIMESTAMP("<Rendering Directional Light " + itos(i));
+	}
+
+	for (int i = 0; i < redraw_count; i++) {
+		InstanceLightData *light = static_cast<InstanceLightData *>(lights_to_redraw[i]->base_data);
+
+		RENDER_TIMESTAMP(">Rendering Light " + itos(i));
+		light->shadow_dirty = _light_instance_update_shadow(lights_to_redraw[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_cam_vaspect, p_shadow_atlas);
+		RENDER_TIMESTAMP("<Rendering Light " + itos(i));
+	}
+}
+
+void RenderingServerScene::_shadow_cull_job(uint32_t p_index, Scenario *p_scenario) {
+	ShadowCullJob &job = shadow_cull_jobs[p_index];
+
+	if (job.result.size() == 0) {
+		job.result.resize(1024);
+	}
+
+	while (true) {
+		job.result_count = p_scenario->bvh.cull_convex(job.planes, job.result.ptr(), job.result.size(), RS::INSTANCE_GEOMETRY_MASK);
+		if (job.result_count < int(job.result.size()) || job.result.size() >= MAX_INSTANCE_CULL) {
+			break;
+		}
+		// ran out of room, grow and cull again
+		job.result.resize(MIN(job.result.size() * 2, uint32_t(MAX_INSTANCE_CULL)));
+	}
+}
+
+int RenderingServerScene::_light_shadow_cull(const Vector<Plane> &p_planes, Instance **&r_result) {
+	if (shadow_cull_queueing) {
+		if (shadow_cull_job_count == shadow_cull_jobs.size()) {
+			shadow_cull_jobs.resize(shadow_cull_job_count + 1);
+		}
+		shadow_cull_jobs[shadow_cull_job_count++].planes = p_planes;
+		r_result = nullptr;
+		return 0;
+	}
+
+	r_result = nullptr;
+	ERR_FAIL_COND_V(shadow_cull_job_index >= shadow_cull_job_count, 0);
+	ShadowCullJob &job = shadow_cull_jobs[shadow_cull_job_index++];
+	r_result = job.result.ptr();
+	return job.result_count;
 }
 
 void RenderingServerScene::_render_scene(RID p_render_buffers, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_force_camera_effects, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
@@ -2325,7 +2570,7 @@ bool RenderingServerScene::_render_reflection_probe_step(Instance *p_instance, i
 		}
 
 		RENDER_TIMESTAMP("Render Reflection Probe, Step " + itos(p_step));
-		_prepare_scene(xform, cm, false, false, RID(), RID(), RSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, use_shadows);
+		_prepare_scene(xform, cm, false, false, RID(), RID(), RSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, mesh_lod_threshold / reflection_probe_lod_size, use_shadows);
 		_render_scene(RID(), xform, cm, false, RID(), RID(), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, p_step);
 
 	} else {
@@ -2607,7 +2852,7 @@ void RenderingServerScene::_update_dirty_instance(Instance *p_instance) {
 	if (p_instance->update_dependencies) {
 		p_instance->instance_increase_version();
 
-		if (p_instance->base.is_valid()) {
+		if (p_instance->base.is_valid() && p_instance->base_type != RS::INSTANCE_OCCLUDER) {
 			RSG::storage->base_update_dependency(p_instance->base, p_instance);
 		}
 
@@ -2828,6 +3073,16 @@ bool RenderingServerScene::free(RID p_rid) {
 		camera_owner.free(p_rid);
 		memdelete(camera);
 
+	} else if (occluder_owner.owns(p_rid)) {
+		Occluder *occluder = occluder_owner.getornull(p_rid);
+
+		while (occluder->users.front()) {
+			instance_set_base(occluder->users.front()->get()->self, RID());
+		}
+
+		occluder_owner.free(p_rid);
+		memdelete(occluder);
+
 	} else if (scenario_owner.owns(p_rid)) {
 		Scenario *scenario = scenario_owner.getornull(p_rid);
 
@@ -2876,6 +3131,9 @@ RenderingServerScene *RenderingServerScene::singleton = nullptr;
 RenderingServerScene::RenderingServerScene() {
 	render_pass = 1;
 	singleton = this;
+
+	mesh_lod_threshold = GLOBAL_GET("rendering/quality/mesh_lod/threshold_pixels");
+	reflection_probe_lod_size = MAX(1, int(GLOBAL_GET("rendering/quality/reflection_atlas/reflection_size")));
 }
 
 RenderingServerScene::~RenderingServerScene() {
@@ -33,12 +33,14 @@
 
 #include "servers/rendering/rasterizer.h"
 
+#include "core/local_vector.h"
 #include "core/math/geometry.h"
-#include "core/math/octree.h"
+#include "core/math/dynamic_bvh.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/rid_owner.h"
 #include "core/self_list.h"
+#include "servers/rendering/occlusion_buffer.h"
 #include "servers/xr/xr_interface.h"
 
 class RenderingServerScene {
@@ -103,17 +105,35 @@ public:
 	virtual void camera_set_camera_effects(RID p_camera, RID p_fx);
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable);
 
-	/* SCENARIO API */
+	/* OCCLUDER API */
 
 	struct Instance;
 
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		LocalVector<int> edge_neighbors;
+		AABB aabb;
+		Set<Instance *> users;
+	};
+
+	mutable RID_PtrOwner<Occluder> occluder_owner;
+
+	virtual RID occluder_create();
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices);
+
+	OcclusionBuffer occlusion_buffer;
+
+	/* SCENARIO API */
+
 	struct Scenario {
 		RS::ScenarioDebugMode debug;
 		RID self;
 
-		Octree<Instance, true> octree;
+		DynamicBVH<Instance> bvh;
 
 		List<Instance *> directional_lights;
+		List<Instance *> occluders;
 		RID environment;
 		RID fallback_environment;
 		RID camera_effects;
@@ -127,8 +147,8 @@ public:
 
 	mutable RID_PtrOwner<Scenario> scenario_owner;
 
-	static void *_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int);
-	static void _instance_unpair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int, void *);
+	static void *_instance_pair(void *p_self, DynamicBVHElementID, Instance *p_A, int, DynamicBVHElementID, Instance *p_B, int);
+	static void _instance_unpair(void *p_self, DynamicBVHElementID, Instance *p_A, int, DynamicBVHElementID, Instance *p_B, int, void *);
 
 	virtual RID scenario_create();
 
@@ -147,7 +167,7 @@ public:
 	struct Instance : RasterizerScene::InstanceBase {
 		RID self;
 		//scenario stuff
-		OctreeElementID octree_id;
+		DynamicBVHElementID bvh_id;
 		Scenario *scenario;
 		SelfList<Instance> scenario_item;
 
@@ -167,6 +187,9 @@ public:
 		float lod_end_hysteresis;
 		RID lod_instance;
 
+		float lod_bias; // higher keeps detail further away
+		float lod_scale; // largest axis scale of the transform, LOD errors are in mesh space
+
 		Vector<Color> lightmap_target_sh; //target is used for incrementally changing the SH over time, this avoids pops in some corner cases and when going interior <-> exterior
 
 		uint64_t last_render_pass;
@@ -193,7 +216,7 @@ public:
 		Instance() :
 				scenario_item(this),
 				update_item(this) {
-			octree_id = 0;
+			bvh_id = 0;
 			scenario = nullptr;
 
 			update_aabb = false;
@@ -208,6 +231,9 @@ public:
 			lod_begin_hysteresis = 0;
 			lod_end_hysteresis = 0;
 
+			lod_bias = 1.0;
+			lod_scale = 1.0;
+
 			last_render_pass = 0;
 			last_frame_pass = 0;
 			version = 1;
@@ -292,6 +318,14 @@ public:
 		}
 	};
 
+	struct InstanceOccluderData : public InstanceBaseData {
+		List<Instance *>::Element *O; //iterator in scenario occluders
+
+		InstanceOccluderData() {
+			O = nullptr;
+		}
+	};
+
 	SelfList<InstanceReflectionProbeData>::List reflection_probe_render_list;
 
 	struct InstanceLightData : public InstanceBaseData {
@@ -378,7 +412,6 @@ public:
 
 	int instance_cull_count;
 	Instance *instance_cull_result[MAX_INSTANCE_CULL];
-	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
 	Instance *light_cull_result[MAX_LIGHTS_CULLED];
 	RID light_instance_cull_result[MAX_LIGHTS_CULLED];
 	int light_cull_count;
@@ -392,6 +425,30 @@ public:
 	Instance *lightmap_cull_result[MAX_LIGHTS_CULLED];
 	int lightmap_cull_count;
 
+	// Shadow culls are queued in a first pass over the lights, run in parallel
+	// and then consumed in the same order by a second pass that renders them.
+	struct ShadowCullJob {
+		Vector<Plane> planes;
+		LocalVector<Instance *> result; // grows as needed, kept between frames
+		int result_count = 0;
+	};
+
+	LocalVector<ShadowCullJob> shadow_cull_jobs;
+	uint32_t shadow_cull_job_count = 0;
+	uint32_t shadow_cull_job_index = 0;
+	bool shadow_cull_queueing = false;
+
+	// Depth range of the shadow casters in view, for directional lights using optimized depth range.
+	bool view_shadow_casters_found = false;
+	real_t view_shadow_casters_z_min = 0;
+	real_t view_shadow_casters_z_max = 0;
+
+	float mesh_lod_threshold; // in pixels
+	int reflection_probe_lod_size;
+
+	void _shadow_cull_job(uint32_t p_index, Scenario *p_scenario);
+	_FORCE_INLINE_ int _light_shadow_cull(const Vector<Plane> &p_planes, Instance **&r_result);
+
 	RID_PtrOwner<Instance> instance_owner;
 
 	virtual RID instance_create();
@@ -423,6 +480,7 @@ public:
 
 	virtual void instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin);
 	virtual void instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance);
+	virtual void instance_geometry_set_lod_bias(RID p_instance, float p_bias);
 	virtual void instance_geometry_set_lightmap(RID p_instance, RID p_lightmap, const Rect2 &p_lightmap_uv_scale, int p_slice_index);
 
 	void _update_instance_shader_parameters_from_material(Map<StringName, RasterizerScene::InstanceBase::InstanceShaderParameter> &isparams, const Map<StringName, RasterizerScene::InstanceBase::InstanceShaderParameter> &existing_isparams, RID p_material);
@@ -437,10 +495,10 @@ public:
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario);
+	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas);
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
-	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_force_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, bool p_using_shadows = true);
+	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_force_environment, RID p_force_camera_effects, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_lod_threshold, bool p_using_shadows = true);
 	void _render_scene(RID p_render_buffers, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_force_camera_effects, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass);
 	void render_empty_scene(RID p_render_buffers, RID p_scenario, RID p_shadow_atlas);
 